@@ -0,0 +1,27 @@
+#include "allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+// Replaces the global operator new and delete. They live in their own file so that they never get inlined into the code that's being counted.
+static std::atomic_uint64_t s_allocationCount = 0;
+
+uint64_t GetAllocationCount() {
+    return s_allocationCount.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size) {
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
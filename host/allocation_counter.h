@@ -0,0 +1,4 @@
+#pragma once
+
+// Number of times the global operator new was called so far, so benchmarks of paths that are supposed to be allocation-free can report it
+uint64_t GetAllocationCount();
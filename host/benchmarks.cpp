@@ -0,0 +1,194 @@
+#include <benchmark/benchmark.h>
+
+#include "allocation_counter.h"
+#include "cemu_mock.h"
+#include "hooking/pending_copy_table.h"
+#include "utils/handle_registry.h"
+#include "utils/log_queue.h"
+#include "utils/seqlock.h"
+#include "utils/string_hash.h"
+
+// Benchmarks of the code that runs inside the HLE hooks or on every Vulkan call, where regressions cost frame time.
+
+static void BM_HashString(benchmark::State& state) {
+    const std::string str(state.range(0), 'a');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HashString(str));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashString)->Arg(8)->Arg(32)->Arg(128);
+
+static void BM_GuestStringView(benchmark::State& state) {
+    CemuMock cemu;
+    const uint32_t address = cemu.AllocateString("Camera_Fixed_Actor_Rotation");
+    const char* str = reinterpret_cast<const char*>(cemu.GetPointer(address));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GuestStringView(str));
+    }
+}
+BENCHMARK(BM_GuestStringView);
+
+static void BM_SwapEndianness32(benchmark::State& state) {
+    std::vector<uint32_t> src(state.range(0), 0x11223344);
+    std::vector<uint32_t> dst(src.size());
+    for (auto _ : state) {
+        swapEndianness32(src.data(), dst.data(), src.size());
+        benchmark::DoNotOptimize(dst.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(uint32_t));
+}
+BENCHMARK(BM_SwapEndianness32)->Arg(12)->Arg(16)->Arg(1024);
+
+static void BM_ReadBEMatrix(benchmark::State& state) {
+    CemuMock cemu;
+    const uint32_t address = cemu.Allocate(12 * sizeof(float));
+    std::array<float, 12> mtx;
+    for (auto _ : state) {
+        swapEndianness32(cemu.GetPointer(address), mtx.data(), mtx.size());
+        benchmark::DoNotOptimize(mtx.data());
+    }
+}
+BENCHMARK(BM_ReadBEMatrix);
+
+struct BenchSnapshot {
+    std::array<float, 16> matrix;
+    uint64_t frame;
+};
+
+static void BM_SeqLockLoad(benchmark::State& state) {
+    static SeqLock<BenchSnapshot> s_snapshot;
+    if (state.thread_index() == 0) {
+        s_snapshot.Store({ {}, 1 });
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(s_snapshot.Load());
+    }
+}
+BENCHMARK(BM_SeqLockLoad)->Threads(1)->Threads(4);
+
+static void BM_SeqLockStore(benchmark::State& state) {
+    SeqLock<BenchSnapshot> snapshot;
+    BenchSnapshot value = {};
+    for (auto _ : state) {
+        value.frame++;
+        snapshot.Store(value);
+    }
+    benchmark::DoNotOptimize(snapshot.Load());
+}
+BENCHMARK(BM_SeqLockStore);
+
+struct BenchImageMetadata {
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;
+};
+
+static void BM_HandleRegistryFind(benchmark::State& state) {
+    static HandleRegistry<BenchImageMetadata, 1024> s_registry;
+    const uint64_t handleCount = state.range(0);
+    if (state.thread_index() == 0) {
+        for (uint64_t handle = 1; handle <= handleCount; handle++) {
+            s_registry.Insert(handle * 0x1000, BenchImageMetadata{ 1920, 1080, (uint32_t)handle });
+        }
+    }
+    uint64_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(s_registry.Find((i++ % handleCount + 1) * 0x1000));
+    }
+    if (state.thread_index() == 0) {
+        for (uint64_t handle = 1; handle <= handleCount; handle++) {
+            s_registry.Remove(handle * 0x1000);
+        }
+    }
+}
+BENCHMARK(BM_HandleRegistryFind)->Arg(64)->Arg(512)->Threads(1)->Threads(4);
+
+// looks up handles that aren't tracked after many more were created and destroyed than the registry has slots
+static void BM_HandleRegistryMissAfterChurn(benchmark::State& state) {
+    HandleRegistry<BenchImageMetadata, 1024> registry;
+    const uint64_t liveCount = state.range(0);
+    for (uint64_t handle = 1; handle <= 64 * 1024; handle++) {
+        if (handle > liveCount) {
+            registry.Remove((handle - liveCount) * 0x1000);
+        }
+        registry.Insert(handle * 0x1000, BenchImageMetadata{ 1920, 1080, (uint32_t)handle });
+    }
+    uint64_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(registry.Find((i++ % 1024 + 1) * 0x1000 + 0x10));
+    }
+}
+BENCHMARK(BM_HandleRegistryMissAfterChurn)->Arg(300)->Arg(600);
+
+// Several threads logging at once while a writer thread drains the queue. With waitForSpace (Arg 1) every message gets written,
+// so the time includes the share of the writer's work. Without it the messages that don't fit get dropped and counted.
+static void BM_LogEnqueue(benchmark::State& state) {
+    static LogQueue<1024> s_queue;
+    static std::jthread s_writer([](std::stop_token stopToken) {
+        std::string batch;
+        while (!stopToken.stop_requested()) {
+            batch.clear();
+            s_queue.Drain(batch);
+            if (batch.empty()) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    const bool waitForSpace = state.range(0) != 0;
+    const std::string message = "Hooked texture at 0x" + std::to_string(0x10000000 + state.thread_index()) + " with format 37 and size 1920x1080";
+    uint64_t dropped = 0;
+    for (auto _ : state) {
+        dropped += !s_queue.Enqueue(message, waitForSpace);
+    }
+    state.counters["dropped"] = benchmark::Counter((double)dropped, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_LogEnqueue)->Arg(0)->Arg(1)->Threads(1)->Threads(4);
+
+// stand-ins for VkCommandBuffer, VkSubmitInfo and the next layer's dispatch table
+struct BenchCommandBuffer_T;
+using BenchCommandBuffer = BenchCommandBuffer_T*;
+
+struct BenchSubmitInfo {
+    uint32_t commandBufferCount;
+    const BenchCommandBuffer* pCommandBuffers;
+};
+
+struct BenchDispatch {
+    int32_t (*QueueSubmit)(uint32_t submitCount, const BenchSubmitInfo* pSubmits);
+};
+
+struct BenchTexture {};
+
+// Cemu's submits while a copy recorded into another command buffer is still pending, which have to reach the next layer untouched.
+// Does the same lookup as VkDeviceOverrides::QueueSubmit before calling the mock dispatch.
+static void BM_QueueSubmitPassthrough(benchmark::State& state) {
+    PendingCopyTable<BenchCommandBuffer, BenchTexture> copies;
+    BenchTexture texture;
+    copies.Add(reinterpret_cast<BenchCommandBuffer>(0x80000), &texture);
+
+    std::vector<BenchCommandBuffer> commandBuffers;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        commandBuffers.emplace_back(reinterpret_cast<BenchCommandBuffer>(0x10000 + i * 0x40));
+    }
+    const BenchSubmitInfo submitInfo = { (uint32_t)commandBuffers.size(), commandBuffers.data() };
+
+    static uint64_t s_submitCount = 0;
+    BenchDispatch dispatch = { [](uint32_t submitCount, const BenchSubmitInfo*) -> int32_t {
+        s_submitCount += submitCount;
+        return 0;
+    } };
+    benchmark::DoNotOptimize(dispatch);
+
+    const uint64_t allocationsBefore = GetAllocationCount();
+    for (auto _ : state) {
+        if (copies.ContainsAny({ submitInfo.pCommandBuffers, submitInfo.commandBufferCount })) {
+            state.SkipWithError("Submit unexpectedly contained a pending copy");
+            break;
+        }
+        benchmark::DoNotOptimize(dispatch.QueueSubmit(1, &submitInfo));
+    }
+    state.counters["allocations"] = benchmark::Counter((double)(GetAllocationCount() - allocationsBefore), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_QueueSubmitPassthrough)->Arg(1)->Arg(4)->Arg(16);
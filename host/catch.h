@@ -0,0 +1,10 @@
+#pragma once
+
+// Catch2 v3 split up the single header of v2, and distributions ship either of them
+#if __has_include(<catch2/catch_test_macros.hpp>)
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+using Catch::Approx;
+#else
+#include <catch2/catch.hpp>
+#endif
@@ -0,0 +1,87 @@
+#include "cemu_mock.h"
+
+#include <sys/mman.h>
+
+CemuMock* CemuMock::s_instance = nullptr;
+
+CemuMock::CemuMock(uint64_t titleId): m_titleId(titleId) {
+    if (s_instance != nullptr) {
+        throw std::logic_error("Only one CemuMock can exist at a time");
+    }
+
+    // only the pages that get touched are backed by actual memory
+    void* memory = mmap(nullptr, GUEST_MEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (memory == MAP_FAILED) {
+        throw std::runtime_error("Failed to reserve the guest address space");
+    }
+    m_memory = static_cast<uint8_t*>(memory);
+    s_instance = this;
+}
+
+CemuMock::~CemuMock() {
+    munmap(m_memory, GUEST_MEMORY_SIZE);
+    s_instance = nullptr;
+}
+
+CemuExports CemuMock::GetExports() const {
+    CemuExports exports;
+    exports.osLib_registerHLEFunction = &RegisterHLEFunction;
+    exports.memory_getBase = &GetMemoryBase;
+    exports.gameMeta_getTitleId = &GetTitleId;
+    return exports;
+}
+
+CemuMock::HLEFunction CemuMock::FindFunction(std::string_view functionName) const {
+    auto it = std::ranges::find(m_functions, functionName, &RegisteredFunction::functionName);
+    return it != m_functions.end() ? it->function : nullptr;
+}
+
+bool CemuMock::Call(std::string_view functionName, PPCInterpreter_t* hCPU) const {
+    HLEFunction function = FindFunction(functionName);
+    if (function == nullptr) {
+        return false;
+    }
+    function(hCPU);
+    return true;
+}
+
+uint32_t CemuMock::Allocate(uint32_t size, uint32_t alignment) {
+    const uint64_t address = (m_heapEnd + (uint64_t)alignment - 1) & ~((uint64_t)alignment - 1);
+    if (address + size > GUEST_MEMORY_SIZE) {
+        throw std::bad_alloc();
+    }
+    m_heapEnd = (uint32_t)(address + size);
+    return (uint32_t)address;
+}
+
+uint32_t CemuMock::AllocateString(std::string_view str) {
+    const uint32_t address = Allocate((uint32_t)str.size() + 1);
+    WriteBytes(address, str.data(), str.size());
+    return address;
+}
+
+void CemuMock::Reset() {
+    // drops the pages instead of writing zeroes to them, reading them again maps in fresh zero pages
+    madvise(m_memory, GUEST_MEMORY_SIZE, MADV_DONTNEED);
+    m_heapEnd = HEAP_START;
+}
+
+void CemuMock::RegisterHLEFunction(const char* libraryName, const char* functionName, HLEFunction function) {
+    std::vector<RegisteredFunction>& functions = s_instance->m_functions;
+    // registering a name again replaces the earlier function
+    auto it = std::ranges::find(functions, std::string_view(functionName), &RegisteredFunction::functionName);
+    if (it != functions.end()) {
+        it->libraryName = libraryName;
+        it->function = function;
+        return;
+    }
+    functions.push_back({ libraryName, functionName, function });
+}
+
+void* CemuMock::GetMemoryBase() {
+    return s_instance->m_memory;
+}
+
+uint64_t CemuMock::GetTitleId() {
+    return s_instance->m_titleId;
+}
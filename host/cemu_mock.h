@@ -0,0 +1,70 @@
+#pragma once
+
+// Stands in for the Cemu process when running BetterVR's code on a host that can't run the layer.
+// It reserves a 4 GiB guest address space like Cemu does, keeps track of the HLE functions that get registered through it
+// and reports Breath of the Wild's title ID, so code that only talks to Cemu through CemuExports runs unchanged.
+// Cemu's exports are plain function pointers without a context argument, so only one mock can exist at a time.
+class CemuMock {
+public:
+    using HLEFunction = void (*)(PPCInterpreter_t* hCPU);
+
+    struct RegisteredFunction {
+        std::string libraryName;
+        std::string functionName;
+        HLEFunction function;
+    };
+
+    static constexpr uint64_t GUEST_MEMORY_SIZE = 1ull << 32;
+    static constexpr uint64_t BOTW_TITLE_ID_EUR = 0x00050000101C9500;
+    // same start as the Wii U's MEM2, which is where the game's heaps live
+    static constexpr uint32_t HEAP_START = 0x10000000;
+
+    explicit CemuMock(uint64_t titleId = BOTW_TITLE_ID_EUR);
+    ~CemuMock();
+
+    CemuMock(const CemuMock&) = delete;
+    CemuMock& operator=(const CemuMock&) = delete;
+
+    CemuExports GetExports() const;
+
+    uint64_t GetMemoryBaseAddress() const { return (uint64_t)m_memory; }
+    uint8_t* GetPointer(uint32_t address) const { return m_memory + address; }
+
+    const std::vector<RegisteredFunction>& GetRegisteredFunctions() const { return m_functions; }
+    HLEFunction FindFunction(std::string_view functionName) const;
+    // returns false if nothing was registered under that name
+    bool Call(std::string_view functionName, PPCInterpreter_t* hCPU) const;
+
+    // hands out zeroed guest memory for test data, it's only released by Reset()
+    uint32_t Allocate(uint32_t size, uint32_t alignment = 0x10);
+    uint32_t AllocateString(std::string_view str);
+
+    template <typename T>
+    void Write(uint32_t address, const T& value) {
+        std::memcpy(GetPointer(address), &value, sizeof(T));
+    }
+
+    template <typename T>
+    T Read(uint32_t address) const {
+        T value;
+        std::memcpy(&value, GetPointer(address), sizeof(T));
+        return value;
+    }
+
+    void WriteBytes(uint32_t address, const void* data, size_t size) { std::memcpy(GetPointer(address), data, size); }
+
+    // zeroes all guest memory and forgets the allocations, registered functions are kept
+    void Reset();
+
+private:
+    static void RegisterHLEFunction(const char* libraryName, const char* functionName, HLEFunction function);
+    static void* GetMemoryBase();
+    static uint64_t GetTitleId();
+
+    static CemuMock* s_instance;
+
+    uint8_t* m_memory = nullptr;
+    uint64_t m_titleId;
+    uint32_t m_heapEnd = HEAP_START;
+    std::vector<RegisteredFunction> m_functions;
+};
@@ -0,0 +1,63 @@
+#include "catch.h"
+#include "cemu_mock.h"
+
+namespace {
+    uint32_t s_lastArgument = 0;
+
+    void hook_StoreArgument(PPCInterpreter_t* hCPU) {
+        s_lastArgument = hCPU->gpr[3];
+        hCPU->gpr[3] = 1;
+    }
+}
+
+TEST_CASE("CemuMock exposes a complete set of exports", "[cemu_mock]") {
+    CemuMock cemu;
+    const CemuExports exports = cemu.GetExports();
+
+    REQUIRE(exports.IsComplete());
+    CHECK(exports.gameMeta_getTitleId() == CemuMock::BOTW_TITLE_ID_EUR);
+    CHECK((uint64_t)exports.memory_getBase() == cemu.GetMemoryBaseAddress());
+}
+
+TEST_CASE("CemuMock calls functions registered through its exports", "[cemu_mock]") {
+    CemuMock cemu;
+    cemu.GetExports().osLib_registerHLEFunction("coreinit", "hook_StoreArgument", &hook_StoreArgument);
+
+    REQUIRE(cemu.GetRegisteredFunctions().size() == 1);
+    CHECK(cemu.GetRegisteredFunctions()[0].libraryName == "coreinit");
+    CHECK(cemu.FindFunction("hook_StoreArgument") == &hook_StoreArgument);
+
+    PPCInterpreter_t hCPU = {};
+    hCPU.gpr[3] = 0x1234;
+    CHECK(cemu.Call("hook_StoreArgument", &hCPU));
+    CHECK(s_lastArgument == 0x1234);
+    CHECK(hCPU.gpr[3] == 1);
+
+    CHECK_FALSE(cemu.Call("hook_Missing", &hCPU));
+}
+
+TEST_CASE("CemuMock guest memory is addressed like Cemu's", "[cemu_mock]") {
+    CemuMock cemu;
+
+    const uint32_t address = cemu.Allocate(sizeof(BEType<uint32_t>));
+    CHECK(address >= CemuMock::HEAP_START);
+    CHECK(address % 0x10 == 0);
+
+    cemu.Write(address, BEType<uint32_t>(0x11223344));
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(cemu.GetMemoryBaseAddress() + address);
+    CHECK(bytes[0] == 0x11);
+    CHECK(bytes[3] == 0x44);
+    CHECK(cemu.Read<BEType<uint32_t>>(address).getLE() == 0x11223344);
+
+    const uint32_t str = cemu.AllocateString("GameROMPlayer");
+    CHECK(str > address);
+    CHECK(std::string_view(reinterpret_cast<const char*>(cemu.GetPointer(str))) == "GameROMPlayer");
+
+    // the top of the address space is reserved too
+    cemu.Write<uint32_t>(0xFFFFFFFC, 0xCAFE);
+    CHECK(cemu.Read<uint32_t>(0xFFFFFFFC) == 0xCAFE);
+
+    cemu.Reset();
+    CHECK(cemu.Read<uint32_t>(address) == 0);
+    CHECK(cemu.Allocate(4) == address);
+}
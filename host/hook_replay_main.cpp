@@ -0,0 +1,116 @@
+#include "cemu_mock.h"
+#include "hooking/hook_replay.h"
+#include "hooking/job_routes.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+
+// Replays a BetterVR_hooks.capture against CemuMock's guest memory, and reports per hook whether it still produces
+// the captured results and how long it takes.
+//
+// Only hooks that build on the host can be replayed. The others depend on the renderer or OpenXR through VRManager,
+// their calls are counted as skipped.
+
+static uint64_t s_memoryBase = 0;
+
+static void hook_RouteActorJob(PPCInterpreter_t* hCPU) {
+    RouteActorJob(hCPU, s_memoryBase);
+}
+
+static void RegisterHostHooks(const CemuExports& cemu) {
+    cemu.osLib_registerHLEFunction("coreinit", "hook_RouteActorJob", &hook_RouteActorJob);
+}
+
+struct HookSummary {
+    uint64_t calls = 0;
+    uint64_t skipped = 0;
+    uint64_t registerMismatches = 0;
+    uint64_t memoryMismatches = 0;
+    uint64_t followedPointers = 0;
+    uint64_t minNs = std::numeric_limits<uint64_t>::max();
+    uint64_t totalNs = 0;
+    uint64_t runs = 0;
+};
+
+static int PrintUsage() {
+    std::fprintf(stderr, "usage: BetterVR_HookReplay <capture> [--repeat <count>] [--hook <name>]\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return PrintUsage();
+    }
+    const char* capturePath = argv[1];
+    uint32_t repeatCount = 1;
+    std::string_view onlyHook;
+    for (int i = 2; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeatCount = (uint32_t)std::max(1l, std::strtol(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--hook" && i + 1 < argc) {
+            onlyHook = argv[++i];
+        }
+        else {
+            return PrintUsage();
+        }
+    }
+
+    std::ifstream file(capturePath, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        std::fprintf(stderr, "Couldn't open %s\n", capturePath);
+        return 1;
+    }
+
+    std::vector<HookReplay::Call> calls;
+    try {
+        calls = HookReplay::Load(file);
+    }
+    catch (const std::runtime_error& e) {
+        std::fprintf(stderr, "Couldn't read %s: %s\n", capturePath, e.what());
+        return 1;
+    }
+
+    CemuMock cemu;
+    s_memoryBase = cemu.GetMemoryBaseAddress();
+    RegisterHostHooks(cemu.GetExports());
+
+    std::map<std::string, HookSummary, std::less<>> summaries;
+    for (const HookReplay::Call& call : calls) {
+        if (!onlyHook.empty() && call.name != onlyHook) {
+            continue;
+        }
+        HookSummary& summary = summaries[call.name];
+        summary.calls++;
+        summary.followedPointers += call.pointers.size();
+
+        CemuMock::HLEFunction hook = cemu.FindFunction(call.name);
+        if (hook == nullptr) {
+            summary.skipped++;
+            continue;
+        }
+
+        const HookReplay::CallResult result = HookReplay::Replay(call, hook, cemu.GetPointer(0), repeatCount);
+        summary.registerMismatches += !result.registersMatch;
+        summary.memoryMismatches += result.mismatchedBytes != 0;
+        summary.minNs = std::min(summary.minNs, result.minNs);
+        summary.totalNs += result.totalNs;
+        summary.runs += repeatCount;
+    }
+
+    bool allMatch = true;
+    std::printf("%-44s %8s %8s %10s %10s %8s %10s %10s\n", "hook", "calls", "skipped", "reg diffs", "mem diffs", "ptrs", "avg ns", "min ns");
+    for (const auto& [name, summary] : summaries) {
+        const bool replayed = summary.runs != 0;
+        std::printf("%-44s %8llu %8llu %10llu %10llu %8llu %10.1f %10llu\n", name.c_str(),
+            (unsigned long long)summary.calls, (unsigned long long)summary.skipped,
+            (unsigned long long)summary.registerMismatches, (unsigned long long)summary.memoryMismatches,
+            (unsigned long long)summary.followedPointers,
+            replayed ? (double)summary.totalNs / (double)summary.runs : 0.0,
+            replayed ? (unsigned long long)summary.minNs : 0ull);
+        allMatch &= summary.registerMismatches == 0 && summary.memoryMismatches == 0;
+    }
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+// Everything the platform-neutral sources expect from include/pch.h, without the Windows, Vulkan, D3D12 and ImGui parts.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <immintrin.h>
+
+#include "endianness.h"
+#include "vr_settings.h"
+#include "cemu.h"
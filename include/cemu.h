@@ -42,4 +42,30 @@ struct PPCInterpreter_t {
 
 typedef void (*osLib_registerHLEFunctionPtr_t)(const char* libraryName, const char* functionName, void (*osFunction)(PPCInterpreter_t* hCPU));
 typedef void* (*memory_getBasePtr_t)();
-typedef uint64_t (*gameMeta_getTitleIdPtr_t)();
\ No newline at end of file
+typedef uint64_t (*gameMeta_getTitleIdPtr_t)();
+// Everything BetterVR uses from Cemu's exports. The hooks only reach Cemu through this struct,
+// so CemuHooks can be constructed against another implementation of these functions instead of a running Cemu process.
+struct CemuExports {
+    osLib_registerHLEFunctionPtr_t osLib_registerHLEFunction = nullptr;
+    memory_getBasePtr_t memory_getBase = nullptr;
+    gameMeta_getTitleIdPtr_t gameMeta_getTitleId = nullptr;
+
+    bool IsComplete() const {
+        return osLib_registerHLEFunction != nullptr && memory_getBase != nullptr && gameMeta_getTitleId != nullptr;
+    }
+
+#if defined(_WIN32)
+    // fields are left empty if the process isn't Cemu
+    static CemuExports FromProcess() {
+        CemuExports exports;
+        HMODULE cemuHandle = GetModuleHandleA(NULL);
+        if (cemuHandle == NULL) {
+            return exports;
+        }
+        exports.osLib_registerHLEFunction = (osLib_registerHLEFunctionPtr_t)GetProcAddress(cemuHandle, "osLib_registerHLEFunction");
+        exports.memory_getBase = (memory_getBasePtr_t)GetProcAddress(cemuHandle, "memory_getBase");
+        exports.gameMeta_getTitleId = (gameMeta_getTitleIdPtr_t)GetProcAddress(cemuHandle, "gameMeta_getTitleId");
+        return exports;
+    }
+#endif
+};
@@ -0,0 +1,141 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <immintrin.h>
+
+// The Wii U is big-endian, so everything read from or written to guest memory goes through these.
+// Only depends on the standard library, so that it can be used outside of the layer too.
+
+template <typename T>
+inline T swapEndianness(T val) {
+    if constexpr (sizeof(T) == 1) {
+        return val;
+    }
+    else if constexpr (std::is_integral_v<T>) {
+        return std::byteswap(val);
+    }
+    else if constexpr (std::is_enum_v<T>) {
+        return static_cast<T>(std::byteswap(std::to_underlying(val)));
+    }
+    else if constexpr (std::is_same_v<T, float>) {
+        return std::bit_cast<float>(std::byteswap(std::bit_cast<uint32_t>(val)));
+    }
+    else if constexpr (std::is_same_v<T, double>) {
+        return std::bit_cast<double>(std::byteswap(std::bit_cast<uint64_t>(val)));
+    }
+    else {
+        union U {
+            T val;
+            std::array<std::uint8_t, sizeof(T)> raw;
+        } src, dst;
+
+        src.val = val;
+        std::reverse_copy(src.raw.begin(), src.raw.end(), dst.raw.begin());
+        return dst.val;
+    }
+}
+
+// Swaps the byte order of an array of 32-bit values, which is what all of the game's vectors and matrices are made of.
+// Converts 8 or 4 values per instruction when possible, src and dst are allowed to be the same.
+inline void swapEndianness32(const void* src, void* dst, size_t count) {
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i mask256 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), _mm256_shuffle_epi8(v, mask256));
+    }
+#endif
+#if defined(__AVX__) || defined(__SSSE3__)
+    const __m128i mask128 = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), _mm_shuffle_epi8(v, mask128));
+    }
+#elif defined(_M_X64) || defined(__x86_64__)
+    // SSE2 has no byte shuffle, so swap the 16-bit halves of each value and then the bytes within each half
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+        v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4), v);
+    }
+#endif
+
+    // counts the remaining values down instead of indexing with i, g++ can't tell that i * 4 doesn't overflow once this is inlined
+    for (size_t remaining = count - i, offset = i * 4; remaining != 0; remaining--, offset += 4) {
+        uint32_t value;
+        memcpy(&value, in + offset, sizeof(value));
+        value = std::byteswap(value);
+        memcpy(out + offset, &value, sizeof(value));
+    }
+}
+
+// Types that are already stored big-endian declare an IsBEType tag instead of deriving from a shared empty base.
+// The Itanium ABI can't place an empty base at the same address as a first member with the same base, so g++ and clang
+// would pad structs like BEMatrix34 by 4 bytes while MSVC wouldn't.
+template<typename T>
+struct BEType {
+    using IsBEType = void;
+
+    T val;
+
+    BEType() = default;
+    BEType(const BEType<T>& other) = default;
+    BEType<T>& operator =(const BEType<T>& other) = default;
+
+    BEType(T x) : val(swapEndianness(x)) {}
+
+    explicit operator T() {
+        return swapEndianness(val);
+    }
+
+    BEType<T>& operator =(T x) {
+        val = swapEndianness(x);
+        return *this;
+    }
+
+    T getLE() const {
+        return swapEndianness(val);
+    }
+
+    T getBE() const {
+        return val;
+    }
+
+
+    bool operator ==(const BEType<T>& other) const { return val == other.val; }
+    bool operator ==(const T& other) const { return swapEndianness(val) == other; }
+    friend bool operator ==(const T& lhs, const BEType<T>& rhs) { return lhs == swapEndianness(rhs.val);}
+
+    bool operator !=(const BEType<T>& other) const { return val != other.val; }
+    bool operator !=(const T& other) const { return swapEndianness(val) != other; }
+    friend bool operator !=(const T& lhs, const BEType<T>& rhs) { return lhs != swapEndianness(rhs.val); }
+
+    bool operator <(const BEType<T>& other) const { return swapEndianness(val) < swapEndianness(other.val); }
+    bool operator <(const T& other) const { return swapEndianness(val) < other; }
+    friend bool operator <(const T& lhs, const BEType<T>& rhs) { return lhs < swapEndianness(rhs.val); }
+
+    bool operator >(const BEType<T>& other) const { return swapEndianness(val) > swapEndianness(other.val); }
+    bool operator >(const T& other) const { return swapEndianness(val) > other; }
+    friend bool operator >(const T& lhs, const BEType<T>& rhs) { return lhs > swapEndianness(rhs.val); }
+
+    bool operator <=(const BEType<T>& other) const { return swapEndianness(val) <= swapEndianness(other.val); }
+    bool operator <=(const T& other) const { return swapEndianness(val) <= other; }
+    friend bool operator <=(const T& lhs, const BEType<T>& rhs) { return lhs <= swapEndianness(rhs.val); }
+
+    bool operator >=(const BEType<T>& other) const { return swapEndianness(val) >= swapEndianness(other.val); }
+    bool operator >=(const T& other) const { return swapEndianness(val) >= other; }
+    friend bool operator >=(const T& lhs, const BEType<T>& rhs) { return lhs >= swapEndianness(rhs.val); }
+};
+
+
+template<typename T>
+inline constexpr bool is_BEType_v = requires { typename T::IsBEType; };
@@ -0,0 +1,96 @@
+#include "catch.h"
+#include "endianness.h"
+
+namespace {
+    enum class TestEnum : uint32_t {
+        VALUE = 0x11223344,
+    };
+
+    struct ThreeBytes {
+        uint8_t a, b, c;
+    };
+
+    std::vector<uint32_t> SwapOneByOne(const std::vector<uint32_t>& values) {
+        std::vector<uint32_t> swapped;
+        for (uint32_t value : values) {
+            swapped.push_back(std::byteswap(value));
+        }
+        return swapped;
+    }
+}
+
+TEST_CASE("swapEndianness swaps every supported type", "[endianness]") {
+    CHECK(swapEndianness<uint8_t>(0x12) == 0x12);
+    CHECK(swapEndianness<uint16_t>(0x1234) == 0x3412);
+    CHECK(swapEndianness<uint32_t>(0x12345678) == 0x78563412);
+    CHECK(swapEndianness<int32_t>(-2) == (int32_t)0xFEFFFFFF);
+    CHECK(swapEndianness<uint64_t>(0x0102030405060708ull) == 0x0807060504030201ull);
+    CHECK(std::to_underlying(swapEndianness(TestEnum::VALUE)) == 0x44332211);
+    CHECK(std::bit_cast<uint32_t>(swapEndianness(1.0f)) == 0x0000803F);
+    CHECK(swapEndianness(swapEndianness(-123.5)) == -123.5);
+
+    const ThreeBytes swapped = swapEndianness(ThreeBytes{ 1, 2, 3 });
+    CHECK(swapped.a == 3);
+    CHECK(swapped.b == 2);
+    CHECK(swapped.c == 1);
+}
+
+TEST_CASE("swapEndianness32 matches swapping one value at a time", "[endianness]") {
+    // covers the 8-wide and 4-wide loops and every length of leftover values
+    for (size_t count = 0; count <= 37; count++) {
+        std::vector<uint32_t> values(count);
+        for (size_t i = 0; i < count; i++) {
+            values[i] = 0x01020304u * (uint32_t)(i + 1) ^ 0xA5000000u;
+        }
+        const std::vector<uint32_t> expected = SwapOneByOne(values);
+
+        std::vector<uint32_t> out(count);
+        swapEndianness32(values.data(), out.data(), count);
+        CHECK(out == expected);
+
+        // in place, like the hooks do for the game's matrices
+        swapEndianness32(values.data(), values.data(), count);
+        CHECK(values == expected);
+    }
+}
+
+TEST_CASE("swapEndianness32 handles unaligned guest memory", "[endianness]") {
+    alignas(32) std::array<uint8_t, 4 * 12 + 1> buffer = {};
+    for (size_t i = 0; i < buffer.size(); i++) {
+        buffer[i] = (uint8_t)i;
+    }
+    std::array<uint32_t, 12> out;
+    swapEndianness32(buffer.data() + 1, out.data(), out.size());
+    for (size_t i = 0; i < out.size(); i++) {
+        const uint8_t first = (uint8_t)(1 + i * 4);
+        CHECK(out[i] == ((uint32_t)first << 24 | (uint32_t)(first + 1) << 16 | (uint32_t)(first + 2) << 8 | (uint32_t)(first + 3)));
+    }
+}
+
+TEST_CASE("BEType stores values big-endian", "[endianness]") {
+    BEType<uint32_t> value = 0x12345678u;
+    CHECK(value.getBE() == 0x78563412u);
+    CHECK(value.getLE() == 0x12345678u);
+    CHECK(value == 0x12345678u);
+    CHECK(0x12345678u == value);
+
+    value = 5u;
+    CHECK(value < 6u);
+    CHECK(value > BEType<uint32_t>(4u));
+    CHECK(value <= 5u);
+    CHECK(value != BEType<uint32_t>(0x05000000u));
+
+    const BEType<float> angle = 90.0f;
+    CHECK(angle.getLE() == 90.0f);
+
+    static_assert(sizeof(BEType<uint32_t>) == sizeof(uint32_t));
+    static_assert(is_BEType_v<BEType<float>>);
+    static_assert(!is_BEType_v<float>);
+    // guest memory gets memcpy'd into and out of BETypes
+    static_assert(std::is_trivially_copyable_v<BEType<uint32_t>>);
+    static_assert(std::is_trivially_copyable_v<BEType<float>>);
+
+    BEType<uint32_t> copy = value;
+    copy = value;
+    CHECK(copy.getLE() == 5u);
+}
@@ -2,7 +2,9 @@
 
 #pragma pack(push, 1)
 namespace sead {
-    struct SafeString : BETypeCompatible {
+    struct SafeString {
+        using IsBEType = void;
+
         BEType<uint32_t> c_str;
         BEType<uint32_t> vtable;
     };
@@ -21,6 +23,13 @@ namespace sead {
             }
             return std::string(data, strnlen(data, sizeof(data)));
         }
+
+        std::string_view getView() const {
+            if (c_str.getLE() == 0) {
+                return std::string_view();
+            }
+            return std::string_view(data, strnlen(data, sizeof(data)));
+        }
     };
     static_assert(sizeof(FixedSafeString40) == 0x4C, "FixedSafeString40 size mismatch");
 
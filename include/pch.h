@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <bit>
 #include <string>
 #include <variant>
 #include <functional>
@@ -9,7 +10,9 @@
 #include <set>
 #include <unordered_set>
 #include <queue>
+#include <deque>
 #include <iostream>
+#include <immintrin.h>
 
 #include <Windows.h>
 #include <winrt/base.h>
@@ -131,7 +134,7 @@ inline std::string wcharToUtf8(const wchar_t* wstr) {
     return str;
 }
 
-#define PADDED_BYTES(from, up) uint8_t byte_##from##[ ## (up-from+0x04) ## ]
+#define PADDED_BYTES(from, up) uint8_t byte_##from[(up - from + 0x04)]
 
 template<class T, template<class...> class U>
 inline constexpr bool is_instance_of_v = std::false_type{};
@@ -144,116 +147,11 @@ constexpr bool HAS_FLAG(T1 flags, T2 test_flag) {
     return ((uint64_t)(flags) & (uint64_t)test_flag) == (uint64_t)(test_flag);
 }
 
-template <typename T>
-inline T swapEndianness(T val) {
-    if constexpr (std::is_floating_point<T>::value) {
-        union {
-            T f;
-            uint32_t i;
-        } bits;
+#include "endianness.h"
 
-        bits.f = val;
-        bits.i = (bits.i & 0x000000FF) << 24 | (bits.i & 0x0000FF00) << 8  | (bits.i & 0x00FF0000) >> 8  | (bits.i & 0xFF000000) >> 24;
+struct BEVec2 {
+    using IsBEType = void;
 
-        return bits.f;
-    }
-    else if constexpr (std::is_integral<T>::value) {
-        if constexpr (sizeof(T) == 1) {
-            return val;
-        }
-        else if constexpr (sizeof(T) == 2) {
-            return static_cast<T>((val << 8) | (val >> 8));
-        }
-        else if constexpr (sizeof(T) == 4) {
-            return ((val & 0x000000FF) << 24) | ((val & 0x0000FF00) <<  8) | ((val & 0x00FF0000) >>  8) | ((val & 0xFF000000) >> 24);
-        }
-        else {
-            union U {
-                T val;
-                std::array<std::uint8_t, sizeof(T)> raw;
-            } src, dst;
-
-            src.val = val;
-            std::reverse_copy(src.raw.begin(), src.raw.end(), dst.raw.begin());
-            return dst.val;
-        }
-    }
-    else {
-        union U {
-            T val;
-            std::array<std::uint8_t, sizeof(T)> raw;
-        } src, dst;
-
-        src.val = val;
-        std::reverse_copy(src.raw.begin(), src.raw.end(), dst.raw.begin());
-        return dst.val;
-    }
-}
-
-struct BETypeCompatible {
-};
-
-template<typename T>
-struct BEType : BETypeCompatible {
-    T val;
-
-    BEType() = default;
-
-    BEType(T x) : val(swapEndianness(x)) {}
-
-    explicit operator T() {
-        return swapEndianness(val);
-    }
-
-    BEType<T>& operator =(T x) {
-        val = swapEndianness(x);
-        return *this;
-    }
-
-    BEType<T>& operator =(const BEType<T>& other) {
-        val = other.val;
-        return *this;
-    }
-
-    T getLE() const {
-        return swapEndianness(val);
-    }
-
-    T getBE() const {
-        return val;
-    }
-
-
-    bool operator ==(const BEType<T>& other) const { return val == other.val; }
-    bool operator ==(const T& other) const { return swapEndianness(val) == other; }
-    friend bool operator ==(const T& lhs, const BEType<T>& rhs) { return lhs == swapEndianness(rhs.val);}
-
-    bool operator !=(const BEType<T>& other) const { return val != other.val; }
-    bool operator !=(const T& other) const { return swapEndianness(val) != other.val; }
-    friend bool operator !=(const T& lhs, const BEType<T>& rhs) { return lhs != swapEndianness(rhs.val); }
-
-    bool operator <(const BEType<T>& other) const { return swapEndianness(val) < swapEndianness(other.val); }
-    bool operator <(const T& other) const { return swapEndianness(val) < other; }
-    friend bool operator <(const T& lhs, const BEType<T>& rhs) { return lhs < swapEndianness(rhs.val); }
-
-    bool operator >(const BEType<T>& other) const { return swapEndianness(val) > swapEndianness(other.val); }
-    bool operator >(const T& other) const { return swapEndianness(val) > other; }
-    friend bool operator >(const T& lhs, const BEType<T>& rhs) { return lhs > swapEndianness(rhs.val); }
-
-    bool operator <=(const BEType<T>& other) const { return swapEndianness(val) <= swapEndianness(other.val); }
-    bool operator <=(const T& other) const { return swapEndianness(val) <= other; }
-    friend bool operator <=(const T& lhs, const BEType<T>& rhs) { return lhs <= swapEndianness(rhs.val); }
-
-    bool operator >=(const BEType<T>& other) const { return swapEndianness(val) >= swapEndianness(other.val); }
-    bool operator >=(const T& other) const { return swapEndianness(val) >= other; }
-    friend bool operator >=(const T& lhs, const BEType<T>& rhs) { return lhs >= swapEndianness(rhs.val); }
-};
-
-
-template<typename T>
-inline constexpr bool is_BEType_v = std::is_base_of_v<BETypeCompatible, T>;
-
-struct BEVec2 : BETypeCompatible {
     BEType<float> x;
     BEType<float> y;
 
@@ -261,8 +159,11 @@ struct BEVec2 : BETypeCompatible {
     BEVec2(float x, float y): x(x), y(y) {}
     BEVec2(BEType<float> x, BEType<float> y): x(x), y(y) {}
 };
+static_assert(sizeof(BEVec2) == 0x08, "BEVec2 size mismatch");
+
+struct BEVec3 {
+    using IsBEType = void;
 
-struct BEVec3 : BETypeCompatible {
     BEType<float> x;
     BEType<float> y;
     BEType<float> z;
@@ -289,8 +190,11 @@ struct BEVec3 : BETypeCompatible {
         z = other.z;
     }
 };
+static_assert(sizeof(BEVec3) == 0x0C, "BEVec3 size mismatch");
+
+struct BEMatrix34 {
+    using IsBEType = void;
 
-struct BEMatrix34 : BETypeCompatible {
     BEType<float> x_x;
     BEType<float> y_x;
     BEType<float> z_x;
@@ -318,29 +222,25 @@ struct BEMatrix34 : BETypeCompatible {
     }
 
     glm::mat4x3 getLEMatrix() const {
+        // rows are stored as x_?, y_?, z_?, pos_?
+        std::array<float, 12> rows;
+        swapEndianness32(&x_x, rows.data(), rows.size());
         return glm::mat4x3(
-            glm::vec3(x_x.getLE(), x_y.getLE(), x_z.getLE()),      // X basis column
-            glm::vec3(y_x.getLE(), y_y.getLE(), y_z.getLE()),      // Y basis column
-            glm::vec3(z_x.getLE(), z_y.getLE(), z_z.getLE()),      // Z basis column
-            glm::vec3(pos_x.getLE(), pos_y.getLE(), pos_z.getLE()) // translation column
+            glm::vec3(rows[0], rows[4], rows[8]),  // X basis column
+            glm::vec3(rows[1], rows[5], rows[9]),  // Y basis column
+            glm::vec3(rows[2], rows[6], rows[10]), // Z basis column
+            glm::vec3(rows[3], rows[7], rows[11])  // translation column
         );
     }
 
     void setLEMatrix(const glm::mat4x3& m) {
         // m[col][row]
-        x_x = m[0][0];
-        x_y = m[0][1];
-        x_z = m[0][2];
-        y_x = m[1][0];
-        y_y = m[1][1];
-        y_z = m[1][2];
-        z_x = m[2][0];
-        z_y = m[2][1];
-        z_z = m[2][2];
-
-        pos_x = m[3][0];
-        pos_y = m[3][1];
-        pos_z = m[3][2];
+        std::array<float, 12> rows = {
+            m[0][0], m[1][0], m[2][0], m[3][0],
+            m[0][1], m[1][1], m[2][1], m[3][1],
+            m[0][2], m[1][2], m[2][2], m[3][2]
+        };
+        swapEndianness32(rows.data(), &x_x, rows.size());
     }
 
     BEVec3 getPos() const {
@@ -371,8 +271,11 @@ struct BEMatrix34 : BETypeCompatible {
         z_z = rotMat[2][2];
     }
 };
+static_assert(sizeof(BEMatrix34) == 0x30, "BEMatrix34 needs to be tightly packed for swapEndianness32");
+
+struct BEMatrix44 {
+    using IsBEType = void;
 
-struct BEMatrix44 : BETypeCompatible {
     BEType<float> a00;
     BEType<float> a01;
     BEType<float> a02;
@@ -393,126 +296,18 @@ struct BEMatrix44 : BETypeCompatible {
     BEMatrix44() = default;
 
     glm::fmat4 getLE() const {
-        return glm::fmat4(
-            a00.getLE(), a01.getLE(), a02.getLE(), a03.getLE(),
-            a10.getLE(), a11.getLE(), a12.getLE(), a13.getLE(),
-            a20.getLE(), a21.getLE(), a22.getLE(), a23.getLE(),
-            a30.getLE(), a31.getLE(), a32.getLE(), a33.getLE()
-        );
+        glm::fmat4 mtx;
+        swapEndianness32(&a00, glm::value_ptr(mtx), 16);
+        return mtx;
     }
 
     void operator=(glm::fmat4 mtx) {
-        a00 = mtx[0][0];
-        a01 = mtx[0][1];
-        a02 = mtx[0][2];
-        a03 = mtx[0][3];
-        a10 = mtx[1][0];
-        a11 = mtx[1][1];
-        a12 = mtx[1][2];
-        a13 = mtx[1][3];
-        a20 = mtx[2][0];
-        a21 = mtx[2][1];
-        a22 = mtx[2][2];
-        a23 = mtx[2][3];
-        a30 = mtx[3][0];
-        a31 = mtx[3][1];
-        a32 = mtx[3][2];
-        a33 = mtx[3][3];
+        swapEndianness32(glm::value_ptr(mtx), &a00, 16);
     }
 };
+static_assert(sizeof(BEMatrix44) == 0x40, "BEMatrix44 needs to be tightly packed for swapEndianness32");
 
-enum class EventMode {
-    NO_EVENT = 0,
-    ALWAYS_FIRST_PERSON = 1,
-    FOLLOW_DEFAULT_EVENT_SETTINGS = 2,
-    ALWAYS_THIRD_PERSON = 3,
-};
-
-struct data_VRSettingsIn {
-    BEType<int32_t> cameraModeSetting;
-    BEType<int32_t> leftHandedSetting;
-    BEType<int32_t> guiFollowSetting;
-    BEType<float> playerHeightSetting;
-    BEType<int32_t> enable2DVRView;
-    BEType<int32_t> cropFlatTo16x9Setting;
-    BEType<int32_t> enableDebugOverlay;
-    BEType<int32_t> buggyAngularVelocity;
-    BEType<int32_t> cutsceneCameraMode;
-    BEType<int32_t> cutsceneBlackBars;
-
-    bool IsLeftHanded() const {
-        return leftHandedSetting == 1;
-    }
-
-    bool IsFirstPersonMode() const {
-        return cameraModeSetting == 1;
-    }
-
-    bool IsThirdPersonMode() const {
-        return cameraModeSetting == 0;
-    }
-
-    EventMode GetCutsceneCameraMode() const {
-        // if in third-person mode, always use third-person cutscene camera
-        if (IsThirdPersonMode()) {
-            return EventMode::ALWAYS_THIRD_PERSON;
-        }
-
-        return (EventMode)cutsceneCameraMode.getLE();
-    }
-
-    bool UseBlackBarsForCutscenes() const {
-        return cutsceneBlackBars == 1;
-    }
-
-    bool UIFollowsLookingDirection() const {
-        return guiFollowSetting == 1;
-    }
-
-    bool Is2DVRViewEnabled() const {
-        return enable2DVRView == 1;
-    }
-
-    bool ShouldFlatPreviewBeCroppedTo16x9() const {
-        return cropFlatTo16x9Setting == 1;
-    }
-
-    bool ShowDebugOverlay() const {
-        return enableDebugOverlay.getLE() != 0;
-    }
-
-    float GetZNear() const {
-        return 0.1f;
-    }
-
-    float GetZFar() const {
-        return 25000.0f;
-    }
-
-    enum class AngularVelocityFixerMode {
-        AUTO = 0, // Angular velocity fixer is automatically enabled for Oculus Link
-        FORCED_ON = 1,
-        FORCED_OFF = 2,
-    };
-
-    AngularVelocityFixerMode AngularVelocityFixer_GetMode() {
-        return (AngularVelocityFixerMode)buggyAngularVelocity.getLE();
-    }
-
-    std::string ToString() const {
-        std::string buffer = "";
-        std::format_to(std::back_inserter(buffer), " - Camera Mode: {}\n", IsFirstPersonMode() ? "First Person" : "Third Person");
-        std::format_to(std::back_inserter(buffer), " - Left Handed: {}\n", IsLeftHanded() ? "Yes" : "No");
-        std::format_to(std::back_inserter(buffer), " - GUI Follow Setting: {}\n", UIFollowsLookingDirection() ? "Follow Looking Direction" : "Fixed");
-        std::format_to(std::back_inserter(buffer), " - Player Height: {} meters\n", playerHeightSetting.getLE());
-        std::format_to(std::back_inserter(buffer), " - 2D VR View Enabled: {}\n", Is2DVRViewEnabled() ? "Yes" : "No");
-        std::format_to(std::back_inserter(buffer), " - Crop Flat to 16:9: {}\n", ShouldFlatPreviewBeCroppedTo16x9() ? "Yes" : "No");
-        std::format_to(std::back_inserter(buffer), " - Debug Overlay: {}\n", ShowDebugOverlay() ? "Enabled" : "Disabled");
-        std::format_to(std::back_inserter(buffer), " - Cutscene Camera Mode: {}\n", GetCutsceneCameraMode() == EventMode::ALWAYS_FIRST_PERSON ? "Always First Person" : (GetCutsceneCameraMode() == EventMode::ALWAYS_THIRD_PERSON ? "Always Third Person" : "Follow Default Event Settings"));
-        std::format_to(std::back_inserter(buffer), " - Show Black Bars for Third-Person Cutscenes: {}\n", UseBlackBarsForCutscenes() ? "Yes" : "No");
-        return buffer;
-    }
-};
+#include "vr_settings.h"
 
 
 
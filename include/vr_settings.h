@@ -0,0 +1,157 @@
+#pragma once
+
+// Settings the graphic pack hands to hook_UpdateSettings, and the native copy of them that the hooks read
+
+enum class EventMode {
+    NO_EVENT = 0,
+    ALWAYS_FIRST_PERSON = 1,
+    FOLLOW_DEFAULT_EVENT_SETTINGS = 2,
+    ALWAYS_THIRD_PERSON = 3,
+};
+
+struct data_VRSettingsIn {
+    BEType<int32_t> cameraModeSetting;
+    BEType<int32_t> leftHandedSetting;
+    BEType<int32_t> guiFollowSetting;
+    BEType<float> playerHeightSetting;
+    BEType<int32_t> enable2DVRView;
+    BEType<int32_t> cropFlatTo16x9Setting;
+    BEType<int32_t> enableDebugOverlay;
+    BEType<int32_t> buggyAngularVelocity;
+    BEType<int32_t> cutsceneCameraMode;
+    BEType<int32_t> cutsceneBlackBars;
+    BEType<int32_t> singlePassStereo;
+    BEType<float> renderScaleSetting;
+    BEType<float> hudScaleSetting;
+    BEType<int32_t> dynamicResolution;
+    BEType<int32_t> stereoSwapchains;
+};
+static_assert(sizeof(data_VRSettingsIn) == 0x3C, "data_VRSettingsIn needs to match the graphic pack's settings layout");
+
+// Native copy of data_VRSettingsIn, decoded once whenever the graphic pack updates its settings
+struct VRSettings {
+    int32_t cameraModeSetting = 0;
+    int32_t leftHandedSetting = 0;
+    int32_t guiFollowSetting = 0;
+    float playerHeightSetting = 0.0f;
+    int32_t enable2DVRView = 0;
+    int32_t cropFlatTo16x9Setting = 0;
+    int32_t enableDebugOverlay = 0;
+    int32_t buggyAngularVelocity = 0;
+    int32_t cutsceneCameraMode = 0;
+    int32_t cutsceneBlackBars = 0;
+    int32_t singlePassStereo = 0;
+    float renderScaleSetting = 1.0f;
+    float hudScaleSetting = 1.0f;
+    int32_t dynamicResolution = 0;
+    int32_t stereoSwapchains = 0;
+
+    static VRSettings FromGuest(const data_VRSettingsIn& in) {
+        return VRSettings{
+            .cameraModeSetting = in.cameraModeSetting.getLE(),
+            .leftHandedSetting = in.leftHandedSetting.getLE(),
+            .guiFollowSetting = in.guiFollowSetting.getLE(),
+            .playerHeightSetting = in.playerHeightSetting.getLE(),
+            .enable2DVRView = in.enable2DVRView.getLE(),
+            .cropFlatTo16x9Setting = in.cropFlatTo16x9Setting.getLE(),
+            .enableDebugOverlay = in.enableDebugOverlay.getLE(),
+            .buggyAngularVelocity = in.buggyAngularVelocity.getLE(),
+            .cutsceneCameraMode = in.cutsceneCameraMode.getLE(),
+            .cutsceneBlackBars = in.cutsceneBlackBars.getLE(),
+            .singlePassStereo = in.singlePassStereo.getLE(),
+            .renderScaleSetting = in.renderScaleSetting.getLE(),
+            .hudScaleSetting = in.hudScaleSetting.getLE(),
+            .dynamicResolution = in.dynamicResolution.getLE(),
+            .stereoSwapchains = in.stereoSwapchains.getLE()
+        };
+    }
+
+    bool IsLeftHanded() const {
+        return leftHandedSetting == 1;
+    }
+
+    bool IsFirstPersonMode() const {
+        return cameraModeSetting == 1;
+    }
+
+    bool IsThirdPersonMode() const {
+        return cameraModeSetting == 0;
+    }
+
+    EventMode GetCutsceneCameraMode() const {
+        // if in third-person mode, always use third-person cutscene camera
+        if (IsThirdPersonMode()) {
+            return EventMode::ALWAYS_THIRD_PERSON;
+        }
+
+        return (EventMode)cutsceneCameraMode;
+    }
+
+    bool UseBlackBarsForCutscenes() const {
+        return cutsceneBlackBars == 1;
+    }
+
+    bool UIFollowsLookingDirection() const {
+        return guiFollowSetting == 1;
+    }
+
+    bool Is2DVRViewEnabled() const {
+        return enable2DVRView == 1;
+    }
+
+    bool ShouldFlatPreviewBeCroppedTo16x9() const {
+        return cropFlatTo16x9Setting == 1;
+    }
+
+    bool ShowDebugOverlay() const {
+        return enableDebugOverlay != 0;
+    }
+
+    // only the left eye gets drawn by the game, the right eye is reprojected from it using its depth
+    bool IsSinglePassStereoEnabled() const {
+        return singlePassStereo == 1;
+    }
+
+    // scale of the headset's recommended resolution for the 3D layer's swapchains
+    float GetRenderScale() const {
+        return std::clamp(renderScaleSetting, 0.25f, 2.0f);
+    }
+
+    float GetHUDScale() const {
+        return std::clamp(hudScaleSetting, 0.25f, 2.0f);
+    }
+
+    bool IsDynamicResolutionEnabled() const {
+        return dynamicResolution == 1;
+    }
+
+    // both eyes share one swapchain with two array layers
+    bool UseStereoSwapchains() const {
+        return stereoSwapchains == 1;
+    }
+
+    float GetPlayerHeight() const {
+        return playerHeightSetting;
+    }
+
+    float GetZNear() const {
+        return 0.1f;
+    }
+
+    float GetZFar() const {
+        return 25000.0f;
+    }
+
+    enum class AngularVelocityFixerMode {
+        AUTO = 0, // Angular velocity fixer is automatically enabled for Oculus Link
+        FORCED_ON = 1,
+        FORCED_OFF = 2,
+    };
+
+    AngularVelocityFixerMode AngularVelocityFixer_GetMode() const {
+        return (AngularVelocityFixerMode)buggyAngularVelocity;
+    }
+
+    // defined in settings.cpp, which logs the settings
+    std::string ToString() const;
+};
@@ -0,0 +1,90 @@
+#include "catch.h"
+#include "cemu_mock.h"
+#include "vr_settings.h"
+#include "utils/snapshot_publisher.h"
+
+namespace {
+    // the graphic pack writes its settings as big endian values in this order
+    struct GuestSettings {
+        int32_t cameraMode = 1;
+        int32_t leftHanded = 0;
+        int32_t guiFollow = 1;
+        float playerHeight = 1.8f;
+        int32_t enable2DVRView = 0;
+        int32_t cropFlatTo16x9 = 1;
+        int32_t enableDebugOverlay = 0;
+        int32_t buggyAngularVelocity = 2;
+        int32_t cutsceneCameraMode = 2;
+        int32_t cutsceneBlackBars = 0;
+        int32_t singlePassStereo = 1;
+        float renderScale = 1.5f;
+        float hudScale = 0.1f;
+        int32_t dynamicResolution = 1;
+        int32_t stereoSwapchains = 0;
+
+        uint32_t WriteTo(CemuMock& cemu) const {
+            const uint32_t address = cemu.Allocate(sizeof(data_VRSettingsIn));
+            std::array<uint32_t, sizeof(GuestSettings) / sizeof(uint32_t)> words;
+            std::memcpy(words.data(), this, sizeof(GuestSettings));
+            for (size_t i = 0; i < words.size(); i++) {
+                cemu.Write(address + (uint32_t)(i * sizeof(uint32_t)), std::byteswap(words[i]));
+            }
+            return address;
+        }
+    };
+    static_assert(sizeof(GuestSettings) == sizeof(data_VRSettingsIn));
+
+    // SnapshotPublisher compares settings bitwise, so they can't have any padding
+    static_assert(sizeof(VRSettings) == 15 * sizeof(int32_t));
+}
+
+TEST_CASE("VRSettings decodes the graphic pack's settings from guest memory", "[vr_settings]") {
+    CemuMock cemu;
+    const uint32_t address = GuestSettings{}.WriteTo(cemu);
+
+    const VRSettings settings = VRSettings::FromGuest(cemu.Read<data_VRSettingsIn>(address));
+    CHECK(settings.IsFirstPersonMode());
+    CHECK_FALSE(settings.IsLeftHanded());
+    CHECK(settings.UIFollowsLookingDirection());
+    CHECK(settings.GetPlayerHeight() == 1.8f);
+    CHECK(settings.ShouldFlatPreviewBeCroppedTo16x9());
+    CHECK(settings.AngularVelocityFixer_GetMode() == VRSettings::AngularVelocityFixerMode::FORCED_OFF);
+    CHECK(settings.GetCutsceneCameraMode() == EventMode::FOLLOW_DEFAULT_EVENT_SETTINGS);
+    CHECK(settings.IsSinglePassStereoEnabled());
+    CHECK(settings.GetRenderScale() == 1.5f);
+    // out of range scales get clamped
+    CHECK(settings.GetHUDScale() == 0.25f);
+    CHECK(settings.IsDynamicResolutionEnabled());
+    CHECK_FALSE(settings.UseStereoSwapchains());
+}
+
+TEST_CASE("VRSettings third person mode overrides the cutscene camera mode", "[vr_settings]") {
+    CemuMock cemu;
+    GuestSettings guestSettings;
+    guestSettings.cameraMode = 0;
+    guestSettings.cutsceneCameraMode = 1;
+
+    const VRSettings settings = VRSettings::FromGuest(cemu.Read<data_VRSettingsIn>(guestSettings.WriteTo(cemu)));
+    CHECK(settings.IsThirdPersonMode());
+    CHECK(settings.GetCutsceneCameraMode() == EventMode::ALWAYS_THIRD_PERSON);
+}
+
+TEST_CASE("VRSettings only get published again when the graphic pack changed them", "[vr_settings]") {
+    CemuMock cemu;
+    SnapshotPublisher<VRSettings> publisher;
+    GuestSettings guestSettings;
+
+    // hook_UpdateSettings decodes the settings every frame, but they only change when the user edits them
+    const uint32_t address = guestSettings.WriteTo(cemu);
+    CHECK(publisher.Publish(VRSettings::FromGuest(cemu.Read<data_VRSettingsIn>(address))));
+    for (int frame = 0; frame < 10; frame++) {
+        CHECK_FALSE(publisher.Publish(VRSettings::FromGuest(cemu.Read<data_VRSettingsIn>(address))));
+    }
+    CHECK(publisher.Generation() == 1);
+
+    guestSettings.renderScale = 0.75f;
+    const uint32_t changedAddress = guestSettings.WriteTo(cemu);
+    CHECK(publisher.Publish(VRSettings::FromGuest(cemu.Read<data_VRSettingsIn>(changedAddress))));
+    CHECK(publisher.Get().GetRenderScale() == 0.75f);
+    CHECK(publisher.Generation() == 2);
+}
@@ -13,6 +13,7 @@ moduleMatches = 0x6267BFD0
 
 ; This modification causes the game to do all the draw calls for all actors, and then present that to the regular screen twice. The Vulkan layer waits for Cemu to draw to the regular screen twice, after which it has obtained both the rendered images for both eyes.
 ; Its not as optimized as it could be since Cemu has to translate the draw calls twice which is usually the bottleneck for emulation, but it provides a great stable image which can later be interpolated so that performance is less of an issue.
+; When $singlePassStereo is enabled the right eye's procDraw is skipped entirely, and the Vulkan layer reconstructs the right eye from the left eye's color and depth instead.
 
 currentEyeSide:
 .int 0
@@ -134,12 +135,19 @@ bctrl ; bl calculateUIMaybe
 ; FIRST EYE SIDE
 ; ========================================================================
 
+; with single-pass stereo the right eye gets reprojected from the left eye by the Vulkan layer, so skip drawing it
+li r0, $singlePassStereo
+cmpwi r0, 1
+beq skip_firstEyeSideDraw
+
 lwz r12, 0(r30)
 lwz r0, 0xF4(r12)
 mtctr r0
 mr r3, r30
 bctrl ; sead__GameFrameworkCafe__procDraw
 
+skip_firstEyeSideDraw:
+
 ; doesn't seem to be necessary
 ;bl import.gx2.GX2DrawDone
 
@@ -164,7 +172,12 @@ li r0, 0
 lis r12, currentEyeSide@ha
 stw r0, currentEyeSide@l(r12)
 li r3, 0
+; pass the frame counter so that the views this eye gets rendered with can be stored alongside its frame
+mr r11, r4
+lis r12, currentFrameCounter@ha
+lwz r4, currentFrameCounter@l(r12)
 bl import.coreinit.hook_BeginCameraSide
+mr r4, r11
 
 lwz r12, 0(r30)
 lwz r11, 0xFC(r12)
@@ -228,7 +241,12 @@ li r0, 1
 lis r12, currentEyeSide@ha
 stw r0, currentEyeSide@l(r12)
 li r3, 1
+; pass the frame counter so that the views this eye gets rendered with can be stored alongside its frame
+mr r11, r4
+lis r12, currentFrameCounter@ha
+lwz r4, currentFrameCounter@l(r12)
 bl import.coreinit.hook_BeginCameraSide
+mr r4, r11
 
 lwz r12, 0(r30)
 lwz r11, 0xFC(r12)
@@ -34,6 +34,21 @@ CutsceneCameraMode:
 CutsceneBlackBars:
 .int $cutsceneBlackBars
 
+SinglePassStereo:
+.int $singlePassStereo
+
+RenderScale:
+.float $renderScale
+
+HUDScale:
+.float $hudScale
+
+DynamicResolution:
+.int $dynamicResolution
+
+StereoSwapchains:
+.int $stereoSwapchains
+
 
 
 eventName:
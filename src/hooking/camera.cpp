@@ -1,12 +1,15 @@
 #include "cemu_hooks.h"
+#include "eye_projection.h"
 #include "instance.h"
 #include "rendering/openxr.h"
+#include "utils/string_hash.h"
 
 
 void CemuHooks::hook_BeginCameraSide(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
     OpenXR::EyeSide side = hCPU->gpr[0] == 0 ? OpenXR::EyeSide::LEFT : OpenXR::EyeSide::RIGHT;
+    long frameIdx = hCPU->gpr[4] == 0 ? 0 : 1;
 
     Log::print<RENDERING>("");
     Log::print<RENDERING>("===============================================================================");
@@ -18,6 +21,13 @@ void CemuHooks::hook_BeginCameraSide(PPCInterpreter_t* hCPU) {
     if (layersInitialized && side == OpenXR::EyeSide::LEFT) {
         VRManager::instance().XR->GetRenderer()->StartFrame();
     }
+    else if (layersInitialized && renderer->IsInitialized()) {
+        // the right eye is drawn last, so poll the images that weren't released yet one more time before EndFrame needs them
+        renderer->PollSwapchainImages();
+    }
+
+    // the camera and projection hooks of this eye's pass all read the current views, so this is what the eye gets rendered with
+    renderer->LatchView(side, frameIdx);
 }
 
 static std::pair<glm::quat, glm::quat> swingTwistY(const glm::quat& q) {
@@ -47,17 +57,12 @@ void CemuHooks::hook_UpdateCameraForGameplay(PPCInterpreter_t* hCPU) {
     // read the camera matrix from the game's memory
     uint32_t ppc_cameraMatrixOffsetIn = hCPU->gpr[31];
     OpenXR::EyeSide side = hCPU->gpr[3] == 0 ? OpenXR::EyeSide::LEFT : OpenXR::EyeSide::RIGHT;
-    ActCamera actCam = {};
-    readMemory(ppc_cameraMatrixOffsetIn, &actCam);
+    LookAtMatrix& camMtx = getView<ActCamera>(ppc_cameraMatrixOffsetIn)->finalCamMtx;
 
     // extract components from the existing camera matrix
-    glm::fvec3 oldCameraPosition = actCam.finalCamMtx.pos.getLE();
-    glm::fvec3 oldCameraTarget = actCam.finalCamMtx.target.getLE();
-    glm::fvec3 oldCameraForward = glm::normalize(oldCameraTarget - oldCameraPosition);
-    glm::fvec3 oldCameraUp = actCam.finalCamMtx.up.getLE();
-    glm::fvec3 oldCameraUnknown = actCam.finalCamMtx.unknown.getLE();
-    float extraValue0 = actCam.finalCamMtx.zNear.getLE();
-    float extraValue1 = actCam.finalCamMtx.zFar.getLE();
+    glm::fvec3 oldCameraPosition = camMtx.pos.getLE();
+    glm::fvec3 oldCameraTarget = camMtx.target.getLE();
+    glm::fvec3 oldCameraUp = camMtx.up.getLE();
 
     Log::print<RENDERING>("[{}] Getting gameplay camera (pos = {})", side, oldCameraPosition);
 
@@ -75,17 +80,16 @@ void CemuHooks::hook_UpdateCameraForGameplay(PPCInterpreter_t* hCPU) {
     // rebase the rotation to the player position
     if (IsFirstPerson()) {
         // check if player is swimming
-        Player actor;
-        readMemory(s_playerAddress, &actor);
+        auto player = getView<Player>(s_playerAddress);
 
-        PlayerMoveBitFlags moveBits = actor.moveBitFlags.getLE();
+        PlayerMoveBitFlags moveBits = player->moveBitFlags.getLE();
         s_isSwimming = (std::to_underlying(moveBits) & std::to_underlying(PlayerMoveBitFlags::SWIMMING_1024)) != 0;
 
         //Log::print<INFO>("{:08X}", std::to_underlying(moveBits));
 
         // read player MTX
-        BEMatrix34& mtx = actor.mtx;
-        glm::fvec3 playerPos = actor.mtx.getPos().getLE();
+        const BEMatrix34& mtx = player->mtx;
+        glm::fvec3 playerPos = mtx.getPos().getLE();
 
         playerPos.y += s_isSwimming ? hardcodedSwimOffset : 0.0f;
 
@@ -128,14 +132,11 @@ void CemuHooks::hook_UpdateCameraForGameplay(PPCInterpreter_t* hCPU) {
     float oldCameraDistance = glm::distance(oldCameraPosition, oldCameraTarget);
     glm::fvec3 target = camPos + forward * oldCameraDistance;
 
-    actCam.finalCamMtx.pos = camPos;
-    actCam.finalCamMtx.target = target;
-    actCam.finalCamMtx.up = up;
-    //actCam.finalCamMtx.up = glm::fvec3(0.0f, 1.0f, 0.0f);
-
     // write back the modified camera matrix to the game's memory
-    uint32_t ppc_cameraMatrixOffsetOut = hCPU->gpr[31];
-    writeMemory(ppc_cameraMatrixOffsetOut, &actCam);
+    camMtx.pos = camPos;
+    camMtx.target = target;
+    camMtx.up = up;
+    //camMtx.up = glm::fvec3(0.0f, 1.0f, 0.0f);
     s_framesSinceLastCameraUpdate = 0;
 }
 
@@ -235,29 +236,17 @@ constexpr uint32_t seadPerspectiveProjection = 0x1027B54C;
 // https://github.com/KhronosGroup/OpenXR-SDK/blob/858912260ca616f4c23f7fb61c89228c353eb124/src/common/xr_linear.h#L564C1-L632C2
 // https://github.com/aboood40091/sead/blob/45b629fb032d88b828600a1b787729f2d398f19d/engine/library/modules/src/gfx/seadProjection.cpp#L166
 
-static data_VRProjectionMatrixOut calculateFOVAndOffset(XrFovf viewFOV) {
-    float totalHorizontalFov = viewFOV.angleRight - viewFOV.angleLeft;
-    float totalVerticalFov = viewFOV.angleUp - viewFOV.angleDown;
-
-    float aspectRatio = totalHorizontalFov / totalVerticalFov;
-    float fovY = totalVerticalFov;
-    float projectionCenter_offsetX = (viewFOV.angleRight + viewFOV.angleLeft) / 2.0f;
-    float projectionCenter_offsetY = (viewFOV.angleUp + viewFOV.angleDown) / 2.0f;
+static EyeProjectionCache s_eyeProjections;
 
-    data_VRProjectionMatrixOut ret = {};
-    ret.aspectRatio = aspectRatio;
-    ret.fovY = fovY;
-    ret.offsetX = projectionCenter_offsetX;
-    ret.offsetY = projectionCenter_offsetY;
-
-    return ret;
+static const EyeProjection& getEyeProjection(OpenXR::EyeSide side, const XrFovf& fov) {
+    return s_eyeProjections.Get(side, EyeFov{ fov.angleLeft, fov.angleRight, fov.angleUp, fov.angleDown });
 }
 
-static glm::mat4 calculateProjectionMatrix(float nearZ, float farZ, const XrFovf& fov) {
-    float l = tanf(fov.angleLeft) * nearZ;
-    float r = tanf(fov.angleRight) * nearZ;
-    float b = tanf(fov.angleDown) * nearZ;
-    float t = tanf(fov.angleUp) * nearZ;
+static glm::mat4 calculateProjectionMatrix(float nearZ, float farZ, const EyeProjection& proj) {
+    float l = proj.tanLeft * nearZ;
+    float r = proj.tanRight * nearZ;
+    float b = proj.tanDown * nearZ;
+    float t = proj.tanUp * nearZ;
 
     float invW = 1.0f / (r - l);
     float invH = 1.0f / (t - b);
@@ -276,6 +265,36 @@ static glm::mat4 calculateProjectionMatrix(float nearZ, float farZ, const XrFovf
     return dst;
 }
 
+// replaces the FOV, offset and matrices of the game's projection while keeping its near and far planes
+static void applyEyeProjection(BESeadPerspectiveProjection& perspectiveProjection, const EyeProjection& proj) {
+    perspectiveProjection.aspect = proj.aspectRatio;
+    perspectiveProjection.fovYRadiansOrAngle = proj.fovY;
+    perspectiveProjection.fovySin = proj.fovYSin;
+    perspectiveProjection.fovyCos = proj.fovYCos;
+    perspectiveProjection.fovyTan = proj.fovYTan;
+    perspectiveProjection.offset.x = proj.offsetX;
+    perspectiveProjection.offset.y = proj.offsetY;
+
+    glm::fmat4 newMatrix = calculateProjectionMatrix(perspectiveProjection.zNear.getLE(), perspectiveProjection.zFar.getLE(), proj);
+    perspectiveProjection.matrix = newMatrix;
+
+    // calculate device matrix
+    glm::fmat4 newDeviceMatrix = newMatrix;
+
+    float zScale = perspectiveProjection.deviceZScale.getLE();
+    float zOffset = perspectiveProjection.deviceZOffset.getLE();
+
+    newDeviceMatrix[2][0] *= zScale;
+    newDeviceMatrix[2][1] *= zScale;
+    newDeviceMatrix[2][2] = (newDeviceMatrix[2][2] + newDeviceMatrix[3][2] * zOffset) * zScale;
+    newDeviceMatrix[2][3] = newDeviceMatrix[2][3] * zScale + newDeviceMatrix[3][3] * zOffset;
+
+    perspectiveProjection.deviceMatrix = newDeviceMatrix;
+
+    perspectiveProjection.dirty = false;
+    perspectiveProjection.deviceDirty = false;
+}
+
 void CemuHooks::hook_GetRenderProjection(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
@@ -299,39 +318,11 @@ void CemuHooks::hook_GetRenderProjection(PPCInterpreter_t* hCPU) {
     perspectiveProjection.zFar = GetSettings().GetZFar();
     perspectiveProjection.zNear = GetSettings().GetZNear();
 
-    if (!VRManager::instance().XR->GetRenderer()->GetFOV(side).has_value()) {
+    std::optional<XrFovf> currFOV = VRManager::instance().XR->GetRenderer()->GetFOV(side);
+    if (!currFOV.has_value()) {
         return;
     }
-    XrFovf currFOV = VRManager::instance().XR->GetRenderer()->GetFOV(side).value();
-    auto newProjection = calculateFOVAndOffset(currFOV);
-
-    perspectiveProjection.aspect = newProjection.aspectRatio;
-    perspectiveProjection.fovYRadiansOrAngle = newProjection.fovY;
-    float halfAngle = newProjection.fovY.getLE() * 0.5f;
-    perspectiveProjection.fovySin = sinf(halfAngle);
-    perspectiveProjection.fovyCos = cosf(halfAngle);
-    perspectiveProjection.fovyTan = tanf(halfAngle);
-    perspectiveProjection.offset.x = newProjection.offsetX;
-    perspectiveProjection.offset.y = newProjection.offsetY;
-
-    glm::fmat4 newMatrix = calculateProjectionMatrix(perspectiveProjection.zNear.getLE(), perspectiveProjection.zFar.getLE(), currFOV);
-    perspectiveProjection.matrix = newMatrix;
-
-    // calculate device matrix
-    glm::fmat4 newDeviceMatrix = newMatrix;
-
-    float zScale = perspectiveProjection.deviceZScale.getLE();
-    float zOffset = perspectiveProjection.deviceZOffset.getLE();
-
-    newDeviceMatrix[2][0] *= zScale;
-    newDeviceMatrix[2][1] *= zScale;
-    newDeviceMatrix[2][2] = (newDeviceMatrix[2][2] + newDeviceMatrix[3][2] * zOffset) * zScale;
-    newDeviceMatrix[2][3] = newDeviceMatrix[2][3] * zScale + newDeviceMatrix[3][3] * zOffset;
-
-    perspectiveProjection.deviceMatrix = newDeviceMatrix;
-
-    perspectiveProjection.dirty = false;
-    perspectiveProjection.deviceDirty = false;
+    applyEyeProjection(perspectiveProjection, getEyeProjection(side, currFOV.value()));
 
     writeMemory(projectionOut, &perspectiveProjection);
     hCPU->gpr[3] = projectionOut;
@@ -352,46 +343,17 @@ void CemuHooks::hook_ModifyLightPrePassProjectionMatrix(PPCInterpreter_t* hCPU)
     uint32_t projectionIn = hCPU->gpr[3];
     OpenXR::EyeSide side = hCPU->gpr[11] == 0 ? EyeSide::LEFT : EyeSide::RIGHT;
 
-    BESeadPerspectiveProjection perspectiveProjection = {};
-    readMemory(projectionIn, &perspectiveProjection);
-
-    if (!VRManager::instance().XR->GetRenderer()->GetFOV(side).has_value()) {
+    std::optional<XrFovf> currFOV = VRManager::instance().XR->GetRenderer()->GetFOV(side);
+    if (!currFOV.has_value()) {
         return;
     }
 
-    Log::print<RENDERING>("[{}] Modify light prepass projection", side);
-
-
-    XrFovf currFOV = VRManager::instance().XR->GetRenderer()->GetFOV(side).value();
-    auto newProjection = calculateFOVAndOffset(currFOV);
-
-    perspectiveProjection.aspect = newProjection.aspectRatio;
-    perspectiveProjection.fovYRadiansOrAngle = newProjection.fovY;
-    float halfAngle = newProjection.fovY.getLE() * 0.5f;
-    perspectiveProjection.fovySin = sinf(halfAngle);
-    perspectiveProjection.fovyCos = cosf(halfAngle);
-    perspectiveProjection.fovyTan = tanf(halfAngle);
-    perspectiveProjection.offset.x = newProjection.offsetX;
-    perspectiveProjection.offset.y = newProjection.offsetY;
-
-    glm::fmat4 newMatrix = calculateProjectionMatrix(perspectiveProjection.zNear.getLE(), perspectiveProjection.zFar.getLE(), currFOV);
-    perspectiveProjection.matrix = newMatrix;
-
-    // calculate device matrix
-    glm::fmat4 newDeviceMatrix = newMatrix;
-
-    float zScale = perspectiveProjection.deviceZScale.getLE();
-    float zOffset = perspectiveProjection.deviceZOffset.getLE();
-
-    newDeviceMatrix[2][0] *= zScale;
-    newDeviceMatrix[2][1] *= zScale;
-    newDeviceMatrix[2][2] = (newDeviceMatrix[2][2] + newDeviceMatrix[3][2] * zOffset) * zScale;
-    newDeviceMatrix[2][3] = newDeviceMatrix[2][3] * zScale + newDeviceMatrix[3][3] * zOffset;
+    BESeadPerspectiveProjection perspectiveProjection = {};
+    readMemory(projectionIn, &perspectiveProjection);
 
-    perspectiveProjection.deviceMatrix = newDeviceMatrix;
+    Log::print<RENDERING>("[{}] Modify light prepass projection", side);
 
-    perspectiveProjection.dirty = false;
-    perspectiveProjection.deviceDirty = false;
+    applyEyeProjection(perspectiveProjection, getEyeProjection(side, currFOV.value()));
 
     writeMemory(projectionIn, &perspectiveProjection);
 }
@@ -404,6 +366,7 @@ void CemuHooks::hook_EndCameraSide(PPCInterpreter_t* hCPU) {
     // todo: sometimes this can deadlock apparently?
     if (VRManager::instance().XR->GetRenderer()->IsInitialized() && side == OpenXR::EyeSide::RIGHT) {
         VRManager::instance().XR->GetRenderer()->EndFrame();
+        Telemetry::EndFrame();
         CemuHooks::m_heldWeaponsLastUpdate[0] = CemuHooks::m_heldWeaponsLastUpdate[0]++;
         CemuHooks::m_heldWeaponsLastUpdate[1] = CemuHooks::m_heldWeaponsLastUpdate[1]++;
         if (CemuHooks::m_heldWeaponsLastUpdate[0] >= 6) {
@@ -459,14 +422,12 @@ void CemuHooks::hook_SetActorOpacity(PPCInterpreter_t* hCPU) {
     float toBeSetOpacity = hCPU->fpr[1].fp0;
     uint32_t actorPtr = hCPU->gpr[3];
 
-    ActorWiiU actor;
-    readMemory(actorPtr, &actor);
+    auto actor = getView<ActorWiiU>(actorPtr);
 
     // normal behavior if it wasn't the player or a held weapon
-    if (actor.modelOpacity.getLE() != toBeSetOpacity) {
-        uint8_t opacityOrDoFlushOpacityToGPU = 1;
-        writeMemoryBE(actorPtr + offsetof(ActorWiiU, modelOpacity), &toBeSetOpacity);
-        writeMemoryBE(actorPtr + offsetof(ActorWiiU, opacityOrDoFlushOpacityToGPU), &opacityOrDoFlushOpacityToGPU);
+    if (actor->modelOpacity.getLE() != toBeSetOpacity) {
+        actor->modelOpacity = toBeSetOpacity;
+        actor->opacityOrDoFlushOpacityToGPU = 1;
     }
 }
 
@@ -479,9 +440,9 @@ void CemuHooks::hook_CalculateModelOpacity(PPCInterpreter_t* hCPU) {
     }
 }
 
-std::string CemuHooks::s_currentEvent = {};
+uint32_t CemuHooks::s_currentEvent = CemuHooks::NO_EVENT;
 CemuHooks::HybridEventSettings CemuHooks::s_currentEventSettings = {};
-std::unordered_map<std::string, CemuHooks::HybridEventSettings> CemuHooks::s_eventSettings = {};
+EventTable<CemuHooks::HybridEventSettings> CemuHooks::s_events;
 
 constexpr CemuHooks::HybridEventSettings defaultFirstPersonSettings = {
     .firstPerson = true,
@@ -490,9 +451,11 @@ constexpr CemuHooks::HybridEventSettings defaultFirstPersonSettings = {
 };
 
 void CemuHooks::initCutsceneDefaultSettings(uint32_t ppc_TableOfCutsceneEventsSettingsOffset) {
-    if (!s_eventSettings.empty()) {
+    static bool loadedEventTable = false;
+    if (loadedEventTable) {
         return;
     }
+    loadedEventTable = true;
 
     char* currPtr = reinterpret_cast<char*>(s_memoryBaseAddress + ppc_TableOfCutsceneEventsSettingsOffset);
     while (true) {
@@ -548,12 +511,12 @@ void CemuHooks::initCutsceneDefaultSettings(uint32_t ppc_TableOfCutsceneEventsSe
             else {
                 Log::print<WARNING>("Unknown cutscene default setting: {}", setting);
             }
-            s_eventSettings.insert_or_assign(eventName, entry);
+            s_events[s_events.Intern(eventName)].settings = entry;
         }
         currPtr += line.length() + 1;
     }
 
-    Log::print<VERBOSE>("Initialized cutscene default settings for {} events.", s_eventSettings.size());
+    Log::print<VERBOSE>("Initialized cutscene default settings for {} events.", s_events.Size());
 }
 
 
@@ -579,16 +542,15 @@ void CemuHooks::hook_GetEventName(PPCInterpreter_t* hCPU) {
             return;
         }
 
-        std::string eventName = std::string(eventNamePtr);
-        if (s_currentEvent == eventName) {
+        const std::string_view eventName = GuestStringView(eventNamePtr);
+        if (s_currentEvent != NO_EVENT && s_events[s_currentEvent].name == eventName) {
             return;
         }
         Log::print<INFO>("Event '{}' is now active.", eventName);
-        s_currentEvent = eventName;
+        s_currentEvent = s_events.Intern(eventName);
 
-        auto it = s_eventSettings.find(eventName);
-        if (it != s_eventSettings.end()) {
-            HybridEventSettings settings = it->second;
+        if (const auto& eventSettings = s_events[s_currentEvent].settings) {
+            HybridEventSettings settings = eventSettings.value();
             Log::print<INFO>(" - First Person: {}", settings.firstPerson ? "ON" : "OFF");
             Log::print<INFO>(" - Ignore Camera Rotation: {}", settings.ignoreCameraRotation ? "ON" : "OFF");
             Log::print<INFO>(" - Disable Player-Driven Link Hands: {}", settings.disablePlayerDrivenLinkHands ? "ON" : "OFF");
@@ -603,9 +565,9 @@ void CemuHooks::hook_GetEventName(PPCInterpreter_t* hCPU) {
         // These don't actually seem to be hooked up so won't do anything in real-time, but they do flag a cutscene as having camera control disabled for the player.
         // This can be read using the settings.demoEnableCameraInput in the HybridEventSettings struct.
     }
-    else if (!s_currentEvent.empty()) {
-        Log::print<INFO>("Event '{}' has now ended", s_currentEvent);
-        s_currentEvent = "";
+    else if (s_currentEvent != NO_EVENT) {
+        Log::print<INFO>("Event '{}' has now ended", s_events[s_currentEvent].name);
+        s_currentEvent = NO_EVENT;
     }
 }
 
@@ -1,75 +1,74 @@
 #pragma once
 #include "entity_debugger.h"
+#include "event_table.h"
+#include "guest_memory.h"
+#include "hook_capture.h"
+#include "utils/telemetry.h"
 
 
 class CemuHooks {
 public:
-    CemuHooks() {
-        m_cemuHandle = GetModuleHandleA(NULL);
-        checkAssert(m_cemuHandle != NULL, "Failed to get handle of Cemu process which is required for interfacing with Cemu!");
+    explicit CemuHooks(const CemuExports& cemu = CemuExports::FromProcess()): m_cemu(cemu) {
+        checkAssert(m_cemu.IsComplete(), "Failed to get function pointers of Cemu functions! Is this hook being used on Cemu?");
 
-        gameMeta_getTitleId = (gameMeta_getTitleIdPtr_t)GetProcAddress(m_cemuHandle, "gameMeta_getTitleId");
-        memory_getBase = (memory_getBasePtr_t)GetProcAddress(m_cemuHandle, "memory_getBase");
-        osLib_registerHLEFunction = (osLib_registerHLEFunctionPtr_t)GetProcAddress(m_cemuHandle, "osLib_registerHLEFunction");
-        checkAssert(gameMeta_getTitleId != nullptr && memory_getBase != nullptr && osLib_registerHLEFunction != nullptr, "Failed to get function pointers of Cemu functions! Is this hook being used on Cemu?");
+        const uint64_t titleId = m_cemu.gameMeta_getTitleId();
+        bool isSupportedTitleId = titleId == 0x00050000101C9300 || titleId == 0x00050000101C9400 || titleId == 0x00050000101C9500;
+        checkAssert(isSupportedTitleId, std::format("Expected title IDs for Breath of the Wild (00050000-101C9300, 00050000-101C9400 or 00050000-101C9500) but received {:16x}!", titleId).c_str());
 
-        bool isSupportedTitleId = gameMeta_getTitleId() == 0x00050000101C9300 || gameMeta_getTitleId() == 0x00050000101C9400 || gameMeta_getTitleId() == 0x00050000101C9500;
-        checkAssert(isSupportedTitleId, std::format("Expected title IDs for Breath of the Wild (00050000-101C9300, 00050000-101C9400 or 00050000-101C9500) but received {:16x}!", gameMeta_getTitleId()).c_str());
-
-        s_memoryBaseAddress = (uint64_t)memory_getBase();
+        s_memoryBaseAddress = (uint64_t)m_cemu.memory_getBase();
         checkAssert(s_memoryBaseAddress != 0, "Failed to get memory base address of Cemu process!");
 
 
-        osLib_registerHLEFunction("coreinit", "hook_UpdateSettings", &hook_UpdateSettings);
+        registerHook<&hook_UpdateSettings>("hook_UpdateSettings");
 
         // Actor Hooks
-        osLib_registerHLEFunction("coreinit", "hook_UpdateActorList", &hook_UpdateActorList);
-        osLib_registerHLEFunction("coreinit", "hook_CreateNewActor", &hook_CreateNewActor);
+        registerHook<&hook_UpdateActorList>("hook_UpdateActorList");
+        registerHook<&hook_CreateNewActor>("hook_CreateNewActor");
 
         // Camera Hooks
-        osLib_registerHLEFunction("coreinit", "hook_BeginCameraSide", &hook_BeginCameraSide);
-        osLib_registerHLEFunction("coreinit", "hook_ModifyLightPrePassProjectionMatrix", &hook_ModifyLightPrePassProjectionMatrix);
-        osLib_registerHLEFunction("coreinit", "hook_UpdateCameraForGameplay", &hook_UpdateCameraForGameplay);
-        osLib_registerHLEFunction("coreinit", "hook_GetRenderCamera", &hook_GetRenderCamera);
-        osLib_registerHLEFunction("coreinit", "hook_GetRenderProjection", &hook_GetRenderProjection);
-        osLib_registerHLEFunction("coreinit", "hook_EndCameraSide", &hook_EndCameraSide);
-
-        osLib_registerHLEFunction("coreinit", "hook_UseCameraDistance", &hook_UseCameraDistance);
-        osLib_registerHLEFunction("coreinit", "hook_ReplaceCameraMode", &hook_ReplaceCameraMode);
-        osLib_registerHLEFunction("coreinit", "hook_GetEventName", &hook_GetEventName);
-        osLib_registerHLEFunction("coreinit", "hook_OverwriteCameraParam", &hook_OverwriteCameraParam);
-        osLib_registerHLEFunction("coreinit", "hook_PlayerLadderFix", &hook_PlayerLadderFix);
+        registerHook<&hook_BeginCameraSide>("hook_BeginCameraSide");
+        registerHook<&hook_ModifyLightPrePassProjectionMatrix>("hook_ModifyLightPrePassProjectionMatrix");
+        registerHook<&hook_UpdateCameraForGameplay>("hook_UpdateCameraForGameplay");
+        registerHook<&hook_GetRenderCamera>("hook_GetRenderCamera");
+        registerHook<&hook_GetRenderProjection>("hook_GetRenderProjection");
+        registerHook<&hook_EndCameraSide>("hook_EndCameraSide");
+
+        registerHook<&hook_UseCameraDistance>("hook_UseCameraDistance");
+        registerHook<&hook_ReplaceCameraMode>("hook_ReplaceCameraMode");
+        registerHook<&hook_GetEventName>("hook_GetEventName");
+        registerHook<&hook_OverwriteCameraParam>("hook_OverwriteCameraParam");
+        registerHook<&hook_PlayerLadderFix>("hook_PlayerLadderFix");
 
         // First-Person Model Hooks
-        osLib_registerHLEFunction("coreinit", "hook_SetActorOpacity", &hook_SetActorOpacity);
-        osLib_registerHLEFunction("coreinit", "hook_CalculateModelOpacity", &hook_CalculateModelOpacity);
-        osLib_registerHLEFunction("coreinit", "hook_ModifyBoneMatrix", &hook_ModifyBoneMatrix);
-        osLib_registerHLEFunction("coreinit", "hook_ChangeWeaponMtx", &hook_ChangeWeaponMtx);
+        registerHook<&hook_SetActorOpacity>("hook_SetActorOpacity");
+        registerHook<&hook_CalculateModelOpacity>("hook_CalculateModelOpacity");
+        registerHook<&hook_ModifyBoneMatrix>("hook_ModifyBoneMatrix");
+        registerHook<&hook_ChangeWeaponMtx>("hook_ChangeWeaponMtx");
 
         // First-Person Weapon Hooks
-        osLib_registerHLEFunction("coreinit", "hook_EquipWeapon", &hook_EquipWeapon);
-        osLib_registerHLEFunction("coreinit", "hook_DropEquipment", &hook_DropEquipment);
-        osLib_registerHLEFunction("coreinit", "hook_EnableWeaponAttackSensor", &hook_EnableWeaponAttackSensor);
-        osLib_registerHLEFunction("coreinit", "hook_SetPlayerWeaponScale", &hook_SetPlayerWeaponScale);
-        osLib_registerHLEFunction("coreinit", "hook_GetContactLayerOfAttack", &hook_GetContactLayerOfAttack);
+        registerHook<&hook_EquipWeapon>("hook_EquipWeapon");
+        registerHook<&hook_DropEquipment>("hook_DropEquipment");
+        registerHook<&hook_EnableWeaponAttackSensor>("hook_EnableWeaponAttackSensor");
+        registerHook<&hook_SetPlayerWeaponScale>("hook_SetPlayerWeaponScale");
+        registerHook<&hook_GetContactLayerOfAttack>("hook_GetContactLayerOfAttack");
 
         // Input Hooks
-        osLib_registerHLEFunction("coreinit", "hook_InjectXRInput", &hook_InjectXRInput);
-        osLib_registerHLEFunction("coreinit", "hook_XRRumble_VPADControlMotor", &hook_XRRumble_VPADControlMotor);
-        osLib_registerHLEFunction("coreinit", "hook_XRRumble_VPADStopMotor", &hook_XRRumble_VPADStopMotor);
+        registerHook<&hook_InjectXRInput>("hook_InjectXRInput");
+        registerHook<&hook_XRRumble_VPADControlMotor>("hook_XRRumble_VPADControlMotor");
+        registerHook<&hook_XRRumble_VPADStopMotor>("hook_XRRumble_VPADStopMotor");
 
         // Logging/Debugging Hooks
-        osLib_registerHLEFunction("coreinit", "hook_OSReportToConsole", &hook_OSReportToConsole);
-        osLib_registerHLEFunction("coreinit", "hook_DropWeaponLogging", &hook_DropWeaponLogging);
-        osLib_registerHLEFunction("coreinit", "hook_ModifyHandModelAccessSearch", &hook_ModifyHandModelAccessSearch);
-        osLib_registerHLEFunction("coreinit", "hook_CreateNewScreen", &hook_CreateNewScreen);
-        osLib_registerHLEFunction("coreinit", "hook_RouteActorJob", &hook_RouteActorJob);
+        registerHook<&hook_OSReportToConsole>("hook_OSReportToConsole");
+        registerHook<&hook_DropWeaponLogging>("hook_DropWeaponLogging");
+        registerHook<&hook_ModifyHandModelAccessSearch>("hook_ModifyHandModelAccessSearch");
+        registerHook<&hook_CreateNewScreen>("hook_CreateNewScreen");
+        registerHook<&hook_RouteActorJob>("hook_RouteActorJob");
     };
     ~CemuHooks() {
-        FreeLibrary(m_cemuHandle);
+        HookCapture::Flush();
     };
 
-    static data_VRSettingsIn GetSettings();
+    static const VRSettings& GetSettings();
     static uint64_t GetMemoryBaseAddress() { return s_memoryBaseAddress; }    
 
     std::unique_ptr<class EntityDebugger> m_entityDebugger;
@@ -96,13 +95,14 @@ public:
         return GetFramesSinceLastCameraUpdate() <= 4;
     }
 
-    static std::string s_currentEvent;
+    static constexpr uint32_t NO_EVENT = EventTable<HybridEventSettings>::NO_EVENT;
+    static uint32_t s_currentEvent;
     static HybridEventSettings s_currentEventSettings;
-    static std::unordered_map<std::string, HybridEventSettings> s_eventSettings;
+    static EventTable<HybridEventSettings> s_events;
     static void initCutsceneDefaultSettings(uint32_t ppc_TableOfCutsceneEventsSettingsOffset);
 
     static bool HasActiveCutscene() {
-        return !s_currentEvent.empty();
+        return s_currentEvent != NO_EVENT;
     }
 
     static EventMode GetEventModeWithOverride() {
@@ -116,7 +116,7 @@ public:
         // if the camera is controllable, treat it as no event
         // todo: Apparently this is a bad way to check it.
         if (IsInGame()) {
-            //Log::print<VERBOSE>("Camera is controllable during cutscene '{}' due to frames since last camera update being {}. Treating as no event.", s_currentEvent, GetFramesSinceLastCameraUpdate());
+            //Log::print<VERBOSE>("Camera is controllable during cutscene '{}' due to frames since last camera update being {}. Treating as no event.", s_events[s_currentEvent].name, GetFramesSinceLastCameraUpdate());
             //return EventMode::NO_EVENT;
         }
         return mode;
@@ -175,15 +175,34 @@ public:
     static void DrawDebugOverlays();
 
 private:
-    HMODULE m_cemuHandle;
-
-    osLib_registerHLEFunctionPtr_t osLib_registerHLEFunction;
-    memory_getBasePtr_t memory_getBase;
-    gameMeta_getTitleIdPtr_t gameMeta_getTitleId;
+    CemuExports m_cemu;
 
     static uint64_t s_memoryBaseAddress;
     static std::atomic_uint32_t s_framesSinceLastCameraUpdate;
 
+    // every hook is registered through a wrapper that records how long it took, and captures the call if that's enabled
+    template <auto Hook>
+    static inline Telemetry::CounterId s_hookCounter = 0;
+    template <auto Hook>
+    static inline const char* s_hookName = nullptr;
+
+    template <auto Hook>
+    static void instrumentedHook(PPCInterpreter_t* hCPU) {
+        Telemetry::ScopedTimer timer(s_hookCounter<Hook>);
+        if (HookCapture::IsEnabled()) [[unlikely]] {
+            HookCapture::RecordCall(s_hookName<Hook>, hCPU, Hook, s_memoryBaseAddress);
+            return;
+        }
+        Hook(hCPU);
+    }
+
+    template <auto Hook>
+    void registerHook(const char* name) {
+        s_hookCounter<Hook> = Telemetry::Register(name, Telemetry::Category::HLE_HOOK);
+        s_hookName<Hook> = name;
+        m_cemu.osLib_registerHLEFunction("coreinit", name, &instrumentedHook<Hook>);
+    }
+
     static void hook_UpdateSettings(PPCInterpreter_t* hCPU);
 
     // Actor Hooks
@@ -254,6 +273,11 @@ public:
         memcpy(resultPtr, (void*)memoryAddress, sizeof(T));
     }
 
+    template <typename T>
+    static GuestView<T> getView(uint32_t offset) {
+        return GuestView<T>(s_memoryBaseAddress, offset);
+    }
+
     template <typename T>
     static auto getMemory(uint64_t offset) {
         if constexpr (is_BEType_v<T>) {
@@ -114,11 +114,11 @@ void CemuHooks::hook_InjectXRInput(PPCInterpreter_t* hCPU) {
         readMemory(vpadStatusOffset, &vpadStatus);
     }
 
-    OpenXR::InputState inputs = VRManager::instance().XR->m_input.load();
-    inputs.inGame.drop_weapon[0] = inputs.inGame.drop_weapon[1] = false;
+    OpenXR::InputState inputs = VRManager::instance().XR->m_input.Load();
     // fetch game state
-    auto gameState = VRManager::instance().XR->m_gameState.load();
+    auto gameState = VRManager::instance().XR->m_gameState.Load();
     gameState.in_game = inputs.inGame.in_game;
+    gameState.drop_weapon[0] = gameState.drop_weapon[1] = false;
 
     // buttons
     static uint32_t oldCombinedHold = 0;
@@ -212,7 +212,7 @@ void CemuHooks::hook_InjectXRInput(PPCInterpreter_t* hCPU) {
                 // and the right weapon disappears. Equipping another sword make both the previous sword and actual appear in hand.
                 //if (leftJoystickDir == JoyDir::Down)
                 //{
-                //    inputs.inGame.drop_weapon[0] = true;
+                //    gameState.drop_weapon[0] = true;
                 //    gameState.prevent_grab_inputs = true;
                 //    gameState.drop_weapon_time = now;
                 //}
@@ -263,7 +263,7 @@ void CemuHooks::hook_InjectXRInput(PPCInterpreter_t* hCPU) {
                 //Drop
                 if (rightJoystickDir == JoyDir::Down)
                 {
-                    inputs.inGame.drop_weapon[1] = true;
+                    gameState.drop_weapon[1] = true;
                     gameState.prevent_grab_inputs = true;
                     gameState.prevent_grab_time = now;
                 }  
@@ -411,8 +411,7 @@ void CemuHooks::hook_InjectXRInput(PPCInterpreter_t* hCPU) {
 
     // set previous game states
     gameState.was_in_game = gameState.in_game;
-    VRManager::instance().XR->m_gameState.store(gameState);
-    VRManager::instance().XR->m_input.store(inputs);
+    VRManager::instance().XR->m_gameState.Store(gameState);
 }
 
 
@@ -431,7 +430,7 @@ void CemuHooks::hook_CreateNewActor(PPCInterpreter_t* hCPU) {
     // }
     hCPU->gpr[3] = 0;
 
-    // OpenXR::InputState inputs = VRManager::instance().XR->m_input.load();
+    // OpenXR::InputState inputs = VRManager::instance().XR->m_input.Load();
     // if (!inputs.inGame.in_game) {
     //     hCPU->gpr[3] = 0;
     //     return;
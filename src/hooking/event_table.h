@@ -0,0 +1,48 @@
+#pragma once
+#include "utils/string_hash.h"
+
+// Every event name is interned once, either when loading the graphic pack's table or the first time the game uses it.
+// The active event is then just an index, and looking up the game's event name only hashes it without allocating.
+template <typename Settings>
+class EventTable {
+public:
+    static constexpr uint32_t NO_EVENT = std::numeric_limits<uint32_t>::max();
+
+    struct Entry {
+        std::string name;
+        std::optional<Settings> settings; // not set for events that aren't in the graphic pack's table
+    };
+
+    uint32_t Find(std::string_view name) const {
+        const uint32_t hash = HashString(name);
+        auto [first, last] = std::ranges::equal_range(m_lookup, hash, {}, &std::pair<uint32_t, uint32_t>::first);
+        for (auto it = first; it != last; ++it) {
+            if (m_entries[it->second].name == name) {
+                return it->second;
+            }
+        }
+        return NO_EVENT;
+    }
+
+    uint32_t Intern(std::string_view name) {
+        if (uint32_t idx = Find(name); idx != NO_EVENT) {
+            return idx;
+        }
+
+        const uint32_t idx = (uint32_t)m_entries.size();
+        m_entries.emplace_back(Entry{ .name = std::string(name), .settings = std::nullopt });
+
+        const uint32_t hash = HashString(name);
+        auto pos = std::ranges::upper_bound(m_lookup, hash, {}, &std::pair<uint32_t, uint32_t>::first);
+        m_lookup.emplace(pos, hash, idx);
+        return idx;
+    }
+
+    Entry& operator[](uint32_t idx) { return m_entries[idx]; }
+    const Entry& operator[](uint32_t idx) const { return m_entries[idx]; }
+    size_t Size() const { return m_entries.size(); }
+
+private:
+    std::vector<Entry> m_entries;
+    std::vector<std::pair<uint32_t, uint32_t>> m_lookup; // name hash and index into m_entries, sorted by hash
+};
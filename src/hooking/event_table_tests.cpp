@@ -0,0 +1,71 @@
+#include "catch.h"
+#include "event_table.h"
+
+#include <unordered_map>
+
+namespace {
+    struct TestSettings {
+        bool firstPerson;
+    };
+
+    // finds two different names with the same hash, so both have to end up in the same equal_range of the lookup
+    std::pair<std::string, std::string> FindCollidingNames() {
+        std::unordered_map<uint32_t, std::string> seen;
+        for (uint32_t i = 0;; i++) {
+            std::string name = "Demo" + std::to_string(i);
+            auto [it, inserted] = seen.try_emplace(HashString(name), name);
+            if (!inserted) {
+                return { it->second, name };
+            }
+        }
+    }
+}
+
+TEST_CASE("EventTable interns each name once", "[event_table]") {
+    EventTable<TestSettings> events;
+    CHECK(events.Find("Demo008_0") == EventTable<TestSettings>::NO_EVENT);
+
+    const uint32_t opening = events.Intern("Demo008_0");
+    const uint32_t tower = events.Intern("Demo103_0");
+    CHECK(opening != tower);
+    CHECK(events.Intern("Demo008_0") == opening);
+    CHECK(events.Find("Demo103_0") == tower);
+    CHECK(events.Size() == 2);
+
+    CHECK(events[opening].name == "Demo008_0");
+    CHECK_FALSE(events[opening].settings.has_value());
+    events[tower].settings = TestSettings{ .firstPerson = true };
+    CHECK(events[events.Find("Demo103_0")].settings->firstPerson);
+
+    CHECK(events.Find("Demo008") == EventTable<TestSettings>::NO_EVENT);
+    CHECK(events.Find("") == EventTable<TestSettings>::NO_EVENT);
+}
+
+TEST_CASE("EventTable keeps names with colliding hashes apart", "[event_table]") {
+    const auto [first, second] = FindCollidingNames();
+    REQUIRE(first != second);
+    REQUIRE(HashString(first) == HashString(second));
+
+    EventTable<TestSettings> events;
+    events.Intern("Demo000_0");
+    const uint32_t firstIdx = events.Intern(first);
+    CHECK(events.Find(second) == EventTable<TestSettings>::NO_EVENT);
+
+    const uint32_t secondIdx = events.Intern(second);
+    CHECK(firstIdx != secondIdx);
+    CHECK(events.Find(first) == firstIdx);
+    CHECK(events.Find(second) == secondIdx);
+    CHECK(events[secondIdx].name == second);
+}
+
+TEST_CASE("EventTable finds every name after many inserts", "[event_table]") {
+    EventTable<TestSettings> events;
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < 2000; i++) {
+        names.push_back("Event" + std::to_string(i * 7919 % 2000));
+        REQUIRE(events.Intern(names.back()) == i);
+    }
+    for (uint32_t i = 0; i < names.size(); i++) {
+        CHECK(events.Find(names[i]) == i);
+    }
+}
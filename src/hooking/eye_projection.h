@@ -0,0 +1,67 @@
+#pragma once
+
+// Mirrors XrFovf, so that this header doesn't need OpenXR and the host build can test it
+struct EyeFov {
+    float angleLeft;
+    float angleRight;
+    float angleUp;
+    float angleDown;
+};
+
+// Everything about an eye's projection that only depends on its FOV.
+// The game asks for projections many times per eye per frame (main view, light pre-pass, shadows), while the FOV only changes when the XR views are updated.
+struct EyeProjection {
+    EyeFov fov;
+
+    float aspectRatio;
+    float fovY;
+    float fovYSin;
+    float fovYCos;
+    float fovYTan;
+    float offsetX;
+    float offsetY;
+
+    float tanLeft;
+    float tanRight;
+    float tanDown;
+    float tanUp;
+
+    static EyeProjection FromFov(const EyeFov& fov) {
+        EyeProjection proj = {};
+        proj.fov = fov;
+
+        float totalHorizontalFov = fov.angleRight - fov.angleLeft;
+        float totalVerticalFov = fov.angleUp - fov.angleDown;
+
+        proj.aspectRatio = totalHorizontalFov / totalVerticalFov;
+        proj.fovY = totalVerticalFov;
+        proj.offsetX = (fov.angleRight + fov.angleLeft) / 2.0f;
+        proj.offsetY = (fov.angleUp + fov.angleDown) / 2.0f;
+
+        float halfAngle = proj.fovY * 0.5f;
+        proj.fovYSin = sinf(halfAngle);
+        proj.fovYCos = cosf(halfAngle);
+        proj.fovYTan = tanf(halfAngle);
+
+        proj.tanLeft = tanf(fov.angleLeft);
+        proj.tanRight = tanf(fov.angleRight);
+        proj.tanDown = tanf(fov.angleDown);
+        proj.tanUp = tanf(fov.angleUp);
+        return proj;
+    }
+};
+
+// Keeps the last projection of each eye (0 = left, 1 = right) until that eye's FOV changes
+class EyeProjectionCache {
+public:
+    const EyeProjection& Get(uint32_t side, const EyeFov& fov) {
+        auto& cached = m_eyes[side];
+        if (cached && memcmp(&cached->fov, &fov, sizeof(EyeFov)) == 0) {
+            return cached.value();
+        }
+        return cached.emplace(EyeProjection::FromFov(fov));
+    }
+
+private:
+    std::array<std::optional<EyeProjection>, 2> m_eyes;
+};
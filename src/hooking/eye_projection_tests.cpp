@@ -0,0 +1,51 @@
+#include "catch.h"
+#include "eye_projection.h"
+
+namespace {
+    // roughly a Quest 3's left and right eye
+    constexpr EyeFov LEFT_FOV = { -0.942f, 0.698f, 0.768f, -0.890f };
+    constexpr EyeFov RIGHT_FOV = { -0.698f, 0.942f, 0.768f, -0.890f };
+}
+
+TEST_CASE("EyeProjection derives the game's projection values from an XR FOV", "[eye_projection]") {
+    const EyeProjection proj = EyeProjection::FromFov(LEFT_FOV);
+
+    CHECK(proj.fovY == Approx(0.768f + 0.890f));
+    CHECK(proj.aspectRatio == Approx((0.698f + 0.942f) / (0.768f + 0.890f)));
+    CHECK(proj.offsetX == Approx((0.698f - 0.942f) / 2.0f));
+    CHECK(proj.offsetY == Approx((0.768f - 0.890f) / 2.0f));
+    CHECK(proj.fovYTan == Approx(std::tan(proj.fovY / 2.0f)));
+    CHECK(proj.fovYSin * proj.fovYSin + proj.fovYCos * proj.fovYCos == Approx(1.0f));
+    CHECK(proj.tanLeft == Approx(std::tan(-0.942f)));
+    CHECK(proj.tanUp == Approx(std::tan(0.768f)));
+
+    // a symmetric FOV has no offset
+    const EyeProjection symmetric = EyeProjection::FromFov({ -0.8f, 0.8f, 0.7f, -0.7f });
+    CHECK(symmetric.offsetX == 0.0f);
+    CHECK(symmetric.offsetY == 0.0f);
+}
+
+TEST_CASE("EyeProjectionCache only recomputes an eye when its FOV changes", "[eye_projection]") {
+    EyeProjectionCache cache;
+
+    const EyeProjection& left = cache.Get(0, LEFT_FOV);
+    const EyeProjection& right = cache.Get(1, RIGHT_FOV);
+    CHECK(left.offsetX == -right.offsetX);
+
+    // the cached values are exactly what computing them again would give
+    const EyeProjection expected = EyeProjection::FromFov(LEFT_FOV);
+    const EyeProjection& again = cache.Get(0, LEFT_FOV);
+    CHECK(&again == &left);
+    CHECK(std::memcmp(&again, &expected, sizeof(EyeProjection)) == 0);
+
+    // a new FOV for one eye leaves the other one cached
+    EyeFov widerLeft = LEFT_FOV;
+    widerLeft.angleLeft -= 0.01f;
+    CHECK(cache.Get(0, widerLeft).fovY == expected.fovY);
+    CHECK(cache.Get(0, widerLeft).aspectRatio > expected.aspectRatio);
+    CHECK(cache.Get(0, widerLeft).fov.angleLeft == widerLeft.angleLeft);
+    CHECK(cache.Get(1, RIGHT_FOV).fov.angleLeft == RIGHT_FOV.angleLeft);
+
+    // switching back recomputes the original values
+    CHECK(std::memcmp(&cache.Get(0, LEFT_FOV), &expected, sizeof(EyeProjection)) == 0);
+}
@@ -1,47 +1,71 @@
 #include "framebuffer.h"
 #include "instance.h"
 #include "layer.h"
+#include "pending_copy_table.h"
+#include "utils/handle_registry.h"
+#include "utils/telemetry.h"
 #include "utils/vulkan_utils.h"
 
 
-std::mutex lockImageResolutions;
-std::unordered_map<VkImage, std::pair<VkExtent2D, VkFormat>> imageResolutions;
+// Metadata of every image that's big enough to be one of Cemu's render targets, looked up whenever a magic clear is found
+struct ImageInfo {
+    VkExtent2D extent;
+    VkFormat format;
+    VkImageUsageFlags usage;
+};
+static HandleRegistry<ImageInfo, 1024> s_images;
 
-std::mutex s_activeCopyMutex;
-std::vector<std::pair<VkCommandBuffer, SharedTexture*>> s_activeCopyOperations;
+struct SemaphoreInfo {
+    VkSemaphoreType type;
+};
+static HandleRegistry<SemaphoreInfo, 1024> s_semaphores;
 
-VkImage s_curr3DColorImage = VK_NULL_HANDLE;
-VkImage s_curr3DDepthImage = VK_NULL_HANDLE;
+using CopyTable = PendingCopyTable<VkCommandBuffer, SharedTexture>;
+static CopyTable s_pendingCopies;
+
+static void AddPendingCopy(VkCommandBuffer commandBuffer, SharedTexture* texture) {
+    if (!s_pendingCopies.Add(commandBuffer, texture)) {
+        Log::print<ERROR>("Too many pending copies, dropping copy for command buffer {}", (void*)commandBuffer);
+    }
+}
+
+std::atomic<VkImage> s_curr3DColorImage = VK_NULL_HANDLE;
+std::atomic<VkImage> s_curr3DDepthImage = VK_NULL_HANDLE;
 
 using namespace VRLayer;
 
 VkResult VkDeviceOverrides::CreateImage(const vkroots::VkDeviceDispatch* pDispatch, VkDevice device, const VkImageCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkImage* pImage) {
     VkResult res = pDispatch->CreateImage(device, pCreateInfo, pAllocator, pImage);
 
-    if (pCreateInfo->extent.width >= 1280 && pCreateInfo->extent.height >= 720) {
-        lockImageResolutions.lock();
+    if (res == VK_SUCCESS && pCreateInfo->extent.width >= 1280 && pCreateInfo->extent.height >= 720) {
         // Log::print("Added texture {}: {}x{} @ {}", (void*)*pImage, pCreateInfo->extent.width, pCreateInfo->extent.height, pCreateInfo->format);
-        checkAssert(imageResolutions.try_emplace(*pImage, std::make_pair(VkExtent2D{ pCreateInfo->extent.width, pCreateInfo->extent.height }, pCreateInfo->format)).second, "Couldn't insert image resolution into map!");
-        lockImageResolutions.unlock();
+        ImageInfo info = {
+            .extent = { pCreateInfo->extent.width, pCreateInfo->extent.height },
+            .format = pCreateInfo->format,
+            .usage = pCreateInfo->usage
+        };
+        checkAssert(s_images.Insert(*pImage, info), "Couldn't insert image into registry, it's full!");
     }
     return res;
 }
 
 void VkDeviceOverrides::DestroyImage(const vkroots::VkDeviceDispatch* pDispatch, VkDevice device, VkImage image, const VkAllocationCallbacks* pAllocator) {
-    lockImageResolutions.lock();
-    imageResolutions.erase(image);
-    if (s_curr3DColorImage == image) {
-        s_curr3DColorImage = VK_NULL_HANDLE;
-    }
-    else if (s_curr3DDepthImage == image) {
-        s_curr3DDepthImage = VK_NULL_HANDLE;
+    // forget the image before destroying it, since the driver can hand out the same handle again right afterwards
+    if (image != VK_NULL_HANDLE && s_images.Remove(image)) {
+        VkImage expected = image;
+        if (!s_curr3DColorImage.compare_exchange_strong(expected, VK_NULL_HANDLE)) {
+            expected = image;
+            s_curr3DDepthImage.compare_exchange_strong(expected, VK_NULL_HANDLE);
+        }
     }
-    lockImageResolutions.unlock();
 
     pDispatch->DestroyImage(device, image, pAllocator);
 }
 
 void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkDeviceDispatch* pDispatch, VkCommandBuffer commandBuffer, VkImage image, VkImageLayout imageLayout, const VkClearColorValue* pColor, uint32_t rangeCount, const VkImageSubresourceRange* pRanges) {
+    static const Telemetry::CounterId s_counter = Telemetry::Register("vkCmdClearColorImage", Telemetry::Category::VULKAN);
+    Telemetry::ScopedTimer timer(s_counter);
+
     // check whether the magic values are there, and which order they are in to determine which eye
     OpenXR::EyeSide side = (OpenXR::EyeSide)-1;
     if (pColor->float32[1] >= 0.12 && pColor->float32[1] <= 0.13 && pColor->float32[2] >= 0.97 && pColor->float32[2] <= 0.99) {
@@ -57,18 +81,22 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkDeviceDispatch* pDis
     }
 
     if (side != (OpenXR::EyeSide)-1) {
+        // All transitions around the copies are queued here and get flushed as one barrier right before each copy,
+        // with whatever is still pending being flushed when leaving this scope
+        VulkanUtils::BarrierBatch barriers(commandBuffer, pDispatch);
+
         // Track original layout so we can restore after copies
         const VkImageLayout originalLayout = imageLayout;
         bool transitionedToSrc = false;
         auto ensureSrcLayout = [&]() {
             if (!transitionedToSrc) {
-                VulkanUtils::TransitionLayout(commandBuffer, image, originalLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+                barriers.Transition(image, originalLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
                 transitionedToSrc = true;
             }
         };
         auto restoreLayout = [&]() {
             if (transitionedToSrc) {
-                VulkanUtils::TransitionLayout(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, originalLayout);
+                barriers.Transition(image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, originalLayout);
                 transitionedToSrc = false;
             }
         };
@@ -77,18 +105,18 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkDeviceDispatch* pDis
         auto ensureDstLayout = [&]() {
             if (transitionedToSrc) {
                 // Currently in TRANSFER_SRC, transition to TRANSFER_DST
-                VulkanUtils::TransitionLayout(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+                barriers.Transition(image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
                 transitionedToSrc = false;
                 transitionedToDst = true;
             } else if (!transitionedToDst) {
                 // Currently in original layout, transition to TRANSFER_DST
-                VulkanUtils::TransitionLayout(commandBuffer, image, originalLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+                barriers.Transition(image, originalLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
                 transitionedToDst = true;
             }
         };
         auto restoreFromDst = [&]() {
             if (transitionedToDst) {
-                VulkanUtils::TransitionLayout(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, originalLayout);
+                barriers.Transition(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, originalLayout);
                 transitionedToDst = false;
             }
         };
@@ -112,21 +140,19 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkDeviceDispatch* pDis
         // initialize the textures of both 2D and 3D layer if either is found since they share the same VkImage and resolution
         if (captureIdx == 0 || captureIdx == 2) {
             if (!layer2D) {
-                lockImageResolutions.lock();
-                if (const auto it = imageResolutions.find(image); it != imageResolutions.end()) {
-                    layer3D = std::make_unique<RND_Renderer::Layer3D>(it->second.first);
-                    layer2D = std::make_unique<RND_Renderer::Layer2D>(it->second.first);
+                if (const auto info = s_images.Find(image)) {
+                    layer3D = std::make_unique<RND_Renderer::Layer3D>(info->extent);
+                    layer2D = std::make_unique<RND_Renderer::Layer2D>(info->extent);
 
-                    // Log::print("Found rendering resolution {}x{} @ {} using capture #{}", it->second.first.width, it->second.first.height, it->second.second, captureIdx);
-                    imguiOverlay = std::make_unique<RND_Renderer::ImGuiOverlay>(commandBuffer, it->second.first.width, it->second.first.height, VK_FORMAT_A2B10G10R10_UNORM_PACK32);
+                    // Log::print("Found rendering resolution {}x{} @ {} using capture #{}", info->extent.width, info->extent.height, info->format, captureIdx);
+                    imguiOverlay = std::make_unique<RND_Renderer::ImGuiOverlay>(commandBuffer, info->extent.width, info->extent.height, VK_FORMAT_A2B10G10R10_UNORM_PACK32);
                     if (CemuHooks::GetSettings().ShowDebugOverlay()) {
                         VRManager::instance().Hooks->m_entityDebugger = std::make_unique<EntityDebugger>();
                     }
                 }
                 else {
-                    checkAssert(false, "Couldn't find image resolution in map!");
+                    checkAssert(false, "Couldn't find image resolution in registry!");
                 }
-                lockImageResolutions.unlock();
             }
         }
 
@@ -139,14 +165,10 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkDeviceDispatch* pDis
             // 3D layer - color texture for 3D rendering
 
             // check if the color texture has the appropriate texture format
-            if (s_curr3DColorImage == VK_NULL_HANDLE) {
-                lockImageResolutions.lock();
-                if (const auto it = imageResolutions.find(image); it != imageResolutions.end()) {
-                    if (it->second.second == VK_FORMAT_B10G11R11_UFLOAT_PACK32) {
-                        s_curr3DColorImage = it->first;
-                    }
+            if (s_curr3DColorImage.load() == VK_NULL_HANDLE) {
+                if (const auto info = s_images.Find(image); info && info->format == VK_FORMAT_B10G11R11_UFLOAT_PACK32) {
+                    s_curr3DColorImage = image;
                 }
-                lockImageResolutions.unlock();
             }
 
             // don't clear the image if we're in the faux 2D mode
@@ -154,8 +176,8 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkDeviceDispatch* pDis
                 return;
             }
 
-            if (image != s_curr3DColorImage) {
-                Log::print<RENDERING>("Color image is not the same as the current 3D color image! ({} != {})", (void*)image, (void*)s_curr3DColorImage);
+            if (image != s_curr3DColorImage.load()) {
+                Log::print<RENDERING>("Color image is not the same as the current 3D color image! ({} != {})", (void*)image, (void*)s_curr3DColorImage.load());
                 // AMD GPU FIX: Use local VkClearColorValue instead of const_cast to avoid UB
                 VkClearColorValue clearColor;
                 if (VRManager::instance().XR->GetRenderer()->IsRendering3D(frameIdx)) {
@@ -175,41 +197,32 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkDeviceDispatch* pDis
                 return pDispatch->CmdClearColorImage(commandBuffer, image, imageLayout, &clearColor, rangeCount, pRanges);
             }
 
-            // note: This uses vkCmdCopyImage to copy the image to an OpenXR-specific texture. s_activeCopyOperations queues a semaphore for the D3D12 side to wait on.
+            // note: This uses vkCmdCopyImage to copy the image to an OpenXR-specific texture. s_pendingCopies queues a semaphore for the D3D12 side to wait on.
             // AMD GPU FIX: ensureSrcLayout transitions to TRANSFER_SRC_OPTIMAL, then pass that layout so copy functions skip internal transitions
             ensureSrcLayout();
-            SharedTexture* texture = layer3D->CopyColorToLayer(side, commandBuffer, image, frameIdx, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+            SharedTexture* texture = layer3D->CopyColorToLayer(side, barriers, image, frameIdx, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
             renderer->On3DColorCopied(side, frameIdx);
             // Log::print("[VULKAN] Waiting for {} side to be 0", side == OpenXR::EyeSide::LEFT ? "left" : "right");
-            // AMD GPU FIX: Protect s_activeCopyOperations with mutex
-            {
-                std::lock_guard<std::mutex> lk(s_activeCopyMutex);
-                s_activeCopyOperations.emplace_back(commandBuffer, texture);
-            }
-            // AMD GPU FIX: Removed incorrect TransitionLayout(GENERAL, GENERAL) - CopyFromVkImage already handles layout transitions
-            // DebugPipelineBarrier provides memory synchronization without incorrect layout claims
-            VulkanUtils::DebugPipelineBarrier(commandBuffer);
+            AddPendingCopy(commandBuffer, texture);
 
             // imgui needs only one eye to render Cemu's 2D output, so use right side since it looks better
-            if (side == EyeSide::RIGHT) {
+            // with single-pass stereo the right eye never gets drawn by the game, so the left eye has to be used instead
+            if (side == EyeSide::RIGHT || CemuHooks::GetSettings().IsSinglePassStereoEnabled()) {
                 // note: Uses vkCmdCopyImage to copy the (right-eye-only) image to the imgui overlay's texture
                 // AMD GPU FIX: Image is already in TRANSFER_SRC_OPTIMAL from ensureSrcLayout
                 float aspectRatio = layer3D->GetAspectRatio(side);
-                imguiOverlay->Draw3DLayerAsBackground(commandBuffer, image, aspectRatio, frameIdx, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-
-                VulkanUtils::DebugPipelineBarrier(commandBuffer);
+                imguiOverlay->Draw3DLayerAsBackground(barriers, image, aspectRatio, frameIdx, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
             }
 
             // AMD GPU FIX: Restore layout BEFORE CmdClearColorImage
             // CmdClearColorImage requires GENERAL or TRANSFER_DST_OPTIMAL, not TRANSFER_SRC_OPTIMAL
             restoreLayout();
+            barriers.Flush();
 
             // clear the image to be transparent to allow for the HUD to be rendered on top of it which results in a transparent HUD layer
             // AMD GPU FIX: Use local VkClearColorValue instead of const_cast to avoid UB
             VkClearColorValue clearColor = {{ 0.0f, 0.0f, 0.0f, 0.0f }};
             pDispatch->CmdClearColorImage(commandBuffer, image, imageLayout, &clearColor, rangeCount, pRanges);
-
-            VulkanUtils::DebugPipelineBarrier(commandBuffer);
             return;
         }
         else if (captureIdx == 2) {
@@ -230,8 +243,7 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkDeviceDispatch* pDis
                     if (imguiOverlay && !hudCopied) {
                         // AMD GPU FIX: ensureSrcLayout transitions to TRANSFER_SRC_OPTIMAL
                         ensureSrcLayout();
-                        imguiOverlay->DrawHUDLayerAsBackground(commandBuffer, image, frameIdx, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-                        VulkanUtils::DebugPipelineBarrier(commandBuffer);
+                        imguiOverlay->DrawHUDLayerAsBackground(barriers, image, frameIdx, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
                     }
 
                     if (imguiOverlay && !hudCopied) {
@@ -241,29 +253,33 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkDeviceDispatch* pDis
                         imguiOverlay->Render();
                         // AMD GPU FIX: DrawAndCopyToImage copies TO the image, needs TRANSFER_DST_OPTIMAL
                         ensureDstLayout();
-                        imguiOverlay->DrawAndCopyToImage(commandBuffer, image, frameIdx);
-                        VulkanUtils::DebugPipelineBarrier(commandBuffer);
+                        imguiOverlay->DrawAndCopyToImage(barriers, image, frameIdx);
                     }
 
                     // copy the HUD texture to D3D12 to be presented
                     // only copy the first attempt at capturing when GX2ClearColor is called with this capture index since the game/Cemu clears the 2D layer twice
                     // AMD GPU FIX: Need to transition from DST back to SRC for copy operation
                     if (transitionedToDst) {
-                        VulkanUtils::TransitionLayout(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+                        barriers.Transition(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
                         transitionedToDst = false;
                         transitionedToSrc = true;
                     } else {
                         ensureSrcLayout();
                     }
-                    SharedTexture* texture = layer2D->CopyColorToLayer(commandBuffer, image, frameIdx, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-                    VulkanUtils::DebugPipelineBarrier(commandBuffer);
+                    SharedTexture* texture = layer2D->CopyColorToLayer(barriers, image, frameIdx, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
                     renderer->On2DCopied(frameIdx);
-                    // AMD GPU FIX: Protect s_activeCopyOperations with mutex
-                    {
-                        std::lock_guard<std::mutex> lk(s_activeCopyMutex);
-                        s_activeCopyOperations.emplace_back(commandBuffer, texture);
-                    }
+                    AddPendingCopy(commandBuffer, texture);
                     restoreLayout();
+
+                    // there's no right side pass with single-pass stereo, so render the flatscreen imgui overlay once the HUD has been copied
+                    if (imguiOverlay && CemuHooks::GetSettings().IsSinglePassStereoEnabled()) {
+                        imguiOverlay->BeginFrame(frameIdx, true);
+                        imguiOverlay->Update();
+                        imguiOverlay->Render();
+                        ensureDstLayout();
+                        imguiOverlay->DrawAndCopyToImage(barriers, image, frameIdx);
+                        restoreFromDst();
+                    }
                 }
             }
             if (side == OpenXR::EyeSide::RIGHT) {
@@ -275,8 +291,7 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkDeviceDispatch* pDis
                     imguiOverlay->Render();
                     // AMD GPU FIX: DrawAndCopyToImage copies TO the image, needs TRANSFER_DST_OPTIMAL
                     ensureDstLayout();
-                    imguiOverlay->DrawAndCopyToImage(commandBuffer, image, frameIdx);
-                    VulkanUtils::DebugPipelineBarrier(commandBuffer);
+                    imguiOverlay->DrawAndCopyToImage(barriers, image, frameIdx);
                     restoreFromDst();
                     return;
                 }
@@ -297,6 +312,9 @@ void VkDeviceOverrides::CmdClearColorImage(const vkroots::VkDeviceDispatch* pDis
 }
 
 void VkDeviceOverrides::CmdClearDepthStencilImage(const vkroots::VkDeviceDispatch* pDispatch, VkCommandBuffer commandBuffer, VkImage image, VkImageLayout imageLayout, const VkClearDepthStencilValue* pDepthStencil, uint32_t rangeCount, const VkImageSubresourceRange* pRanges) {
+    static const Telemetry::CounterId s_counter = Telemetry::Register("vkCmdClearDepthStencilImage", Telemetry::Category::VULKAN);
+    Telemetry::ScopedTimer timer(s_counter);
+
     // check for magical clear values
     // check order and whether there's a match with the magical clear value
     OpenXR::EyeSide side = (OpenXR::EyeSide)-1;
@@ -323,18 +341,14 @@ void VkDeviceOverrides::CmdClearDepthStencilImage(const vkroots::VkDeviceDispatc
 
         if (side == OpenXR::EyeSide::LEFT || side == OpenXR::EyeSide::RIGHT) {
             // 3D layer - depth texture for 3D rendering
-            if (s_curr3DDepthImage == VK_NULL_HANDLE) {
-                lockImageResolutions.lock();
-                if (const auto it = imageResolutions.find(image); it != imageResolutions.end()) {
-                    if (it->second.second == VK_FORMAT_D32_SFLOAT) {
-                        s_curr3DDepthImage = it->first;
-                    }
+            if (s_curr3DDepthImage.load() == VK_NULL_HANDLE) {
+                if (const auto info = s_images.Find(image); info && info->format == VK_FORMAT_D32_SFLOAT) {
+                    s_curr3DDepthImage = image;
                 }
-                lockImageResolutions.unlock();
             }
 
-            if (image != s_curr3DDepthImage) {
-                Log::print<RENDERING>("Depth image is not the same as the current 3D depth image! ({} != {})", (void*)image, (void*)s_curr3DDepthImage);
+            if (image != s_curr3DDepthImage.load()) {
+                Log::print<RENDERING>("Depth image is not the same as the current 3D depth image! ({} != {})", (void*)image, (void*)s_curr3DDepthImage.load());
                 return;
             }
 
@@ -353,16 +367,13 @@ void VkDeviceOverrides::CmdClearDepthStencilImage(const vkroots::VkDeviceDispatc
             // checkAssert(layer3D.GetStatus() == Status3D::LEFT_BINDING_COLOR || layer3D.GetStatus() == Status3D::RIGHT_BINDING_COLOR, "3D layer is not in the correct state for capturing depth images!");
 
             // AMD GPU FIX: Transition to TRANSFER_SRC_OPTIMAL before depth copy
-            VulkanUtils::TransitionLayout(commandBuffer, image, imageLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_ASPECT_DEPTH_BIT);
-            SharedTexture* texture = layer3D->CopyDepthToLayer(side, commandBuffer, image, frameCounter, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+            VulkanUtils::BarrierBatch barriers(commandBuffer, pDispatch);
+            barriers.Transition(image, imageLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_ASPECT_DEPTH_BIT);
+            SharedTexture* texture = layer3D->CopyDepthToLayer(side, barriers, image, frameCounter, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
             VRManager::instance().XR->GetRenderer()->On3DDepthCopied(side, frameCounter);
-            // AMD GPU FIX: Protect s_activeCopyOperations with mutex
-            {
-                std::lock_guard<std::mutex> lk(s_activeCopyMutex);
-                s_activeCopyOperations.emplace_back(commandBuffer, texture);
-            }
-            // Restore layout after depth copy
-            VulkanUtils::TransitionLayout(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, imageLayout, VK_IMAGE_ASPECT_DEPTH_BIT);
+            AddPendingCopy(commandBuffer, texture);
+            // Restore layout after depth copy, flushed together with the depth texture's own post-copy transition
+            barriers.Transition(image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, imageLayout, VK_IMAGE_ASPECT_DEPTH_BIT);
             return;
         }
     }
@@ -371,151 +382,422 @@ void VkDeviceOverrides::CmdClearDepthStencilImage(const vkroots::VkDeviceDispatc
     }
 }
 
-static std::unordered_set<VkSemaphore> s_isTimeline;
-
 VkResult VkDeviceOverrides::CreateSemaphore(const vkroots::VkDeviceDispatch* pDispatch, VkDevice device, const VkSemaphoreCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkSemaphore* pSemaphore) {
     VkResult res = pDispatch->CreateSemaphore(device, pCreateInfo, pAllocator, pSemaphore);
-    if (res == VK_SUCCESS && vkroots::FindInChain<VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO, const VkSemaphoreCreateInfo>(pCreateInfo->pNext)) {
-        s_isTimeline.emplace(*pSemaphore);
+    if (res != VK_SUCCESS) {
+        return res;
+    }
+
+    // binary semaphores are the default, so only the timeline ones need to be tracked
+    const auto* typeInfo = vkroots::FindInChain<VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO, const VkSemaphoreCreateInfo>(pCreateInfo->pNext);
+    if (typeInfo != nullptr && typeInfo->semaphoreType == VK_SEMAPHORE_TYPE_TIMELINE) {
+        if (!s_semaphores.Insert(*pSemaphore, SemaphoreInfo{ .type = VK_SEMAPHORE_TYPE_TIMELINE })) {
+            Log::print<WARNING>("Semaphore registry is full, timeline semaphore {} won't be tracked", (void*)*pSemaphore);
+        }
     }
     return res;
 }
 
 void VkDeviceOverrides::DestroySemaphore(const vkroots::VkDeviceDispatch* pDispatch, VkDevice device, VkSemaphore semaphore, const VkAllocationCallbacks* pAllocator) {
-    s_isTimeline.erase(semaphore);
+    if (semaphore != VK_NULL_HANDLE) {
+        s_semaphores.Remove(semaphore);
+    }
     return pDispatch->DestroySemaphore(device, semaphore, pAllocator);
 }
 
 inline bool IsTimeline(const VkSemaphore semaphore) {
-    auto it = s_isTimeline.find(semaphore);
-    return it != s_isTimeline.end();
+    const auto info = s_semaphores.Find(semaphore);
+    return info && info->type == VK_SEMAPHORE_TYPE_TIMELINE;
 }
 
-VkResult VkDeviceOverrides::QueueSubmit(const vkroots::VkDeviceDispatch* pDispatch, VkQueue queue, uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence fence) {
-    VkResult result = VK_SUCCESS;
-
-    // AMD GPU FIX: Build shadow copies of submit info to avoid mutating caller's data (UB).
-    // Also protect s_activeCopyOperations with mutex for thread safety.
-    struct ModifiedSubmitInfo_t {
-        VkSubmitInfo submitInfoCopy;  // Shadow copy of VkSubmitInfo
-        std::vector<VkSemaphore> waitSemaphores;
-        std::vector<uint64_t> timelineWaitValues;
-        std::vector<VkPipelineStageFlags> waitDstStageMasks;
-        std::vector<VkSemaphore> signalSemaphores;
-        std::vector<uint64_t> timelineSignalValues;
-
-        VkTimelineSemaphoreSubmitInfo timelineSemaphoreSubmitInfo = { VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+// The shared texture copies are the only thing in Cemu's command buffers that touch the interop textures.
+// So waiting for D3D12 only needs to block transfers, letting the rest of the submitted work start early.
+// Signalling still covers all commands, since the post-copy layout transition has to be finished before D3D12 can use the texture.
+static constexpr VkPipelineStageFlags2 INTEROP_WAIT_STAGE = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+static constexpr VkPipelineStageFlags2 INTEROP_SIGNAL_STAGE = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+// Per-thread scratch storage for the QueueSubmit overrides, its vectors keep their capacity so steady-state submits don't allocate
+struct SubmitScratch {
+    struct Patch {
+        uint32_t submitIdx;
+        size_t waitOffset;
+        uint32_t waitCount;
+        size_t signalOffset;
+        uint32_t signalCount;
     };
-    std::vector<ModifiedSubmitInfo_t> modifiedSubmitInfos;
-    std::vector<VkSubmitInfo> shadowSubmits;
-    size_t activeCopyCount = 0;
+    std::vector<Patch> patches;
+
+    // synchronization2 submits, which legacy submits also get translated into
+    std::vector<VkSubmitInfo2> submits2;
+    std::vector<VkSemaphoreSubmitInfo> waitInfos;
+    std::vector<VkSemaphoreSubmitInfo> signalInfos;
+    std::vector<VkCommandBufferSubmitInfo> commandBufferInfos;
+
+    // legacy submits, only used when synchronization2 isn't available
+    std::vector<VkSubmitInfo> submits;
+    std::vector<VkTimelineSemaphoreSubmitInfo> timelineInfos;
+    std::vector<VkSemaphore> waitSemaphores;
+    std::vector<uint64_t> waitValues;
+    std::vector<VkPipelineStageFlags> waitStages;
+    std::vector<VkSemaphore> signalSemaphores;
+    std::vector<uint64_t> signalValues;
+
+    void Clear() {
+        patches.clear();
+        submits2.clear();
+        waitInfos.clear();
+        signalInfos.clear();
+        commandBufferInfos.clear();
+        submits.clear();
+        timelineInfos.clear();
+        waitSemaphores.clear();
+        waitValues.clear();
+        waitStages.clear();
+        signalSemaphores.clear();
+        signalValues.clear();
+    }
+};
 
-    {
-        std::lock_guard<std::mutex> lk(s_activeCopyMutex);
-        activeCopyCount = s_activeCopyOperations.size();
+static const VkTimelineSemaphoreSubmitInfo* FindTimelineSubmitInfo(const void* pNext) {
+    for (auto* it = static_cast<const VkBaseInStructure*>(pNext); it != nullptr; it = it->pNext) {
+        if (it->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO) {
+            return reinterpret_cast<const VkTimelineSemaphoreSubmitInfo*>(it);
+        }
     }
+    return nullptr;
+}
 
-    if (activeCopyCount == 0) {
-        result = pDispatch->QueueSubmit(queue, submitCount, pSubmits, fence);
+// Legacy submits can only be translated if they don't chain anything that VkSubmitInfo2 doesn't support
+static bool CanTranslateToSubmit2(uint32_t submitCount, const VkSubmitInfo* pSubmits) {
+    for (uint32_t i = 0; i < submitCount; i++) {
+        for (auto* it = static_cast<const VkBaseInStructure*>(pSubmits[i].pNext); it != nullptr; it = it->pNext) {
+            if (it->sType != VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO) {
+                return false;
+            }
+        }
     }
-    else {
+    return true;
+}
 
-        // insert (possible) pipeline barriers for any active copy operations
-        modifiedSubmitInfos.resize(submitCount);
-        shadowSubmits.resize(submitCount);
+// Appends the wait and signal semaphores for the pending copies in the given entry
+static void AppendCopySemaphores(SubmitScratch& scratch, const CopyTable::Entry& copies) {
+    for (uint32_t k = 0; k < copies.count; k++) {
+        SharedTexture* texture = copies.textures[k];
+
+        // Wait for D3D12/XR to finish with the previous shared texture render
+        uint64_t waitValue = texture->GetVulkanWaitValue();
+        scratch.waitInfos.emplace_back(VkSemaphoreSubmitInfo{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+            .semaphore = texture->GetSemaphoreForWait(waitValue),
+            .value = waitValue,
+            .stageMask = INTEROP_WAIT_STAGE,
+        });
+
+        // Signal to D3D12/XR rendering that the shared texture can be rendered to VR headset
+        uint64_t signalValue = texture->GetVulkanSignalValue();
+        scratch.signalInfos.emplace_back(VkSemaphoreSubmitInfo{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+            .semaphore = texture->GetSemaphoreForSignal(signalValue),
+            .value = signalValue,
+            .stageMask = INTEROP_SIGNAL_STAGE,
+        });
+    }
+}
 
-        // AMD GPU FIX: Hold mutex for the duration of s_activeCopyOperations access
-        std::lock_guard<std::mutex> lk(s_activeCopyMutex);
+static VkResult SubmitWithPendingCopies2(PFN_vkQueueSubmit2 queueSubmit2, VkQueue queue, uint32_t submitCount, const VkSubmitInfo2* pSubmits, VkFence fence, SubmitScratch& scratch) {
+    // Gather the semaphores of the copies that were recorded into the submitted command buffers.
+    // The existing semaphores are copied first, followed by the ones for our copies.
+    CopyTable::Entry copies;
+    for (uint32_t i = 0; i < submitCount; i++) {
+        const VkSubmitInfo2& submitInfo = pSubmits[i];
+
+        SubmitScratch::Patch patch = { .submitIdx = i };
+        bool hasCopies = false;
+        for (uint32_t j = 0; j < submitInfo.commandBufferInfoCount; j++) {
+            if (!s_pendingCopies.Take(submitInfo.pCommandBufferInfos[j].commandBuffer, copies)) {
+                continue;
+            }
 
-        for (uint32_t i = 0; i < submitCount; i++) {
-            const VkSubmitInfo& submitInfo = pSubmits[i];
-            ModifiedSubmitInfo_t& modifiedSubmitInfo = modifiedSubmitInfos[i];
+            if (!hasCopies) {
+                hasCopies = true;
+                patch.waitOffset = scratch.waitInfos.size();
+                scratch.waitInfos.insert(scratch.waitInfos.end(), submitInfo.pWaitSemaphoreInfos, submitInfo.pWaitSemaphoreInfos + submitInfo.waitSemaphoreInfoCount);
+                patch.signalOffset = scratch.signalInfos.size();
+                scratch.signalInfos.insert(scratch.signalInfos.end(), submitInfo.pSignalSemaphoreInfos, submitInfo.pSignalSemaphoreInfos + submitInfo.signalSemaphoreInfoCount);
+            }
+            AppendCopySemaphores(scratch, copies);
+        }
 
-            // AMD GPU FIX: Create shadow copy of original VkSubmitInfo
-            modifiedSubmitInfo.submitInfoCopy = submitInfo;
+        if (hasCopies) {
+            patch.waitCount = (uint32_t)(scratch.waitInfos.size() - patch.waitOffset);
+            patch.signalCount = (uint32_t)(scratch.signalInfos.size() - patch.signalOffset);
+            scratch.patches.emplace_back(patch);
+        }
+    }
+
+    // None of the pending copies belonged to this submit
+    if (scratch.patches.empty()) {
+        return queueSubmit2(queue, submitCount, pSubmits, fence);
+    }
+
+    // AMD GPU FIX: Build shadow copies of submit info to avoid mutating caller's data (UB).
+    // The scratch vectors are done growing at this point, so pointers into them stay valid.
+    scratch.submits2.assign(pSubmits, pSubmits + submitCount);
+    for (const SubmitScratch::Patch& patch : scratch.patches) {
+        VkSubmitInfo2& submitInfo = scratch.submits2[patch.submitIdx];
+        submitInfo.waitSemaphoreInfoCount = patch.waitCount;
+        submitInfo.pWaitSemaphoreInfos = scratch.waitInfos.data() + patch.waitOffset;
+        submitInfo.signalSemaphoreInfoCount = patch.signalCount;
+        submitInfo.pSignalSemaphoreInfos = scratch.signalInfos.data() + patch.signalOffset;
+    }
+    return queueSubmit2(queue, submitCount, scratch.submits2.data(), fence);
+}
 
-            // copy old semaphores into new vectors
-            modifiedSubmitInfo.waitSemaphores.assign(submitInfo.pWaitSemaphores, submitInfo.pWaitSemaphores + submitInfo.waitSemaphoreCount);
-            modifiedSubmitInfo.waitDstStageMasks.assign(submitInfo.pWaitDstStageMask, submitInfo.pWaitDstStageMask + submitInfo.waitSemaphoreCount);
-            modifiedSubmitInfo.timelineWaitValues.resize(submitInfo.waitSemaphoreCount, 0);
+// Translates legacy submits into VkSubmitInfo2's so that they can share the synchronization2 path
+static VkResult TranslateAndSubmit2(PFN_vkQueueSubmit2 queueSubmit2, VkQueue queue, uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence fence, SubmitScratch& scratch) {
+    thread_local SubmitScratch translated;
+    translated.Clear();
+
+    // reserve everything up front so that the pointers stored in the translated submits stay valid
+    size_t waitCount = 0, signalCount = 0, commandBufferCount = 0;
+    for (uint32_t i = 0; i < submitCount; i++) {
+        waitCount += pSubmits[i].waitSemaphoreCount;
+        signalCount += pSubmits[i].signalSemaphoreCount;
+        commandBufferCount += pSubmits[i].commandBufferCount;
+    }
+    translated.waitInfos.reserve(waitCount);
+    translated.signalInfos.reserve(signalCount);
+    translated.commandBufferInfos.reserve(commandBufferCount);
+    translated.submits2.reserve(submitCount);
+
+    for (uint32_t i = 0; i < submitCount; i++) {
+        const VkSubmitInfo& submitInfo = pSubmits[i];
+        const VkTimelineSemaphoreSubmitInfo* timelineInfo = FindTimelineSubmitInfo(submitInfo.pNext);
+
+        VkSubmitInfo2& submitInfo2 = translated.submits2.emplace_back(VkSubmitInfo2{ VK_STRUCTURE_TYPE_SUBMIT_INFO_2 });
+        submitInfo2.waitSemaphoreInfoCount = submitInfo.waitSemaphoreCount;
+        submitInfo2.pWaitSemaphoreInfos = translated.waitInfos.data() + translated.waitInfos.size();
+        for (uint32_t j = 0; j < submitInfo.waitSemaphoreCount; j++) {
+            translated.waitInfos.emplace_back(VkSemaphoreSubmitInfo{
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .semaphore = submitInfo.pWaitSemaphores[j],
+                .value = timelineInfo && j < timelineInfo->waitSemaphoreValueCount ? timelineInfo->pWaitSemaphoreValues[j] : 0,
+                .stageMask = submitInfo.pWaitDstStageMask[j],
+            });
+        }
 
-            modifiedSubmitInfo.signalSemaphores.assign(submitInfo.pSignalSemaphores, submitInfo.pSignalSemaphores + submitInfo.signalSemaphoreCount);
-            modifiedSubmitInfo.timelineSignalValues.resize(submitInfo.signalSemaphoreCount, 0);
+        submitInfo2.commandBufferInfoCount = submitInfo.commandBufferCount;
+        submitInfo2.pCommandBufferInfos = translated.commandBufferInfos.data() + translated.commandBufferInfos.size();
+        for (uint32_t j = 0; j < submitInfo.commandBufferCount; j++) {
+            translated.commandBufferInfos.emplace_back(VkCommandBufferSubmitInfo{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+                .commandBuffer = submitInfo.pCommandBuffers[j],
+            });
+        }
 
-            // find timeline semaphore submit info if already present
-            const VkTimelineSemaphoreSubmitInfo* existingTimelineInfo = nullptr;
+        // legacy signal operations implicitly cover all commands
+        submitInfo2.signalSemaphoreInfoCount = submitInfo.signalSemaphoreCount;
+        submitInfo2.pSignalSemaphoreInfos = translated.signalInfos.data() + translated.signalInfos.size();
+        for (uint32_t j = 0; j < submitInfo.signalSemaphoreCount; j++) {
+            translated.signalInfos.emplace_back(VkSemaphoreSubmitInfo{
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .semaphore = submitInfo.pSignalSemaphores[j],
+                .value = timelineInfo && j < timelineInfo->signalSemaphoreValueCount ? timelineInfo->pSignalSemaphoreValues[j] : 0,
+                .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+            });
+        }
+    }
 
-            const VkBaseInStructure* pNextIt = static_cast<const VkBaseInStructure*>(submitInfo.pNext);
-            while (pNextIt) {
-                if (pNextIt->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO) {
-                    existingTimelineInfo = reinterpret_cast<const VkTimelineSemaphoreSubmitInfo*>(pNextIt);
-                    break;
-                }
-                pNextIt = pNextIt->pNext;
+    return SubmitWithPendingCopies2(queueSubmit2, queue, submitCount, translated.submits2.data(), fence, scratch);
+}
+
+// Fallback for devices without synchronization2, chains the timeline values into the legacy submits
+static VkResult SubmitWithPendingCopies(const vkroots::VkDeviceDispatch* pDispatch, VkQueue queue, uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence fence, SubmitScratch& scratch) {
+    CopyTable::Entry copies;
+    for (uint32_t i = 0; i < submitCount; i++) {
+        const VkSubmitInfo& submitInfo = pSubmits[i];
+
+        SubmitScratch::Patch patch = { .submitIdx = i };
+        bool hasCopies = false;
+        for (uint32_t j = 0; j < submitInfo.commandBufferCount; j++) {
+            if (!s_pendingCopies.Take(submitInfo.pCommandBuffers[j], copies)) {
+                continue;
             }
 
-            // copy any existing timeline values into new vectors
-            if (existingTimelineInfo) {
-                for (uint32_t j = 0; j < existingTimelineInfo->waitSemaphoreValueCount; j++) {
-                    modifiedSubmitInfo.timelineWaitValues[j] = existingTimelineInfo->pWaitSemaphoreValues[j];
+            if (!hasCopies) {
+                hasCopies = true;
+                const VkTimelineSemaphoreSubmitInfo* existingTimelineInfo = FindTimelineSubmitInfo(submitInfo.pNext);
+
+                patch.waitOffset = scratch.waitSemaphores.size();
+                for (uint32_t k = 0; k < submitInfo.waitSemaphoreCount; k++) {
+                    scratch.waitSemaphores.emplace_back(submitInfo.pWaitSemaphores[k]);
+                    scratch.waitStages.emplace_back(submitInfo.pWaitDstStageMask[k]);
+                    scratch.waitValues.emplace_back(existingTimelineInfo && k < existingTimelineInfo->waitSemaphoreValueCount ? existingTimelineInfo->pWaitSemaphoreValues[k] : 0);
                 }
-                for (uint32_t j = 0; j < existingTimelineInfo->signalSemaphoreValueCount; j++) {
-                    modifiedSubmitInfo.timelineSignalValues[j] = existingTimelineInfo->pSignalSemaphoreValues[j];
+                patch.signalOffset = scratch.signalSemaphores.size();
+                for (uint32_t k = 0; k < submitInfo.signalSemaphoreCount; k++) {
+                    scratch.signalSemaphores.emplace_back(submitInfo.pSignalSemaphores[k]);
+                    scratch.signalValues.emplace_back(existingTimelineInfo && k < existingTimelineInfo->signalSemaphoreValueCount ? existingTimelineInfo->pSignalSemaphoreValues[k] : 0);
                 }
             }
 
-            // Insert timeline semaphores for active copy operations
-            for (uint32_t j = 0; j < submitInfo.commandBufferCount; j++) {
-                for (auto it = s_activeCopyOperations.begin(); it != s_activeCopyOperations.end();) {
-                    if (submitInfo.pCommandBuffers[j] == it->first) {
-                        // Wait for D3D12/XR to finish with the previous shared texture render
-                        uint64_t waitValue = it->second->GetVulkanWaitValue();
-                        modifiedSubmitInfo.waitSemaphores.emplace_back(it->second->GetSemaphoreForWait(waitValue));
-                        modifiedSubmitInfo.waitDstStageMasks.emplace_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
-                        modifiedSubmitInfo.timelineWaitValues.emplace_back(waitValue);
-
-                        // Signal to D3D12/XR rendering that the shared texture can be rendered to VR headset
-                        uint64_t signalValue = it->second->GetVulkanSignalValue();
-                        modifiedSubmitInfo.signalSemaphores.emplace_back(it->second->GetSemaphoreForSignal(signalValue));
-                        modifiedSubmitInfo.timelineSignalValues.emplace_back(signalValue);
-                        it = s_activeCopyOperations.erase(it);
-                    }
-                    else {
-                        ++it;
-                    }
-                }
+            // reuse the synchronization2 semaphore builder and unpack it into the legacy arrays
+            scratch.waitInfos.clear();
+            scratch.signalInfos.clear();
+            AppendCopySemaphores(scratch, copies);
+            for (const VkSemaphoreSubmitInfo& waitInfo : scratch.waitInfos) {
+                scratch.waitSemaphores.emplace_back(waitInfo.semaphore);
+                scratch.waitStages.emplace_back((VkPipelineStageFlags)waitInfo.stageMask);
+                scratch.waitValues.emplace_back(waitInfo.value);
+            }
+            for (const VkSemaphoreSubmitInfo& signalInfo : scratch.signalInfos) {
+                scratch.signalSemaphores.emplace_back(signalInfo.semaphore);
+                scratch.signalValues.emplace_back(signalInfo.value);
             }
+        }
 
-            // Update timeline semaphore submit info
-            modifiedSubmitInfo.timelineSemaphoreSubmitInfo.waitSemaphoreValueCount = (uint32_t)modifiedSubmitInfo.timelineWaitValues.size();
-            modifiedSubmitInfo.timelineSemaphoreSubmitInfo.pWaitSemaphoreValues = modifiedSubmitInfo.timelineWaitValues.data();
-            modifiedSubmitInfo.timelineSemaphoreSubmitInfo.signalSemaphoreValueCount = (uint32_t)modifiedSubmitInfo.timelineSignalValues.size();
-            modifiedSubmitInfo.timelineSemaphoreSubmitInfo.pSignalSemaphoreValues = modifiedSubmitInfo.timelineSignalValues.data();
+        if (hasCopies) {
+            patch.waitCount = (uint32_t)(scratch.waitSemaphores.size() - patch.waitOffset);
+            patch.signalCount = (uint32_t)(scratch.signalSemaphores.size() - patch.signalOffset);
+            scratch.patches.emplace_back(patch);
+        }
+    }
+
+    // None of the pending copies belonged to this submit
+    if (scratch.patches.empty()) {
+        return pDispatch->QueueSubmit(queue, submitCount, pSubmits, fence);
+    }
+
+    // AMD GPU FIX: Build shadow copies of submit info to avoid mutating caller's data (UB).
+    // The scratch vectors are done growing at this point, so pointers into them stay valid.
+    scratch.submits.assign(pSubmits, pSubmits + submitCount);
+    scratch.timelineInfos.resize(scratch.patches.size());
+    for (size_t i = 0; i < scratch.patches.size(); i++) {
+        const SubmitScratch::Patch& patch = scratch.patches[i];
+        VkSubmitInfo& submitInfo = scratch.submits[patch.submitIdx];
+
+        VkTimelineSemaphoreSubmitInfo& timelineInfo = scratch.timelineInfos[i];
+        timelineInfo = { VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+        timelineInfo.waitSemaphoreValueCount = patch.waitCount;
+        timelineInfo.pWaitSemaphoreValues = scratch.waitValues.data() + patch.waitOffset;
+        timelineInfo.signalSemaphoreValueCount = patch.signalCount;
+        timelineInfo.pSignalSemaphoreValues = scratch.signalValues.data() + patch.signalOffset;
+        // AMD GPU FIX: Preserve existing pNext chain - prepend our timeline struct
+        timelineInfo.pNext = submitInfo.pNext;
+
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.waitSemaphoreCount = patch.waitCount;
+        submitInfo.pWaitSemaphores = scratch.waitSemaphores.data() + patch.waitOffset;
+        submitInfo.pWaitDstStageMask = scratch.waitStages.data() + patch.waitOffset;
+        submitInfo.signalSemaphoreCount = patch.signalCount;
+        submitInfo.pSignalSemaphores = scratch.signalSemaphores.data() + patch.signalOffset;
+    }
+    return pDispatch->QueueSubmit(queue, submitCount, scratch.submits.data(), fence);
+}
+
+// Checks the submitted command buffers for our copies without taking them, most of Cemu's submits don't contain any
+static bool HasPendingCopies(uint32_t submitCount, const VkSubmitInfo* pSubmits) {
+    for (uint32_t i = 0; i < submitCount; i++) {
+        if (s_pendingCopies.ContainsAny({ pSubmits[i].pCommandBuffers, pSubmits[i].commandBufferCount })) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool HasPendingCopies(uint32_t submitCount, const VkSubmitInfo2* pSubmits) {
+    for (uint32_t i = 0; i < submitCount; i++) {
+        for (uint32_t j = 0; j < pSubmits[i].commandBufferInfoCount; j++) {
+            if (s_pendingCopies.ContainsAny({ &pSubmits[i].pCommandBufferInfos[j].commandBuffer, 1 })) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Prefer the KHR entry point since the extension is what gets enabled on pre-1.3 devices
+static PFN_vkQueueSubmit2 GetNextQueueSubmit2(const vkroots::VkDeviceDispatch* pDispatch) {
+    if (!VRManager::instance().vkSynchronization2) {
+        return nullptr;
+    }
+    return pDispatch->QueueSubmit2KHR ? pDispatch->QueueSubmit2KHR : pDispatch->QueueSubmit2;
+}
+
+VkResult VkDeviceOverrides::QueueSubmit(const vkroots::VkDeviceDispatch* pDispatch, VkQueue queue, uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence fence) {
+    static const Telemetry::CounterId s_counter = Telemetry::Register("vkQueueSubmit", Telemetry::Category::VULKAN);
+    Telemetry::ScopedTimer timer(s_counter);
 
-            // AMD GPU FIX: Preserve existing pNext chain - prepend our timeline struct
-            modifiedSubmitInfo.timelineSemaphoreSubmitInfo.pNext = submitInfo.pNext;
+    VkResult result = VK_SUCCESS;
 
-            // AMD GPU FIX: Update our shadow VkSubmitInfo copy, not the caller's
-            modifiedSubmitInfo.submitInfoCopy.pNext = &modifiedSubmitInfo.timelineSemaphoreSubmitInfo;
-            modifiedSubmitInfo.submitInfoCopy.waitSemaphoreCount = (uint32_t)modifiedSubmitInfo.waitSemaphores.size();
-            modifiedSubmitInfo.submitInfoCopy.pWaitSemaphores = modifiedSubmitInfo.waitSemaphores.data();
-            modifiedSubmitInfo.submitInfoCopy.pWaitDstStageMask = modifiedSubmitInfo.waitDstStageMasks.data();
-            modifiedSubmitInfo.submitInfoCopy.signalSemaphoreCount = (uint32_t)modifiedSubmitInfo.signalSemaphores.size();
-            modifiedSubmitInfo.submitInfoCopy.pSignalSemaphores = modifiedSubmitInfo.signalSemaphores.data();
+    // Submits without any of our copies are passed through untouched, only the ones with copies get translated or patched
+    if (!HasPendingCopies(submitCount, pSubmits)) {
+        result = pDispatch->QueueSubmit(queue, submitCount, pSubmits, fence);
+    }
+    else {
+        thread_local SubmitScratch scratch;
+        scratch.Clear();
 
-            shadowSubmits[i] = modifiedSubmitInfo.submitInfoCopy;
+        if (PFN_vkQueueSubmit2 queueSubmit2 = GetNextQueueSubmit2(pDispatch); queueSubmit2 && CanTranslateToSubmit2(submitCount, pSubmits)) {
+            result = TranslateAndSubmit2(queueSubmit2, queue, submitCount, pSubmits, fence, scratch);
+        }
+        else {
+            result = SubmitWithPendingCopies(pDispatch, queue, submitCount, pSubmits, fence, scratch);
         }
-        result = pDispatch->QueueSubmit(queue, submitCount, shadowSubmits.data(), fence);
     }
 
     if (result != VK_SUCCESS) {
         Log::print<ERROR>("QueueSubmit failed with error {}", result);
     }
+    return result;
+}
+
+VkResult VkDeviceOverrides::QueueSubmit2(const vkroots::VkDeviceDispatch* pDispatch, VkQueue queue, uint32_t submitCount, const VkSubmitInfo2* pSubmits, VkFence fence) {
+    static const Telemetry::CounterId s_counter = Telemetry::Register("vkQueueSubmit2", Telemetry::Category::VULKAN);
+    Telemetry::ScopedTimer timer(s_counter);
 
+    VkResult result = VK_SUCCESS;
+
+    if (!HasPendingCopies(submitCount, pSubmits)) {
+        result = pDispatch->QueueSubmit2(queue, submitCount, pSubmits, fence);
+    }
+    else {
+        thread_local SubmitScratch scratch;
+        scratch.Clear();
+        result = SubmitWithPendingCopies2(pDispatch->QueueSubmit2, queue, submitCount, pSubmits, fence, scratch);
+    }
+
+    if (result != VK_SUCCESS) {
+        Log::print<ERROR>("QueueSubmit2 failed with error {}", result);
+    }
+    return result;
+}
+
+VkResult VkDeviceOverrides::QueueSubmit2KHR(const vkroots::VkDeviceDispatch* pDispatch, VkQueue queue, uint32_t submitCount, const VkSubmitInfo2* pSubmits, VkFence fence) {
+    static const Telemetry::CounterId s_counter = Telemetry::Register("vkQueueSubmit2KHR", Telemetry::Category::VULKAN);
+    Telemetry::ScopedTimer timer(s_counter);
+
+    VkResult result = VK_SUCCESS;
+
+    if (!HasPendingCopies(submitCount, pSubmits)) {
+        result = pDispatch->QueueSubmit2KHR(queue, submitCount, pSubmits, fence);
+    }
+    else {
+        thread_local SubmitScratch scratch;
+        scratch.Clear();
+        result = SubmitWithPendingCopies2(pDispatch->QueueSubmit2KHR, queue, submitCount, pSubmits, fence, scratch);
+    }
+
+    if (result != VK_SUCCESS) {
+        Log::print<ERROR>("QueueSubmit2KHR failed with error {}", result);
+    }
     return result;
 }
 
 VkResult VkDeviceOverrides::QueuePresentKHR(const vkroots::VkDeviceDispatch* pDispatch, VkQueue queue, const VkPresentInfoKHR* pPresentInfo) {
+    static const Telemetry::CounterId s_counter = Telemetry::Register("vkQueuePresentKHR", Telemetry::Category::VULKAN);
+    Telemetry::ScopedTimer timer(s_counter);
+
     VRManager::instance().XR->ProcessEvents();
 
     return pDispatch->QueuePresentKHR(queue, pPresentInfo);
@@ -0,0 +1,35 @@
+#pragma once
+
+// Typed view of a game struct that lives in the emulated Wii U's memory.
+// Fields are accessed in place through the struct's layout, so reading or writing a field only touches that field's bytes
+// instead of copying the whole struct out and back in. Since all game structs use BEType fields, byte-swapping only happens
+// when a field is actually read or assigned, and fields the game updates in the meantime don't get overwritten with stale data.
+template <typename T>
+class GuestView {
+public:
+    GuestView(uint64_t memoryBase, uint32_t address): m_memoryBase(memoryBase), m_address(address) {}
+
+    uint32_t GetAddress() const { return m_address; }
+    bool IsNull() const { return m_address == 0; }
+
+    T* Get() const { return reinterpret_cast<T*>(m_memoryBase + m_address); }
+    T* operator->() const { return Get(); }
+    T& operator*() const { return *Get(); }
+
+    // for fields that aren't described by the struct (yet), fields that don't fit into the struct don't compile
+    template <typename F, size_t Offset> requires (Offset + sizeof(F) <= sizeof(T))
+    F& Field() const {
+        return *reinterpret_cast<F*>(m_memoryBase + m_address + Offset);
+    }
+
+    // copies the whole struct, only use this when most fields are needed
+    T Read() const {
+        T result;
+        memcpy(&result, Get(), sizeof(T));
+        return result;
+    }
+
+private:
+    uint64_t m_memoryBase;
+    uint32_t m_address;
+};
@@ -0,0 +1,103 @@
+#include "catch.h"
+#include "guest_memory.h"
+
+namespace {
+    // laid out like the game's structs, with a gap for fields that aren't known yet
+    struct TestActor {
+        BEType<uint32_t> flags;
+        BEType<float> health;
+        uint8_t unknown[0x8];
+        BEType<uint16_t> weaponSlot;
+        BEType<uint16_t> shieldSlot;
+    };
+    static_assert(sizeof(TestActor) == 0x14);
+
+    constexpr uint32_t ACTOR_ADDRESS = 0x40;
+    constexpr uint8_t UNTOUCHED = 0xCD;
+
+    // a synthetic guest memory image with an actor in the middle of it, everything else gets filled with UNTOUCHED
+    struct GuestImage {
+        std::array<uint8_t, 0x100> memory;
+
+        GuestImage() {
+            memory.fill(UNTOUCHED);
+            const uint8_t actor[sizeof(TestActor)] = {
+                0x12, 0x34, 0x56, 0x78,
+                0x42, 0xC8, 0x00, 0x00,
+                UNTOUCHED, UNTOUCHED, UNTOUCHED, UNTOUCHED, 0xAA, 0xBB, 0xCC, 0xDD,
+                0x00, 0x03,
+                0x00, 0x07,
+            };
+            std::memcpy(memory.data() + ACTOR_ADDRESS, actor, sizeof(actor));
+        }
+
+        GuestView<TestActor> Actor() { return GuestView<TestActor>((uint64_t)memory.data(), ACTOR_ADDRESS); }
+
+        // bytes that differ from a freshly created image
+        std::vector<size_t> ChangedBytes() const {
+            const GuestImage original;
+            std::vector<size_t> changed;
+            for (size_t i = 0; i < memory.size(); i++) {
+                if (memory[i] != original.memory[i]) {
+                    changed.push_back(i);
+                }
+            }
+            return changed;
+        }
+    };
+
+    template <typename F, size_t Offset>
+    constexpr bool HasField = requires(GuestView<TestActor> view) { view.template Field<F, Offset>(); };
+}
+
+TEST_CASE("GuestView reads fields in place at their offsets", "[guest_memory]") {
+    GuestImage image;
+    GuestView<TestActor> actor = image.Actor();
+
+    CHECK(actor.GetAddress() == ACTOR_ADDRESS);
+    CHECK_FALSE(actor.IsNull());
+    CHECK((uint64_t)actor.Get() == (uint64_t)image.memory.data() + ACTOR_ADDRESS);
+
+    CHECK(actor->flags.getLE() == 0x12345678u);
+    CHECK(actor->health.getLE() == 100.0f);
+    CHECK(actor->weaponSlot.getLE() == 3);
+    CHECK((*actor).shieldSlot.getLE() == 7);
+    CHECK((actor.Field<BEType<uint32_t>, 0xC>().getLE()) == 0xAABBCCDDu);
+
+    const TestActor copy = actor.Read();
+    CHECK(copy.flags.getLE() == 0x12345678u);
+    CHECK(copy.shieldSlot.getLE() == 7);
+    CHECK(GuestView<TestActor>(0, 0).IsNull());
+}
+
+TEST_CASE("GuestView writes only touch the written field", "[guest_memory]") {
+    GuestImage image;
+    GuestView<TestActor> actor = image.Actor();
+
+    SECTION("through the struct") {
+        actor->health = 12.5f;
+        CHECK(image.memory[ACTOR_ADDRESS + 4] == 0x41);
+        CHECK(image.memory[ACTOR_ADDRESS + 5] == 0x48);
+        CHECK(image.ChangedBytes() == std::vector<size_t>{ ACTOR_ADDRESS + 4, ACTOR_ADDRESS + 5 });
+
+        actor->shieldSlot = (uint16_t)0x0102;
+        CHECK(image.memory[ACTOR_ADDRESS + 0x12] == 0x01);
+        CHECK(image.memory[ACTOR_ADDRESS + 0x13] == 0x02);
+        CHECK(actor->weaponSlot.getLE() == 3);
+    }
+
+    SECTION("through a field that isn't part of the struct") {
+        actor.Field<BEType<uint16_t>, 0x8>() = (uint16_t)0xBEEF;
+        CHECK(image.ChangedBytes() == std::vector<size_t>{ ACTOR_ADDRESS + 8, ACTOR_ADDRESS + 9 });
+        CHECK(image.memory[ACTOR_ADDRESS + 8] == 0xBE);
+        CHECK(image.memory[ACTOR_ADDRESS + 9] == 0xEF);
+    }
+}
+
+TEST_CASE("GuestView only allows fields inside the struct", "[guest_memory]") {
+    STATIC_REQUIRE(HasField<BEType<uint32_t>, 0>);
+    STATIC_REQUIRE(HasField<BEType<uint32_t>, sizeof(TestActor) - 4>);
+    STATIC_REQUIRE(HasField<uint8_t, sizeof(TestActor) - 1>);
+    STATIC_REQUIRE_FALSE(HasField<BEType<uint32_t>, sizeof(TestActor) - 3>);
+    STATIC_REQUIRE_FALSE(HasField<uint8_t, sizeof(TestActor)>);
+}
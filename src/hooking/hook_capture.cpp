@@ -0,0 +1,199 @@
+#include "hook_capture.h"
+
+static bool IsCaptureRequested() {
+    if (const char* value = std::getenv("BETTERVR_CAPTURE_HOOKS")) {
+        return value[0] != '\0' && value[0] != '0';
+    }
+    return false;
+}
+
+const bool HookCapture::s_enabled = IsCaptureRequested();
+std::mutex HookCapture::s_mutex;
+std::ofstream HookCapture::s_file;
+std::vector<uint8_t> HookCapture::s_buffer;
+size_t HookCapture::s_bytesWritten = 0;
+uint64_t HookCapture::s_sequence = 0;
+
+// registers hold plenty of values that aren't pointers, so only copy pages that are actually backed by memory
+static bool IsCommitted(const void* address) {
+    MEMORY_BASIC_INFORMATION info;
+    if (VirtualQuery(address, &info, sizeof(info)) == 0) {
+        return false;
+    }
+    return info.State == MEM_COMMIT && (info.Protect & (PAGE_NOACCESS | PAGE_GUARD)) == 0;
+}
+
+// same limit as GuestStringView
+static constexpr uint32_t GUEST_STRING_SIZE = 0x100;
+static constexpr uint32_t ACTOR_NAME_PTR_OFFSET = offsetof(ActorWiiU, name) + offsetof(sead::FixedSafeString40, c_str);
+
+static const HookCapture::ArgumentLayout s_argumentLayouts[] = {
+    { "hook_UpdateSettings", 5, sizeof(data_VRSettingsIn) },
+    // newline-separated table that ends with an empty line, this covers the graphic pack's table with room to spare
+    { "hook_UpdateSettings", 6, 0x2000 },
+    { "hook_UpdateActorList", 6, sizeof(ActorWiiU), ACTOR_NAME_PTR_OFFSET, GUEST_STRING_SIZE },
+    { "hook_UpdateCameraForGameplay", 31, sizeof(ActCamera) },
+    { "hook_GetRenderCamera", 3, sizeof(BESeadLookAtCamera) },
+    { "hook_GetRenderCamera", 12, sizeof(BESeadLookAtCamera) },
+    { "hook_GetRenderProjection", 3, sizeof(BESeadPerspectiveProjection) },
+    { "hook_GetRenderProjection", 12, sizeof(BESeadPerspectiveProjection) },
+    { "hook_ModifyLightPrePassProjectionMatrix", 3, sizeof(BESeadPerspectiveProjection) },
+    { "hook_GetEventName", 4, GUEST_STRING_SIZE },
+    { "hook_OverwriteCameraParam", 4, sizeof(float) },
+    { "hook_OverwriteCameraParam", 5, sizeof(uint32_t), 0, GUEST_STRING_SIZE },
+    { "hook_SetActorOpacity", 3, sizeof(ActorWiiU) },
+    { "hook_ModifyBoneMatrix", 3, 0x128 + sizeof(sead::FixedSafeString100) },
+    { "hook_ModifyBoneMatrix", 4, sizeof(BEMatrix34) },
+    { "hook_ModifyBoneMatrix", 5, sizeof(BEVec3) },
+    { "hook_ModifyBoneMatrix", 6, GUEST_STRING_SIZE },
+    { "hook_ChangeWeaponMtx", 3, sizeof(ActorWiiU) },
+    { "hook_ChangeWeaponMtx", 4, GUEST_STRING_SIZE },
+    { "hook_ChangeWeaponMtx", 5, sizeof(BEMatrix34) },
+    { "hook_ChangeWeaponMtx", 6, sizeof(BEMatrix34) },
+    { "hook_ChangeWeaponMtx", 7, sizeof(BEMatrix34) },
+    { "hook_ChangeWeaponMtx", 8, sizeof(Weapon) },
+    { "hook_ChangeWeaponMtx", 10, sizeof(BESeadLookAtCamera) },
+    { "hook_GetContactLayerOfAttack", 5, sizeof(uint32_t), 0, GUEST_STRING_SIZE },
+    { "hook_GetContactLayerOfAttack", 25, sizeof(ActorWiiU) },
+    { "hook_InjectXRInput", 4, 0xAC }, // VPADStatus
+    { "hook_XRRumble_VPADControlMotor", 4, 0x100 }, // the pattern's length is a byte
+    { "hook_OSReportToConsole", 3, GUEST_STRING_SIZE },
+    { "hook_DropWeaponLogging", 3, sizeof(PlayerOrEnemy), ACTOR_NAME_PTR_OFFSET, GUEST_STRING_SIZE },
+    { "hook_DropWeaponLogging", 5, sizeof(BEVec3) },
+    { "hook_ModifyHandModelAccessSearch", 3, GUEST_STRING_SIZE },
+    { "hook_CreateNewScreen", 7, GUEST_STRING_SIZE },
+    { "hook_RouteActorJob", 3, sizeof(ActorWiiU) },
+    { "hook_RouteActorJob", 4, GUEST_STRING_SIZE },
+};
+
+// copies every committed page of [address, address + size) that wasn't copied yet
+static void CapturePages(std::vector<HookCapture::Page>& pages, uint64_t memoryBase, uint32_t address, uint32_t size) {
+    constexpr uint32_t pageSize = HookCapture::GUEST_PAGE_SIZE;
+    const uint64_t end = (uint64_t)address + std::max(size, 1u);
+    for (uint64_t pageAddress = address & ~(pageSize - 1); pageAddress < end; pageAddress += pageSize) {
+        if (pageAddress < pageSize || pages.size() >= HookCapture::MAX_PAGES_PER_CALL) {
+            continue;
+        }
+        if (std::ranges::find(pages, (uint32_t)pageAddress, &HookCapture::Page::address) != pages.end()) {
+            continue;
+        }
+
+        const void* hostAddress = reinterpret_cast<const void*>(memoryBase + pageAddress);
+        if (!IsCommitted(hostAddress)) {
+            continue;
+        }
+        HookCapture::Page& page = pages.emplace_back();
+        page.address = (uint32_t)pageAddress;
+        std::memcpy(page.data, hostAddress, pageSize);
+    }
+}
+
+void HookCapture::RecordCall(const char* name, PPCInterpreter_t* hCPU, void (*hook)(PPCInterpreter_t*), uint64_t memoryBase) {
+    // the pages have to be copied before the hook runs since most hooks write back into them
+    thread_local std::vector<Page> s_pages;
+    thread_local std::vector<Page> s_exitPages;
+    thread_local std::vector<FollowedPointer> s_pointers;
+    s_pages.clear();
+    s_exitPages.clear();
+    s_pointers.clear();
+
+    std::array<bool, std::extent_v<decltype(PPCInterpreter_t::gpr)>> hasLayout = {};
+    for (const ArgumentLayout& layout : s_argumentLayouts) {
+        if (std::strcmp(layout.hookName, name) != 0) {
+            continue;
+        }
+        hasLayout[layout.reg] = true;
+
+        const uint32_t address = hCPU->gpr[layout.reg];
+        if (address == 0) {
+            continue;
+        }
+        s_pointers.push_back({ layout.reg, address, layout.size });
+        CapturePages(s_pages, memoryBase, address, layout.size);
+
+        if (layout.pointeeOffset == NO_POINTEE) {
+            continue;
+        }
+        const uint32_t pointerAddress = address + layout.pointeeOffset;
+        const void* hostPointer = reinterpret_cast<const void*>(memoryBase + pointerAddress);
+        if (!IsCommitted(hostPointer)) {
+            continue;
+        }
+        BEType<uint32_t> pointee;
+        std::memcpy(&pointee, hostPointer, sizeof(pointee));
+        if (pointee.getLE() == 0) {
+            continue;
+        }
+        s_pointers.push_back({ pointerAddress, pointee.getLE(), layout.pointeeSize });
+        CapturePages(s_pages, memoryBase, pointee.getLE(), layout.pointeeSize);
+    }
+
+    for (uint32_t reg = 0; reg < hasLayout.size(); reg++) {
+        if (!hasLayout[reg]) {
+            CapturePages(s_pages, memoryBase, hCPU->gpr[reg], 1);
+        }
+    }
+
+    const PPCInterpreter_t entryState = *hCPU;
+    hook(hCPU);
+    const PPCInterpreter_t exitState = *hCPU;
+
+    for (const Page& page : s_pages) {
+        Page& exitPage = s_exitPages.emplace_back();
+        exitPage.address = page.address;
+        std::memcpy(exitPage.data, reinterpret_cast<const void*>(memoryBase + page.address), GUEST_PAGE_SIZE);
+    }
+
+    std::scoped_lock lock(s_mutex);
+    if (s_bytesWritten >= MAX_CAPTURE_BYTES) {
+        return;
+    }
+
+    if (!s_file.is_open()) {
+        s_file.open("BetterVR_hooks.capture", std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!s_file.is_open()) {
+            Log::print<ERROR>("Failed to open BetterVR_hooks.capture, hook calls won't be captured");
+            s_bytesWritten = MAX_CAPTURE_BYTES;
+            return;
+        }
+        Log::print<INFO>("Capturing hook calls to BetterVR_hooks.capture");
+        const FileHeader fileHeader = { FILE_MAGIC, FILE_VERSION, GUEST_PAGE_SIZE };
+        Append(&fileHeader, sizeof(fileHeader));
+    }
+
+    const RecordHeader recordHeader = { s_sequence++, (uint32_t)std::strlen(name), (uint32_t)s_pointers.size(), (uint32_t)s_pages.size(), 0 };
+    Append(&recordHeader, sizeof(recordHeader));
+    Append(name, recordHeader.nameLength);
+    Append(&entryState, sizeof(entryState));
+    Append(&exitState, sizeof(exitState));
+    Append(s_pointers.data(), s_pointers.size() * sizeof(FollowedPointer));
+    Append(s_pages.data(), s_pages.size() * sizeof(Page));
+    Append(s_exitPages.data(), s_exitPages.size() * sizeof(Page));
+
+    if (s_bytesWritten >= MAX_CAPTURE_BYTES) {
+        Log::print<WARNING>("Hook capture reached {} MiB, stopping the capture", MAX_CAPTURE_BYTES / (1024 * 1024));
+        s_file.write(reinterpret_cast<const char*>(s_buffer.data()), (std::streamsize)s_buffer.size());
+        s_file.close();
+        s_buffer.clear();
+    }
+}
+
+void HookCapture::Append(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    s_buffer.insert(s_buffer.end(), bytes, bytes + size);
+    s_bytesWritten += size;
+
+    if (s_buffer.size() >= FLUSH_THRESHOLD) {
+        s_file.write(reinterpret_cast<const char*>(s_buffer.data()), (std::streamsize)s_buffer.size());
+        s_buffer.clear();
+    }
+}
+
+void HookCapture::Flush() {
+    std::scoped_lock lock(s_mutex);
+    if (s_file.is_open()) {
+        s_file.write(reinterpret_cast<const char*>(s_buffer.data()), (std::streamsize)s_buffer.size());
+        s_file.flush();
+        s_buffer.clear();
+    }
+}
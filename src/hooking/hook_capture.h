@@ -0,0 +1,78 @@
+#pragma once
+
+// Opt-in recording of HLE hook calls, enabled by setting BETTERVR_CAPTURE_HOOKS=1 before starting Cemu.
+// For every call the PPC registers before and after the hook are written to BetterVR_hooks.capture, together with
+// the guest memory the hook reads and writes. That's enough to rerun the hooks against the same inputs later on and
+// compare their outputs, since the hooks receive all their pointers through registers. The host build's
+// BetterVR_HookReplay (see hook_replay.h) does exactly that.
+//
+// Which memory gets captured comes from ArgumentLayout: a register that a hook receives a struct through gets the whole
+// [address, address + size) range captured, and pointers stored in that struct that the hook follows get their pointee
+// captured too. Every followed pointer is also recorded. For registers without a layout, the page they point to is captured.
+//
+// File layout, all little-endian:
+//   FileHeader
+//   repeated: RecordHeader, name (nameLength bytes), PPCInterpreter_t on entry, PPCInterpreter_t on exit,
+//             pointerCount * FollowedPointer, pageCount * Page on entry, the same pageCount * Page on exit
+class HookCapture {
+public:
+    static constexpr uint64_t FILE_MAGIC = 0x314B4F4F48525642; // "BVRHOOK1"
+    static constexpr uint32_t FILE_VERSION = 2;
+    static constexpr uint32_t GUEST_PAGE_SIZE = 0x1000;
+    static constexpr uint32_t MAX_PAGES_PER_CALL = 64;
+    static constexpr uint32_t NO_POINTEE = ~0u;
+
+    struct FileHeader {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t pageSize;
+    };
+
+    struct RecordHeader {
+        uint64_t sequence;
+        uint32_t nameLength;
+        uint32_t pointerCount;
+        uint32_t pageCount;
+        uint32_t reserved;
+    };
+
+    // source is the register for pointers the hook received, or the guest address the pointer was read from
+    struct FollowedPointer {
+        uint32_t source;
+        uint32_t address;
+        uint32_t size;
+    };
+
+    struct Page {
+        uint32_t address;
+        uint8_t data[GUEST_PAGE_SIZE];
+    };
+
+    // a hook receives a pointer to size bytes in reg, and reads the pointer stored at pointeeOffset in them as well
+    struct ArgumentLayout {
+        const char* hookName;
+        uint32_t reg;
+        uint32_t size;
+        uint32_t pointeeOffset = NO_POINTEE;
+        uint32_t pointeeSize = 0;
+    };
+
+    static bool IsEnabled() { return s_enabled; }
+
+    static void RecordCall(const char* name, PPCInterpreter_t* hCPU, void (*hook)(PPCInterpreter_t*), uint64_t memoryBase);
+    static void Flush();
+
+private:
+    // stop recording once the capture gets this big, a few minutes of gameplay already gets there
+    static constexpr size_t MAX_CAPTURE_BYTES = 1024ull * 1024 * 1024;
+    static constexpr size_t FLUSH_THRESHOLD = 16 * 1024 * 1024;
+
+    static void Append(const void* data, size_t size);
+
+    static const bool s_enabled;
+    static std::mutex s_mutex;
+    static std::ofstream s_file;
+    static std::vector<uint8_t> s_buffer;
+    static size_t s_bytesWritten;
+    static uint64_t s_sequence;
+};
@@ -0,0 +1,102 @@
+#include "hook_replay.h"
+
+template <typename T>
+static void ReadExact(std::istream& stream, T* data, size_t count = 1) {
+    stream.read(reinterpret_cast<char*>(data), (std::streamsize)(sizeof(T) * count));
+    if (!stream) {
+        throw std::runtime_error("Hook capture ends in the middle of a record");
+    }
+}
+
+std::vector<HookReplay::Call> HookReplay::Load(std::istream& stream) {
+    HookCapture::FileHeader fileHeader;
+    stream.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader));
+    if (!stream || fileHeader.magic != HookCapture::FILE_MAGIC) {
+        throw std::runtime_error("Not a hook capture");
+    }
+    if (fileHeader.version != HookCapture::FILE_VERSION) {
+        throw std::runtime_error("Hook capture version " + std::to_string(fileHeader.version) + " isn't supported, only version " + std::to_string(HookCapture::FILE_VERSION) + " is");
+    }
+    if (fileHeader.pageSize != HookCapture::GUEST_PAGE_SIZE) {
+        throw std::runtime_error("Hook capture uses an unsupported page size");
+    }
+
+    std::vector<Call> calls;
+    HookCapture::RecordHeader recordHeader;
+    while (stream.read(reinterpret_cast<char*>(&recordHeader), sizeof(recordHeader))) {
+        if (recordHeader.pageCount > HookCapture::MAX_PAGES_PER_CALL) {
+            throw std::runtime_error("Hook capture record has more pages than a capture can contain");
+        }
+
+        Call& call = calls.emplace_back();
+        call.sequence = recordHeader.sequence;
+        call.name.resize(recordHeader.nameLength);
+        ReadExact(stream, call.name.data(), call.name.size());
+        ReadExact(stream, &call.entry);
+        ReadExact(stream, &call.exit);
+        call.pointers.resize(recordHeader.pointerCount);
+        ReadExact(stream, call.pointers.data(), call.pointers.size());
+        call.entryPages.resize(recordHeader.pageCount);
+        ReadExact(stream, call.entryPages.data(), call.entryPages.size());
+        call.exitPages.resize(recordHeader.pageCount);
+        ReadExact(stream, call.exitPages.data(), call.exitPages.size());
+    }
+    if (!stream.eof() || stream.gcount() != 0) {
+        throw std::runtime_error("Hook capture ends in the middle of a record");
+    }
+    return calls;
+}
+
+HookReplay::CallResult HookReplay::Replay(const Call& call, HLEFunction hook, uint8_t* memoryBase, uint32_t repeatCount) {
+    CallResult result = {};
+    result.minNs = std::numeric_limits<uint64_t>::max();
+
+    PPCInterpreter_t hCPU;
+    for (uint32_t i = 0; i < std::max(repeatCount, 1u); i++) {
+        for (const HookCapture::Page& page : call.entryPages) {
+            std::memcpy(memoryBase + page.address, page.data, HookCapture::GUEST_PAGE_SIZE);
+        }
+        hCPU = call.entry;
+
+        const auto start = std::chrono::steady_clock::now();
+        hook(&hCPU);
+        const auto end = std::chrono::steady_clock::now();
+
+        const uint64_t durationNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        result.minNs = std::min(result.minNs, durationNs);
+        result.totalNs += durationNs;
+    }
+
+    result.registersMatch = RegistersMatch(hCPU, call.exit);
+    for (const HookCapture::Page& page : call.exitPages) {
+        const uint8_t* replayed = memoryBase + page.address;
+        for (uint32_t offset = 0; offset < HookCapture::GUEST_PAGE_SIZE; offset++) {
+            result.mismatchedBytes += replayed[offset] != page.data[offset];
+        }
+    }
+    return result;
+}
+
+bool HookReplay::RegistersMatch(const PPCInterpreter_t& lhs, const PPCInterpreter_t& rhs) {
+    if (lhs.instructionPointer != rhs.instructionPointer) {
+        return false;
+    }
+    if (std::memcmp(lhs.gpr, rhs.gpr, sizeof(lhs.gpr)) != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < std::size(lhs.fpr); i++) {
+        if (lhs.fpr[i].fp0int != rhs.fpr[i].fp0int || lhs.fpr[i].fp1int != rhs.fpr[i].fp1int) {
+            return false;
+        }
+    }
+    if (std::memcmp(lhs.crNew, rhs.crNew, sizeof(lhs.crNew)) != 0) {
+        return false;
+    }
+    if (lhs.fpscr != rhs.fpscr || lhs.xer_ca != rhs.xer_ca || lhs.LSQE != rhs.LSQE || lhs.PSE != rhs.PSE) {
+        return false;
+    }
+    if (lhs.remainingCycles != rhs.remainingCycles || lhs.skippedCycles != rhs.skippedCycles) {
+        return false;
+    }
+    return std::memcmp(&lhs.sprNew, &rhs.sprNew, sizeof(lhs.sprNew)) == 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "hook_capture.h"
+
+// Reruns hook calls that HookCapture recorded, against a guest memory image instead of a running game.
+// Each call gets its captured pages and entry registers restored before the hook runs, afterwards its registers and
+// the same pages are compared with what the hook produced in the game. Only depends on the standard library, so
+// the host build's BetterVR_HookReplay can use it together with CemuMock.
+class HookReplay {
+public:
+    using HLEFunction = void (*)(PPCInterpreter_t* hCPU);
+
+    struct Call {
+        uint64_t sequence;
+        std::string name;
+        PPCInterpreter_t entry;
+        PPCInterpreter_t exit;
+        std::vector<HookCapture::FollowedPointer> pointers;
+        std::vector<HookCapture::Page> entryPages;
+        std::vector<HookCapture::Page> exitPages;
+    };
+
+    struct CallResult {
+        bool registersMatch;
+        uint32_t mismatchedBytes; // bytes of the captured pages that differ from the capture after the hook ran
+        uint64_t minNs;
+        uint64_t totalNs;
+    };
+
+    // throws std::runtime_error if the stream doesn't hold a complete capture of a supported version
+    static std::vector<Call> Load(std::istream& stream);
+
+    // memoryBase is the host address of guest address 0. The call is repeated repeatCount times with its inputs restored
+    // each time, the registers and memory are compared after the last run.
+    static CallResult Replay(const Call& call, HLEFunction hook, uint8_t* memoryBase, uint32_t repeatCount = 1);
+
+    // compares field by field, PPCInterpreter_t has padding that isn't preserved when copying it
+    static bool RegistersMatch(const PPCInterpreter_t& lhs, const PPCInterpreter_t& rhs);
+};
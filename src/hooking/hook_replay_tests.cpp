@@ -0,0 +1,181 @@
+#include "catch.h"
+#include "cemu_mock.h"
+#include "hook_replay.h"
+#include "job_routes.h"
+
+namespace {
+    uint64_t s_memoryBase = 0;
+
+    // doubles the big-endian value r3 points to and returns the old value in r3
+    void hook_DoubleValue(PPCInterpreter_t* hCPU) {
+        hCPU->instructionPointer = hCPU->sprNew.LR;
+        auto* value = reinterpret_cast<BEType<uint32_t>*>(s_memoryBase + hCPU->gpr[3]);
+        hCPU->gpr[3] = value->getLE();
+        *value = value->getLE() * 2;
+    }
+
+    void hook_RouteActorJob(PPCInterpreter_t* hCPU) {
+        RouteActorJob(hCPU, s_memoryBase);
+    }
+
+    // Writes a capture in the same layout as HookCapture::RecordCall, by running the hook against the mock's memory.
+    // Each register argument gets the page it points into captured.
+    class CaptureWriter {
+    public:
+        CaptureWriter() {
+            const HookCapture::FileHeader header = { HookCapture::FILE_MAGIC, HookCapture::FILE_VERSION, HookCapture::GUEST_PAGE_SIZE };
+            Append(&header, sizeof(header));
+        }
+
+        void Record(const char* name, HookReplay::HLEFunction hook, const PPCInterpreter_t& entry, std::initializer_list<uint32_t> pointerRegs, const CemuMock& cemu) {
+            std::vector<HookCapture::FollowedPointer> pointers;
+            std::vector<uint32_t> pageAddresses;
+            for (uint32_t reg : pointerRegs) {
+                pointers.push_back({ reg, entry.gpr[reg], 1 });
+                const uint32_t pageAddress = entry.gpr[reg] & ~(HookCapture::GUEST_PAGE_SIZE - 1);
+                if (std::ranges::find(pageAddresses, pageAddress) == pageAddresses.end()) {
+                    pageAddresses.push_back(pageAddress);
+                }
+            }
+
+            std::vector<HookCapture::Page> entryPages = CopyPages(pageAddresses, cemu);
+            PPCInterpreter_t exit = entry;
+            hook(&exit);
+            std::vector<HookCapture::Page> exitPages = CopyPages(pageAddresses, cemu);
+
+            const HookCapture::RecordHeader header = { m_sequence++, (uint32_t)std::strlen(name), (uint32_t)pointers.size(), (uint32_t)pageAddresses.size(), 0 };
+            Append(&header, sizeof(header));
+            Append(name, header.nameLength);
+            Append(&entry, sizeof(entry));
+            Append(&exit, sizeof(exit));
+            Append(pointers.data(), pointers.size() * sizeof(HookCapture::FollowedPointer));
+            Append(entryPages.data(), entryPages.size() * sizeof(HookCapture::Page));
+            Append(exitPages.data(), exitPages.size() * sizeof(HookCapture::Page));
+        }
+
+        std::istringstream Stream() const { return std::istringstream(m_data, std::ios::in | std::ios::binary); }
+        std::string& Data() { return m_data; }
+
+    private:
+        static std::vector<HookCapture::Page> CopyPages(const std::vector<uint32_t>& pageAddresses, const CemuMock& cemu) {
+            std::vector<HookCapture::Page> pages(pageAddresses.size());
+            for (size_t i = 0; i < pages.size(); i++) {
+                pages[i].address = pageAddresses[i];
+                std::memcpy(pages[i].data, cemu.GetPointer(pageAddresses[i]), HookCapture::GUEST_PAGE_SIZE);
+            }
+            return pages;
+        }
+
+        void Append(const void* data, size_t size) { m_data.append(static_cast<const char*>(data), size); }
+
+        std::string m_data;
+        uint64_t m_sequence = 0;
+    };
+
+    PPCInterpreter_t MakeEntry(std::initializer_list<std::pair<uint32_t, uint32_t>> regs) {
+        PPCInterpreter_t hCPU = {};
+        hCPU.sprNew.LR = 0x02001234;
+        for (auto [reg, value] : regs) {
+            hCPU.gpr[reg] = value;
+        }
+        return hCPU;
+    }
+}
+
+TEST_CASE("HookReplay reproduces a captured call", "[hook_replay]") {
+    CemuMock cemu;
+    s_memoryBase = cemu.GetMemoryBaseAddress();
+
+    const uint32_t valueAddress = cemu.Allocate(sizeof(uint32_t));
+    cemu.Write(valueAddress, BEType<uint32_t>(21));
+
+    CaptureWriter capture;
+    capture.Record("hook_DoubleValue", &hook_DoubleValue, MakeEntry({ { 3, valueAddress } }), { 3 }, cemu);
+
+    std::istringstream stream = capture.Stream();
+    const std::vector<HookReplay::Call> calls = HookReplay::Load(stream);
+    REQUIRE(calls.size() == 1);
+    const HookReplay::Call& call = calls[0];
+    CHECK(call.name == "hook_DoubleValue");
+    CHECK(call.exit.gpr[3] == 21);
+    REQUIRE(call.pointers.size() == 1);
+    CHECK(call.pointers[0].source == 3);
+    CHECK(call.pointers[0].address == valueAddress);
+    REQUIRE(call.entryPages.size() == 1);
+    REQUIRE(call.exitPages.size() == 1);
+
+    // the replay has to restore the captured inputs itself
+    cemu.Reset();
+
+    SECTION("the same hook matches") {
+        const HookReplay::CallResult result = HookReplay::Replay(call, &hook_DoubleValue, cemu.GetPointer(0), 3);
+        CHECK(result.registersMatch);
+        CHECK(result.mismatchedBytes == 0);
+        CHECK(result.minNs <= result.totalNs);
+        CHECK(cemu.Read<BEType<uint32_t>>(valueAddress).getLE() == 42);
+    }
+
+    SECTION("a changed hook is reported") {
+        HookReplay::HLEFunction forgetsToDouble = [](PPCInterpreter_t* hCPU) {
+            hCPU->instructionPointer = hCPU->sprNew.LR;
+            hCPU->gpr[3] = reinterpret_cast<BEType<uint32_t>*>(s_memoryBase + hCPU->gpr[3])->getLE();
+        };
+        const HookReplay::CallResult result = HookReplay::Replay(call, forgetsToDouble, cemu.GetPointer(0));
+        CHECK(result.registersMatch);
+        CHECK(result.mismatchedBytes != 0);
+    }
+}
+
+TEST_CASE("HookReplay replays the actor job routing hook", "[hook_replay]") {
+    CemuMock cemu;
+    s_memoryBase = cemu.GetMemoryBaseAddress();
+    cemu.GetExports().osLib_registerHLEFunction("coreinit", "hook_RouteActorJob", &hook_RouteActorJob);
+
+    const uint32_t actor = cemu.Allocate(ACTOR_NAME_DATA_OFFSET + ACTOR_NAME_DATA_SIZE);
+    cemu.Write(actor + ACTOR_NAME_CSTR_OFFSET, BEType<uint32_t>(actor + ACTOR_NAME_DATA_OFFSET));
+    cemu.WriteBytes(actor + ACTOR_NAME_DATA_OFFSET, PLAYER_ACTOR_NAME.data(), PLAYER_ACTOR_NAME.size());
+    const uint32_t jobName = cemu.AllocateString("job0_1");
+
+    CaptureWriter capture;
+    capture.Record("hook_RouteActorJob", &hook_RouteActorJob, MakeEntry({ { 3, actor }, { 4, jobName }, { 5, 0 } }), { 3, 4 }, cemu);
+    capture.Record("hook_RouteActorJob", &hook_RouteActorJob, MakeEntry({ { 3, actor }, { 4, jobName }, { 5, 1 } }), { 3, 4 }, cemu);
+    cemu.Reset();
+
+    std::istringstream stream = capture.Stream();
+    const std::vector<HookReplay::Call> calls = HookReplay::Load(stream);
+    REQUIRE(calls.size() == 2);
+    CHECK(calls[0].exit.gpr[3] == std::to_underlying(JobRoute::ALTERED));
+    CHECK(calls[1].exit.gpr[3] == std::to_underlying(JobRoute::PERFORM));
+
+    for (const HookReplay::Call& call : calls) {
+        const HookReplay::CallResult result = HookReplay::Replay(call, cemu.FindFunction(call.name), cemu.GetPointer(0));
+        CHECK(result.registersMatch);
+        CHECK(result.mismatchedBytes == 0);
+    }
+}
+
+TEST_CASE("HookReplay rejects captures it can't read", "[hook_replay]") {
+    CemuMock cemu;
+    s_memoryBase = cemu.GetMemoryBaseAddress();
+    const uint32_t valueAddress = cemu.Allocate(sizeof(uint32_t));
+
+    CaptureWriter capture;
+    capture.Record("hook_DoubleValue", &hook_DoubleValue, MakeEntry({ { 3, valueAddress } }), { 3 }, cemu);
+
+    SECTION("truncated record") {
+        capture.Data().resize(capture.Data().size() - 1);
+        std::istringstream stream = capture.Stream();
+        CHECK_THROWS_AS(HookReplay::Load(stream), std::runtime_error);
+    }
+
+    SECTION("other version") {
+        capture.Data()[offsetof(HookCapture::FileHeader, version)] = 1;
+        std::istringstream stream = capture.Stream();
+        CHECK_THROWS_AS(HookReplay::Load(stream), std::runtime_error);
+    }
+
+    SECTION("not a capture") {
+        std::istringstream stream("not a capture", std::ios::in | std::ios::binary);
+        CHECK_THROWS_AS(HookReplay::Load(stream), std::runtime_error);
+    }
+}
@@ -0,0 +1,38 @@
+#include "job_routes.h"
+
+static std::string_view GetActorName(uint64_t memoryBase, uint32_t actorPtr) {
+    BEType<uint32_t> cStr;
+    std::memcpy(&cStr, (const void*)(memoryBase + actorPtr + ACTOR_NAME_CSTR_OFFSET), sizeof(cStr));
+    if (cStr.getLE() == 0) {
+        return std::string_view();
+    }
+    return GuestStringView((const char*)(memoryBase + actorPtr + ACTOR_NAME_DATA_OFFSET), ACTOR_NAME_DATA_SIZE);
+}
+
+void RouteActorJob(PPCInterpreter_t* hCPU, uint64_t memoryBase) {
+    hCPU->instructionPointer = hCPU->sprNew.LR;
+
+    uint32_t actorPtr = hCPU->gpr[3];
+    uint32_t jobName = hCPU->gpr[4];
+    uint32_t side = hCPU->gpr[5]; // 0 = left, 1 = right
+
+    // runs for every job of every actor for both eyes, so avoid copying the actor or allocating strings here
+    hCPU->gpr[3] = std::to_underlying(JobRoute::PERFORM);
+    if (side > 1) {
+        return;
+    }
+
+    const ActorJobRoute* route = FindActorJobRoute(GuestStringView((const char*)(memoryBase + jobName)));
+    if (route == nullptr) {
+        return;
+    }
+
+    const bool isPlayer = GetActorName(memoryBase, actorPtr) == PLAYER_ACTOR_NAME;
+    const JobRoute result = isPlayer ? route->player[side] : route->other[side];
+    hCPU->gpr[3] = std::to_underlying(result);
+
+    // exit r3:
+    // 1 = skip job
+    // 0 = perform job
+    // 2 = altered job
+}
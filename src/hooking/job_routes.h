@@ -0,0 +1,74 @@
+#pragma once
+#include "utils/string_hash.h"
+
+// Decides which of the player's and other actors' jobs the game runs for each eye.
+// This only depends on the standard library and guest memory, so the host build can run it against captured hook calls too.
+
+// exit r3 of hook_RouteActorJob
+enum class JobRoute : uint32_t {
+    PERFORM = 0,
+    SKIP = 1,
+    ALTERED = 2,
+};
+
+struct ActorJobRoute {
+    std::string_view jobName;
+    std::array<JobRoute, 2> player; // LEFT/RIGHT
+    std::array<JobRoute, 2> other;  // LEFT/RIGHT
+};
+
+inline constexpr ActorJobRoute s_actorJobRoutes[] = {
+    // the player's job0_1 only runs the climbing portion on the left eye's side,
+    // so that later jobs on the left side can use the state set by this portion of code
+    { "job0_1", { JobRoute::ALTERED, JobRoute::PERFORM }, { JobRoute::SKIP, JobRoute::PERFORM } },
+    { "job0_2", { JobRoute::PERFORM, JobRoute::SKIP }, { JobRoute::PERFORM, JobRoute::SKIP } },
+    { "job1_1", { JobRoute::PERFORM, JobRoute::SKIP }, { JobRoute::PERFORM, JobRoute::SKIP } },
+    { "job1_2", { JobRoute::PERFORM, JobRoute::SKIP }, { JobRoute::PERFORM, JobRoute::SKIP } },
+    { "job2_1_ragdoll_related", { JobRoute::PERFORM, JobRoute::SKIP }, { JobRoute::PERFORM, JobRoute::SKIP } },
+    { "job2_2", { JobRoute::PERFORM, JobRoute::SKIP }, { JobRoute::PERFORM, JobRoute::SKIP } },
+    { "job4", { JobRoute::PERFORM, JobRoute::SKIP }, { JobRoute::PERFORM, JobRoute::SKIP } },
+};
+
+inline constexpr auto s_actorJobRouteHashes = [] {
+    std::array<uint32_t, std::size(s_actorJobRoutes)> hashes = {};
+    for (size_t i = 0; i < hashes.size(); i++) {
+        hashes[i] = HashString(s_actorJobRoutes[i].jobName);
+    }
+    return hashes;
+}();
+
+constexpr bool HasUniqueJobHashes() {
+    for (size_t i = 0; i < s_actorJobRouteHashes.size(); i++) {
+        for (size_t j = i + 1; j < s_actorJobRouteHashes.size(); j++) {
+            if (s_actorJobRouteHashes[i] == s_actorJobRouteHashes[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+static_assert(HasUniqueJobHashes(), "Job names in the actor job routing table have colliding hashes");
+
+inline constexpr std::string_view PLAYER_ACTOR_NAME = "GameROMPlayer";
+
+// ActorWiiU::name is a sead::FixedSafeString40, settings.cpp checks these against game_structs.h
+inline constexpr uint32_t ACTOR_NAME_CSTR_OFFSET = 0x04;
+inline constexpr uint32_t ACTOR_NAME_DATA_OFFSET = 0x10;
+inline constexpr uint32_t ACTOR_NAME_DATA_SIZE = 0x40;
+
+// returns nullptr for jobs that run on both eyes
+constexpr const ActorJobRoute* FindActorJobRoute(std::string_view jobName) {
+    const uint32_t jobHash = HashString(jobName);
+    const auto it = std::ranges::find(s_actorJobRouteHashes, jobHash);
+    if (it == s_actorJobRouteHashes.end()) {
+        return nullptr;
+    }
+    const ActorJobRoute& route = s_actorJobRoutes[std::distance(s_actorJobRouteHashes.begin(), it)];
+    if (route.jobName != jobName) {
+        return nullptr;
+    }
+    return &route;
+}
+
+// Body of hook_RouteActorJob. r3 is the actor, r4 the job's name and r5 the eye (0 = left, 1 = right).
+void RouteActorJob(PPCInterpreter_t* hCPU, uint64_t memoryBase);
@@ -0,0 +1,72 @@
+#include "catch.h"
+#include "cemu_mock.h"
+#include "job_routes.h"
+
+namespace {
+    uint32_t AllocateActor(CemuMock& cemu, std::string_view name) {
+        const uint32_t actor = cemu.Allocate(ACTOR_NAME_DATA_OFFSET + ACTOR_NAME_DATA_SIZE);
+        cemu.Write(actor + ACTOR_NAME_CSTR_OFFSET, BEType<uint32_t>(actor + ACTOR_NAME_DATA_OFFSET));
+        cemu.WriteBytes(actor + ACTOR_NAME_DATA_OFFSET, name.data(), name.size());
+        return actor;
+    }
+
+    JobRoute Route(const CemuMock& cemu, uint32_t actor, uint32_t jobName, uint32_t side) {
+        PPCInterpreter_t hCPU = {};
+        hCPU.sprNew.LR = 0x02001234;
+        hCPU.gpr[3] = actor;
+        hCPU.gpr[4] = jobName;
+        hCPU.gpr[5] = side;
+        RouteActorJob(&hCPU, cemu.GetMemoryBaseAddress());
+        REQUIRE(hCPU.instructionPointer == 0x02001234);
+        return static_cast<JobRoute>(hCPU.gpr[3]);
+    }
+}
+
+TEST_CASE("FindActorJobRoute only finds the routed jobs", "[job_routes]") {
+    for (const ActorJobRoute& route : s_actorJobRoutes) {
+        CHECK(FindActorJobRoute(route.jobName) == &route);
+    }
+    static_assert(FindActorJobRoute("job0_1") == &s_actorJobRoutes[0]);
+
+    CHECK(FindActorJobRoute("job3") == nullptr);
+    CHECK(FindActorJobRoute("job0_") == nullptr);
+    CHECK(FindActorJobRoute("job0_1 ") == nullptr);
+    CHECK(FindActorJobRoute("") == nullptr);
+}
+
+TEST_CASE("RouteActorJob routes the player's and other actors' jobs per eye", "[job_routes]") {
+    CemuMock cemu;
+    const uint32_t player = AllocateActor(cemu, PLAYER_ACTOR_NAME);
+    const uint32_t enemy = AllocateActor(cemu, "Enemy_Bokoblin_Junior");
+
+    for (const ActorJobRoute& route : s_actorJobRoutes) {
+        const uint32_t jobName = cemu.AllocateString(route.jobName);
+        for (uint32_t side = 0; side < 2; side++) {
+            CHECK(Route(cemu, player, jobName, side) == route.player[side]);
+            CHECK(Route(cemu, enemy, jobName, side) == route.other[side]);
+        }
+    }
+
+    SECTION("jobs that aren't in the table run on both eyes") {
+        const uint32_t jobName = cemu.AllocateString("job3");
+        CHECK(Route(cemu, player, jobName, 0) == JobRoute::PERFORM);
+        CHECK(Route(cemu, player, jobName, 1) == JobRoute::PERFORM);
+    }
+
+    SECTION("an invalid side always performs the job") {
+        const uint32_t jobName = cemu.AllocateString("job0_2");
+        CHECK(Route(cemu, player, jobName, 2) == JobRoute::PERFORM);
+    }
+
+    SECTION("an actor without a name is routed like other actors") {
+        const uint32_t unnamed = cemu.Allocate(ACTOR_NAME_DATA_OFFSET + ACTOR_NAME_DATA_SIZE);
+        const uint32_t jobName = cemu.AllocateString("job0_1");
+        CHECK(Route(cemu, unnamed, jobName, 0) == JobRoute::SKIP);
+    }
+
+    SECTION("a name that only starts with the player's name isn't the player") {
+        const uint32_t lookalike = AllocateActor(cemu, std::string(PLAYER_ACTOR_NAME) + "Clone");
+        const uint32_t jobName = cemu.AllocateString("job0_1");
+        CHECK(Route(cemu, lookalike, jobName, 0) == JobRoute::SKIP);
+    }
+}
@@ -519,13 +519,15 @@ VkResult VRLayer::VkInstanceOverrides::CreateDevice(const vkroots::VkInstanceDis
 
     // Query supported features from the GPU
     VkPhysicalDeviceTimelineSemaphoreFeatures supportedTimelineSemaphoreFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES };
+    VkPhysicalDeviceSynchronization2Features supportedSynchronization2Features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES };
     VkPhysicalDeviceFeatures2 supportedFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
     supportedFeatures.pNext = &supportedTimelineSemaphoreFeatures;
+    supportedTimelineSemaphoreFeatures.pNext = &supportedSynchronization2Features;
 
 #if ENABLE_VK_ROBUSTNESS
     VkPhysicalDeviceImageRobustnessFeatures supportedImageRobustnessFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_ROBUSTNESS_FEATURES };
     VkPhysicalDeviceRobustness2FeaturesEXT supportedRobustness2Features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ROBUSTNESS_2_FEATURES_EXT };
-    supportedTimelineSemaphoreFeatures.pNext = &supportedImageRobustnessFeatures;
+    supportedSynchronization2Features.pNext = &supportedImageRobustnessFeatures;
     supportedImageRobustnessFeatures.pNext = &supportedRobustness2Features;
 #endif
 
@@ -533,6 +535,8 @@ VkResult VRLayer::VkInstanceOverrides::CreateDevice(const vkroots::VkInstanceDis
 
     // Test if timeline semaphores are already enabled in the create info
     bool timelineSemaphoresEnabled = false;
+    bool synchronization2Requested = false;
+    bool synchronization2Enabled = false;
     bool imageRobustnessEnabled = false;
     bool robustness2Enabled = false;
     const void* current_pNext = pCreateInfo->pNext;
@@ -541,6 +545,15 @@ VkResult VRLayer::VkInstanceOverrides::CreateDevice(const vkroots::VkInstanceDis
         if (base->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES) {
             timelineSemaphoresEnabled = true;
         }
+        // the synchronization2 feature can't be chained twice, so respect whatever the application decided
+        if (base->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES) {
+            synchronization2Requested = true;
+            synchronization2Enabled = reinterpret_cast<const VkPhysicalDeviceSynchronization2Features*>(base)->synchronization2;
+        }
+        if (base->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES) {
+            synchronization2Requested = true;
+            synchronization2Enabled = reinterpret_cast<const VkPhysicalDeviceVulkan13Features*>(base)->synchronization2;
+        }
 #if ENABLE_VK_ROBUSTNESS
         if (base->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_ROBUSTNESS_FEATURES) {
             imageRobustnessEnabled = true;
@@ -555,6 +568,9 @@ VkResult VRLayer::VkInstanceOverrides::CreateDevice(const vkroots::VkInstanceDis
     VkPhysicalDeviceTimelineSemaphoreFeatures createSemaphoreFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES };
     createSemaphoreFeatures.timelineSemaphore = true;
 
+    VkPhysicalDeviceSynchronization2Features createSynchronization2Features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES };
+    createSynchronization2Features.synchronization2 = true;
+
     VkPhysicalDeviceImageRobustnessFeatures createImageRobustnessFeatures = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_ROBUSTNESS_FEATURES };
     createImageRobustnessFeatures.robustImageAccess = true;
 
@@ -590,6 +606,16 @@ VkResult VRLayer::VkInstanceOverrides::CreateDevice(const vkroots::VkInstanceDis
         Log::print<ERROR>("Timeline semaphores are not supported by this GPU! VR functionality may not work.");
     }
 
+    const bool synchronization2ExtensionEnabled = std::find_if(modifiedExtensions.begin(), modifiedExtensions.end(), [](const char* ext) { return std::string_view(ext) == VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME; }) != modifiedExtensions.end();
+    if (!synchronization2Requested && synchronization2ExtensionEnabled && supportedSynchronization2Features.synchronization2) {
+        createSynchronization2Features.pNext = nextChain;
+        nextChain = &createSynchronization2Features;
+        synchronization2Enabled = true;
+    }
+    else if (!synchronization2Enabled) {
+        Log::print<WARNING>("Synchronization2 is not available, falling back to legacy queue submissions.");
+    }
+
     VkDeviceCreateInfo modifiedCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
     modifiedCreateInfo.pNext = nextChain;
     modifiedCreateInfo.flags = pCreateInfo->flags;
@@ -628,6 +654,8 @@ VkResult VRLayer::VkInstanceOverrides::CreateDevice(const vkroots::VkInstanceDis
         return result;
     }
 
+    VRManager::instance().vkSynchronization2 = synchronization2Enabled;
+
     // Initialize VRManager late if neither vkEnumeratePhysicalDevices and vkGetPhysicalDeviceProperties were called and used to filter the device
     if (!VRManager::instance().VK) {
         Log::print<WARNING>("Wasn't able to filter OpenXR-compatible devices for this instance!");
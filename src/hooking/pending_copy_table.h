@@ -0,0 +1,115 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <span>
+
+// Pending copies are keyed on the command buffer that recorded them, and get consumed by the QueueSubmit that submits that command buffer.
+// Uses a fixed-size open addressing table so that neither recording nor submitting allocates memory.
+template <typename CommandBuffer, typename Texture>
+class PendingCopyTable {
+public:
+    static constexpr size_t CAPACITY = 64; // needs to be a power of two
+    static constexpr size_t MAX_COPIES_PER_COMMAND_BUFFER = 8;
+
+    struct Entry {
+        CommandBuffer commandBuffer = {};
+        uint32_t count = 0;
+        std::array<Texture*, MAX_COPIES_PER_COMMAND_BUFFER> textures = {};
+    };
+
+    bool IsEmpty() const { return m_pendingCount.load(std::memory_order_acquire) == 0; }
+
+    // Returns false if the copy was dropped because there were too many command buffers or copies pending
+    bool Add(CommandBuffer commandBuffer, Texture* texture) {
+        std::lock_guard lock(m_mutex);
+        size_t idx = FindSlot(commandBuffer);
+        if (idx == CAPACITY) {
+            return false;
+        }
+
+        Entry& entry = m_entries[idx];
+        if (entry.commandBuffer == CommandBuffer{}) {
+            entry.commandBuffer = commandBuffer;
+            entry.count = 0;
+        }
+        if (entry.count == entry.textures.size()) {
+            return false;
+        }
+        entry.textures[entry.count++] = texture;
+        m_pendingCount.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    // Checks whether any of the command buffers has pending copies without taking them, so that submits without any can be passed through
+    bool ContainsAny(std::span<const CommandBuffer> commandBuffers) const {
+        if (IsEmpty()) {
+            return false;
+        }
+        std::lock_guard lock(m_mutex);
+        for (CommandBuffer commandBuffer : commandBuffers) {
+            size_t idx = FindSlot(commandBuffer);
+            if (idx != CAPACITY && m_entries[idx].commandBuffer != CommandBuffer{}) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Moves the pending copies of a command buffer into the given entry, returns false if there were none
+    bool Take(CommandBuffer commandBuffer, Entry& out) {
+        std::lock_guard lock(m_mutex);
+        size_t idx = FindSlot(commandBuffer);
+        if (idx == CAPACITY || m_entries[idx].commandBuffer == CommandBuffer{}) {
+            return false;
+        }
+
+        out = m_entries[idx];
+        m_pendingCount.fetch_sub(out.count, std::memory_order_release);
+        Erase(idx);
+        return true;
+    }
+
+private:
+    static size_t Hash(CommandBuffer commandBuffer) {
+        // handles are pointers, so skip the alignment bits and mix the rest
+        uint64_t h = (uint64_t)commandBuffer >> 4;
+        h ^= h >> 17;
+        h *= 0xED5AD4BBull;
+        h ^= h >> 11;
+        return (size_t)h & (CAPACITY - 1);
+    }
+
+    // Returns either the slot that contains the command buffer, the empty slot it'd be inserted into, or CAPACITY if the table is full
+    size_t FindSlot(CommandBuffer commandBuffer) const {
+        size_t idx = Hash(commandBuffer);
+        for (size_t probe = 0; probe < CAPACITY; probe++) {
+            const Entry& entry = m_entries[idx];
+            if (entry.commandBuffer == commandBuffer || entry.commandBuffer == CommandBuffer{}) {
+                return idx;
+            }
+            idx = (idx + 1) & (CAPACITY - 1);
+        }
+        return CAPACITY;
+    }
+
+    // Backward shift deletion, which keeps the probe chains intact without needing tombstones.
+    // The hole is cleared right away so that the scan stops there at the latest, even when every other slot is used.
+    void Erase(size_t idx) {
+        m_entries[idx] = {};
+        size_t next = (idx + 1) & (CAPACITY - 1);
+        while (m_entries[next].commandBuffer != CommandBuffer{}) {
+            size_t home = Hash(m_entries[next].commandBuffer);
+            if (((next - home) & (CAPACITY - 1)) >= ((next - idx) & (CAPACITY - 1))) {
+                m_entries[idx] = m_entries[next];
+                m_entries[next] = {};
+                idx = next;
+            }
+            next = (next + 1) & (CAPACITY - 1);
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::atomic_uint32_t m_pendingCount = 0;
+    std::array<Entry, CAPACITY> m_entries = {};
+};
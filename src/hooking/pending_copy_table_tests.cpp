@@ -0,0 +1,90 @@
+#include "catch.h"
+#include "pending_copy_table.h"
+
+namespace {
+    // stands in for VkCommandBuffer, which is a pointer to an opaque struct as well
+    struct TestCommandBuffer_T;
+    using TestCommandBuffer = TestCommandBuffer_T*;
+
+    struct TestTexture {
+        uint32_t id;
+    };
+
+    using TestTable = PendingCopyTable<TestCommandBuffer, TestTexture>;
+
+    TestCommandBuffer MakeCommandBuffer(uint64_t idx) {
+        return reinterpret_cast<TestCommandBuffer>(0x10000 + idx * 0x40);
+    }
+}
+
+TEST_CASE("PendingCopyTable hands the copies of a command buffer to its submit", "[pending_copy_table]") {
+    TestTable table;
+    TestTexture left = { 0 }, right = { 1 }, hud = { 2 };
+
+    CHECK(table.IsEmpty());
+    CHECK(table.Add(MakeCommandBuffer(1), &left));
+    CHECK(table.Add(MakeCommandBuffer(1), &right));
+    CHECK(table.Add(MakeCommandBuffer(2), &hud));
+    CHECK_FALSE(table.IsEmpty());
+
+    TestTable::Entry copies;
+    CHECK_FALSE(table.Take(MakeCommandBuffer(3), copies));
+    REQUIRE(table.Take(MakeCommandBuffer(1), copies));
+    CHECK(copies.commandBuffer == MakeCommandBuffer(1));
+    REQUIRE(copies.count == 2);
+    CHECK(copies.textures[0] == &left);
+    CHECK(copies.textures[1] == &right);
+
+    // taking them consumes them
+    CHECK_FALSE(table.Take(MakeCommandBuffer(1), copies));
+    REQUIRE(table.Take(MakeCommandBuffer(2), copies));
+    CHECK(copies.textures[0] == &hud);
+    CHECK(table.IsEmpty());
+}
+
+TEST_CASE("PendingCopyTable looks up command buffers without consuming their copies", "[pending_copy_table]") {
+    TestTable table;
+    TestTexture texture = { 0 };
+    const std::array<TestCommandBuffer, 3> unrelated = { MakeCommandBuffer(10), MakeCommandBuffer(11), MakeCommandBuffer(12) };
+    const std::array<TestCommandBuffer, 3> withCopy = { MakeCommandBuffer(10), MakeCommandBuffer(5), MakeCommandBuffer(12) };
+
+    CHECK_FALSE(table.ContainsAny(withCopy));
+    REQUIRE(table.Add(MakeCommandBuffer(5), &texture));
+    CHECK_FALSE(table.ContainsAny(unrelated));
+    CHECK_FALSE(table.ContainsAny({}));
+    CHECK(table.ContainsAny(withCopy));
+    CHECK(table.ContainsAny(withCopy));
+
+    TestTable::Entry copies;
+    REQUIRE(table.Take(MakeCommandBuffer(5), copies));
+    CHECK(copies.count == 1);
+    CHECK_FALSE(table.ContainsAny(withCopy));
+}
+
+TEST_CASE("PendingCopyTable drops copies once it's full", "[pending_copy_table]") {
+    TestTable table;
+    TestTexture texture = { 0 };
+
+    for (uint32_t i = 0; i < TestTable::MAX_COPIES_PER_COMMAND_BUFFER; i++) {
+        REQUIRE(table.Add(MakeCommandBuffer(0), &texture));
+    }
+    CHECK_FALSE(table.Add(MakeCommandBuffer(0), &texture));
+
+    for (uint64_t idx = 1; idx < TestTable::CAPACITY; idx++) {
+        REQUIRE(table.Add(MakeCommandBuffer(idx), &texture));
+    }
+    CHECK_FALSE(table.Add(MakeCommandBuffer(TestTable::CAPACITY), &texture));
+
+    // every command buffer is still found after the others around it were taken, so the probe chains stayed intact
+    TestTable::Entry copies;
+    for (uint64_t idx = 0; idx < TestTable::CAPACITY; idx += 2) {
+        REQUIRE(table.Take(MakeCommandBuffer(idx), copies));
+    }
+    for (uint64_t idx = 1; idx < TestTable::CAPACITY; idx += 2) {
+        const TestCommandBuffer commandBuffer = MakeCommandBuffer(idx);
+        REQUIRE(table.ContainsAny({ &commandBuffer, 1 }));
+        REQUIRE(table.Take(commandBuffer, copies));
+        CHECK(copies.count == 1);
+    }
+    CHECK(table.IsEmpty());
+}
@@ -1,9 +1,12 @@
 #include "cemu_hooks.h"
 #include "instance.h"
 #include "hooking/entity_debugger.h"
+#include "hooking/job_routes.h"
+#include "utils/snapshot_publisher.h"
+#include "utils/string_hash.h"
 
-std::mutex g_settingsMutex;
-data_VRSettingsIn g_settings = {};
+// The settings only change when the user edits them in the graphic pack, while the per-actor and per-bone hooks read them constantly
+static SnapshotPublisher<VRSettings> s_settings;
 
 uint64_t CemuHooks::s_memoryBaseAddress = 0;
 std::atomic_uint32_t CemuHooks::s_framesSinceLastCameraUpdate = 0;
@@ -14,30 +17,50 @@ void CemuHooks::hook_UpdateSettings(PPCInterpreter_t* hCPU) {
 
     uint32_t ppc_settingsOffset = hCPU->gpr[5];
     uint32_t ppc_tableOfCutsceneEventSettings = hCPU->gpr[6];
-    data_VRSettingsIn settings = {};
+    data_VRSettingsIn settingsIn = {};
 
     if (auto& debugger = VRManager::instance().Hooks->m_entityDebugger) {
         debugger->UpdateEntityMemory();
     }
 
-    readMemory(ppc_settingsOffset, &settings);
+    readMemory(ppc_settingsOffset, &settingsIn);
+    const VRSettings settings = VRSettings::FromGuest(settingsIn);
 
-    std::lock_guard lock(g_settingsMutex);
-    g_settings = settings;
+    // only called from the emulated CPU thread, so there's only ever one writer
+    s_settings.Publish(settings);
     ++s_framesSinceLastCameraUpdate;
 
     static bool logSettings = true;
     if (logSettings) {
-        Log::print<INFO>("VR Settings:\n{}", g_settings.ToString());
+        Log::print<INFO>("VR Settings:\n{}", settings.ToString());
         logSettings = false;
     }
 
     initCutsceneDefaultSettings(ppc_tableOfCutsceneEventSettings);
 }
 
-data_VRSettingsIn CemuHooks::GetSettings() {
-    std::lock_guard lock(g_settingsMutex);
-    return g_settings;
+const VRSettings& CemuHooks::GetSettings() {
+    return s_settings.Get();
+}
+
+
+std::string VRSettings::ToString() const {
+    std::string buffer = "";
+    std::format_to(std::back_inserter(buffer), " - Camera Mode: {}\n", IsFirstPersonMode() ? "First Person" : "Third Person");
+    std::format_to(std::back_inserter(buffer), " - Left Handed: {}\n", IsLeftHanded() ? "Yes" : "No");
+    std::format_to(std::back_inserter(buffer), " - GUI Follow Setting: {}\n", UIFollowsLookingDirection() ? "Follow Looking Direction" : "Fixed");
+    std::format_to(std::back_inserter(buffer), " - Player Height: {} meters\n", GetPlayerHeight());
+    std::format_to(std::back_inserter(buffer), " - 2D VR View Enabled: {}\n", Is2DVRViewEnabled() ? "Yes" : "No");
+    std::format_to(std::back_inserter(buffer), " - Crop Flat to 16:9: {}\n", ShouldFlatPreviewBeCroppedTo16x9() ? "Yes" : "No");
+    std::format_to(std::back_inserter(buffer), " - Debug Overlay: {}\n", ShowDebugOverlay() ? "Enabled" : "Disabled");
+    std::format_to(std::back_inserter(buffer), " - Cutscene Camera Mode: {}\n", GetCutsceneCameraMode() == EventMode::ALWAYS_FIRST_PERSON ? "Always First Person" : (GetCutsceneCameraMode() == EventMode::ALWAYS_THIRD_PERSON ? "Always Third Person" : "Follow Default Event Settings"));
+    std::format_to(std::back_inserter(buffer), " - Show Black Bars for Third-Person Cutscenes: {}\n", UseBlackBarsForCutscenes() ? "Yes" : "No");
+    std::format_to(std::back_inserter(buffer), " - Single-Pass Stereo: {}\n", IsSinglePassStereoEnabled() ? "Enabled" : "Disabled");
+    std::format_to(std::back_inserter(buffer), " - VR Resolution: {}%\n", GetRenderScale() * 100.0f);
+    std::format_to(std::back_inserter(buffer), " - HUD Resolution: {}%\n", GetHUDScale() * 100.0f);
+    std::format_to(std::back_inserter(buffer), " - Dynamic VR Resolution: {}\n", IsDynamicResolutionEnabled() ? "Enabled" : "Disabled");
+    std::format_to(std::back_inserter(buffer), " - VR Swapchain Layout: {}\n", UseStereoSwapchains() ? "One Layered Image For Both Eyes" : "One Image Per Eye");
+    return buffer;
 }
 
 
@@ -58,85 +81,11 @@ void CemuHooks::hook_OSReportToConsole(PPCInterpreter_t* hCPU) {
 }
 
 constexpr uint32_t playerVtable = 0x101E5FFC;
-void CemuHooks::hook_RouteActorJob(PPCInterpreter_t* hCPU) {
-    hCPU->instructionPointer = hCPU->sprNew.LR;
-
-    uint32_t actorPtr = hCPU->gpr[3];
-    uint32_t jobName = hCPU->gpr[4];
-    uint32_t side = hCPU->gpr[5]; // 0 = left, 1 = right
-
-    std::string jobNameStr = std::string((char*)(s_memoryBaseAddress + jobName));
-
-    ActorWiiU actor;
-    readMemory(actorPtr, &actor);
-    std::string actorName = actor.name.getLE();
-
-#define SKIP_ON_LEFT_SIDE if (side == 0) { hCPU->gpr[3] = 1; }
-#define SKIP_ON_RIGHT_SIDE if (side == 1) { hCPU->gpr[3] = 1; }
-#define USE_ALTERED_PATH_ON_LEFT_SIDE if (side == 0) { hCPU->gpr[3] = 2; }
-#define USE_ALTERED_PATH_ON_RIGHT_SIDE if (side == 1) { hCPU->gpr[3] = 2; }
-
-    hCPU->gpr[3] = 0;
-    if (actorName == "GameROMPlayer") {
-        if (jobNameStr == "job0_1") {
-            // this only runs the climbing portion of this actor job on the left eye's side
-            // so that later jobs on the left side can use the state set by this portion of code
-            USE_ALTERED_PATH_ON_LEFT_SIDE
-        }
-        else if (jobNameStr == "job0_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job1_1") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job1_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job2_1_ragdoll_related") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job2_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job4") {
-            SKIP_ON_RIGHT_SIDE
-        }
-    }
-    else {
-        if (jobNameStr == "job0_1") {
-            SKIP_ON_LEFT_SIDE
-        }
-        else if (jobNameStr == "job0_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job1_1") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job1_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job2_1_ragdoll_related") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job2_2") {
-            SKIP_ON_RIGHT_SIDE
-        }
-        else if (jobNameStr == "job4") {
-            SKIP_ON_RIGHT_SIDE
-        }
-    }
-
-    if (hCPU->gpr[3] == 0) {
-        //Log::print<INFO>("[{}] Ran {}", actorName, jobNameStr);
-    }
-    else if (hCPU->gpr[3] == 2) {
-        //Log::print<INFO>("[{}] Ran ALTERED VERSION of {}", actorName, jobNameStr);
-    }
 
+static_assert(offsetof(ActorWiiU, name) + offsetof(sead::FixedSafeString40, c_str) == ACTOR_NAME_CSTR_OFFSET, "Actor name offset mismatch");
+static_assert(offsetof(ActorWiiU, name) + offsetof(sead::FixedSafeString40, data) == ACTOR_NAME_DATA_OFFSET, "Actor name offset mismatch");
+static_assert(sizeof(sead::FixedSafeString40::data) == ACTOR_NAME_DATA_SIZE, "Actor name size mismatch");
 
-
-    // exit r3:
-    // 1 = skip job
-    // 0 = perform job
-    // 2 = altered job
-}
\ No newline at end of file
+void CemuHooks::hook_RouteActorJob(PPCInterpreter_t* hCPU) {
+    RouteActorJob(hCPU, s_memoryBaseAddress);
+}
@@ -289,7 +289,7 @@ void CemuHooks::hook_ModifyBoneMatrix(PPCInterpreter_t* hCPU) {
     glm::mat4 cameraRotationOnlyMtx = glm::mat4_cast(cameraQuat);
 
     // get vr controller position and rotation
-    const OpenXR::InputState inputs = VRManager::instance().XR->m_input.load();
+    const OpenXR::InputState inputs = VRManager::instance().XR->m_input.Load();
     if (!inputs.inGame.in_game || !inputs.inGame.pose[side].isActive)
         return;
 
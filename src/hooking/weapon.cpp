@@ -157,7 +157,7 @@ void CemuHooks::hook_ChangeWeaponMtx(PPCInterpreter_t* hCPU) {
     glm::fvec3 cameraAt = camera.at.getLE();
     glm::fquat lookAtQuat = glm::quatLookAtRH(glm::normalize(cameraAt - cameraPos), { 0.0, 1.0, 0.0 });
     glm::fvec3 lookAtPos = cameraPos;
-    //lookAtPos.y += GetSettings().playerHeightSetting.getLE();
+    //lookAtPos.y += GetSettings().GetPlayerHeight();
 
     // read bone name
     if (boneNamePtr == 0)
@@ -202,8 +202,8 @@ void CemuHooks::hook_ChangeWeaponMtx(PPCInterpreter_t* hCPU) {
         readMemory(targetActorPtr, &targetActor);
 
         // check if weapon is held and if the grip button is held, drop it
-        auto input = VRManager::instance().XR->m_input.load();
-        auto dropSide = input.inGame.drop_weapon[side];
+        auto input = VRManager::instance().XR->m_input.Load();
+        auto dropSide = VRManager::instance().XR->m_gameState.Load().drop_weapon[side];
 
         if (input.inGame.in_game && dropSide && isDroppable(targetActor.name.getLE())) {
             Log::print<INFO>("Dropping weapon {} with type of {} due to double press on grab button", targetActor.name.getLE().c_str(), (uint32_t)targetActor.type.getLE());
@@ -259,7 +259,7 @@ void CemuHooks::hook_DropEquipment(PPCInterpreter_t* hCPU) {
     readMemory(weaponPtr, &weapon);
 
     //// check if weapon is held and if the grip button is held, drop it
-    //auto input = VRManager::instance().XR->m_input.load();
+    //auto input = VRManager::instance().XR->m_input.Load();
     //if (input.inGame.in_game && isHeldByPlayer && input.inGame.grab[heldIndex].currentState) {
     //    // if the weapon is held by the player and the grip button is pressed, drop it
     //    //Log::print("!! Dropping weapon {} because grip button is pressed", weapon.name.getLE());
@@ -323,12 +323,11 @@ void CemuHooks::hook_EnableWeaponAttackSensor(PPCInterpreter_t* hCPU) {
     bool isHeldByPlayer = hCPU->gpr[6] == 0;
     uint32_t frameCounter = hCPU->gpr[7];
 
-    Weapon weapon = {};
-    readMemory(weaponPtr, &weapon);
+    auto weapon = getView<Weapon>(weaponPtr);
 
-    WeaponType weaponType = weapon.type.getLE();
+    WeaponType weaponType = weapon->type.getLE();
     if (weaponType == WeaponType::Bow || weaponType == WeaponType::Shield) {
-        //Log::print<INFO>("Skipping motion analysis for Bow/Shield (type: {}): {}", (int)weaponType, weapon.name.getLE());
+        //Log::print<INFO>("Skipping motion analysis for Bow/Shield (type: {}): {}", (int)weaponType, weapon->name.getLE());
         return;
     }
 
@@ -349,7 +348,7 @@ void CemuHooks::hook_EnableWeaponAttackSensor(PPCInterpreter_t* hCPU) {
 
     //Log::print("!! Running weapon analysis for {}", heldIndex);
 
-    auto state = VRManager::instance().XR->m_input.load();
+    auto state = VRManager::instance().XR->m_input.Load();
     auto headset = VRManager::instance().XR->GetRenderer()->GetMiddlePose();
     if (!headset.has_value()) {
         return;
@@ -363,26 +362,23 @@ void CemuHooks::hook_EnableWeaponAttackSensor(PPCInterpreter_t* hCPU) {
     if (isHeldByPlayer && (m_motionAnalyzers[heldIndex].IsAttacking() || CHEAT_alwaysEnableWeaponCollision)) {
         m_motionAnalyzers[heldIndex].SetHitboxEnabled(true);
         //Log::print("!! Activate sensor for {}: isHeldByPlayer={}, weaponType={}", heldIndex, isHeldByPlayer, (int)weaponType);
-        weapon.setupAttackSensor.resetAttack = 1;
-        weapon.setupAttackSensor.mode = 2;
-        weapon.setupAttackSensor.isContactLayerInitialized = 0;
-        //weapon.setupAttackSensor.overrideImpact = 1;
-        //weapon.setupAttackSensor.impact = 2312;
-        //weapon.setupAttackSensor.multiplier = 20.0f;
-        //weapon.setupAttackSensor.overrideImpact = 1;
-        //weapon.setupAttackSensor.multiplier = analyzer->GetDamage();
-        //weapon.setupAttackSensor.impact = analyzer->GetImpulse();
-
-        writeMemory(weaponPtr, &weapon);
+        weapon->setupAttackSensor.resetAttack = 1;
+        weapon->setupAttackSensor.mode = 2;
+        weapon->setupAttackSensor.isContactLayerInitialized = 0;
+        //weapon->setupAttackSensor.overrideImpact = 1;
+        //weapon->setupAttackSensor.impact = 2312;
+        //weapon->setupAttackSensor.multiplier = 20.0f;
+        //weapon->setupAttackSensor.overrideImpact = 1;
+        //weapon->setupAttackSensor.multiplier = analyzer->GetDamage();
+        //weapon->setupAttackSensor.impact = analyzer->GetImpulse();
     }
     else if (m_motionAnalyzers[heldIndex].IsHitboxEnabled()) {
         m_motionAnalyzers[heldIndex].SetHitboxEnabled(false);
         //Log::print("!! Deactivate sensor for {}: isHeldByPlayer={}, weaponType={}", heldIndex, isHeldByPlayer, (int)weaponType);
 
-        weapon.setupAttackSensor.resetAttack = 1;
-        weapon.setupAttackSensor.mode = 1; // deactivate attack sensor
-        weapon.setupAttackSensor.isContactLayerInitialized = 0;
-        writeMemory(weaponPtr, &weapon);
+        weapon->setupAttackSensor.resetAttack = 1;
+        weapon->setupAttackSensor.mode = 1; // deactivate attack sensor
+        weapon->setupAttackSensor.isContactLayerInitialized = 0;
     }
 
     // rumbles
@@ -417,7 +413,7 @@ void CemuHooks::hook_SetPlayerWeaponScale(PPCInterpreter_t* hCPU) {
 void CemuHooks::hook_EquipWeapon(PPCInterpreter_t* hCPU) {
     hCPU->instructionPointer = hCPU->sprNew.LR;
 
-    auto input = VRManager::instance().XR->m_input.load();
+    auto input = VRManager::instance().XR->m_input.Load();
     // Check both hands for a short press to pick up weapon
     for (int side = 0; side < 2; ++side) {
         auto& grabState = input.inGame.grabState[side];
@@ -41,6 +41,7 @@ public:
     std::unique_ptr<CemuHooks> Hooks;
 
     uint32_t vkVersion = 0;
+    bool vkSynchronization2 = false;
 
 private:
     VRManager() {
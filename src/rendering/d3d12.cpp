@@ -66,16 +66,177 @@ RND_D3D12::RND_D3D12() {
         .Flags = D3D12_COMMAND_QUEUE_FLAG_NONE
     };
     checkHResult(m_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_queue)), "Failed to create D3D12 command queue!");
+
+    // Create the frame pacing objects once, they get recycled every FRAMES_IN_FLIGHT frames
+    for (FrameResources& frame : m_frames) {
+        checkHResult(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&frame.allocator)), "Failed to create frame command allocator!");
+    }
+    checkHResult(m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)), "Failed to create frame fence!");
+    m_fenceEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    checkAssert(m_fenceEvent != NULL, "Failed to create frame fence event!");
+
+    // Command lists are created once and reset whenever they're reused
+    checkHResult(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, m_frames[0].allocator.Get(), nullptr, IID_PPV_ARGS(&m_frameCmdList)), "Failed to create frame command list!");
+    checkHResult(m_frameCmdList->Close(), "Failed to close frame command list!");
+    m_frameCmdList->SetName(L"RenderSharedTexture");
+
+    D3D12_QUERY_HEAP_DESC timestampHeapDesc = {
+        .Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP,
+        .Count = FRAMES_IN_FLIGHT * 2,
+        .NodeMask = 0
+    };
+    checkHResult(m_device->CreateQueryHeap(&timestampHeapDesc, IID_PPV_ARGS(&m_timestampHeap)), "Failed to create timestamp query heap!");
+    checkHResult(m_queue->GetTimestampFrequency(&m_timestampFrequency), "Failed to get timestamp frequency of the command queue!");
+
+    D3D12_HEAP_PROPERTIES readbackHeapProp = {
+        .Type = D3D12_HEAP_TYPE_READBACK,
+        .CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
+        .MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN
+    };
+    D3D12_RESOURCE_DESC readbackDesc = {
+        .Dimension = D3D12_RESOURCE_DIMENSION_BUFFER,
+        .Width = FRAMES_IN_FLIGHT * 2 * sizeof(uint64_t),
+        .Height = 1,
+        .DepthOrArraySize = 1,
+        .MipLevels = 1,
+        .Format = DXGI_FORMAT_UNKNOWN,
+        .SampleDesc = { .Count = 1, .Quality = 0 },
+        .Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
+        .Flags = D3D12_RESOURCE_FLAG_NONE
+    };
+    checkHResult(m_device->CreateCommittedResource(&readbackHeapProp, D3D12_HEAP_FLAG_NONE, &readbackDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&m_timestampReadback)), "Failed to create timestamp readback buffer!");
+
+    checkHResult(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_immediateAllocator)), "Failed to create immediate command allocator!");
+    checkHResult(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, m_immediateAllocator.Get(), nullptr, IID_PPV_ARGS(&m_immediateCmdList)), "Failed to create immediate command list!");
+    checkHResult(m_immediateCmdList->Close(), "Failed to close immediate command list!");
+    checkHResult(m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_immediateFence)), "Failed to create immediate fence!");
+    m_immediateEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    checkAssert(m_immediateEvent != NULL, "Failed to create immediate fence event!");
 }
 
 RND_D3D12::~RND_D3D12() {
+    // Make sure the GPU isn't using any of the allocators anymore before releasing them
+    if (m_fence && m_queue) {
+        if (SUCCEEDED(m_queue->Signal(m_fence.Get(), ++m_lastSignalledValue))) {
+            WaitForFenceValue(m_lastSignalledValue);
+        }
+    }
+    if (m_fenceEvent != nullptr) {
+        CloseHandle(m_fenceEvent);
+        m_fenceEvent = nullptr;
+    }
+    if (m_immediateEvent != nullptr) {
+        CloseHandle(m_immediateEvent);
+        m_immediateEvent = nullptr;
+    }
+}
+
+void RND_D3D12::StartFrame() {
+    FrameResources& frame = m_frames[m_frameSlot];
+
+    // Only stall when the GPU is still executing the previous frame that used this slot
+    WaitForFenceValue(frame.fenceValue);
+    checkHResult(frame.allocator->Reset(), "Failed to reset frame command allocator!");
+
+    if (frame.wroteTimestamps) {
+        frame.wroteTimestamps = false;
+        const D3D12_RANGE readRange = { .Begin = m_frameSlot * 2 * sizeof(uint64_t), .End = (m_frameSlot + 1) * 2 * sizeof(uint64_t) };
+        void* data;
+        if (SUCCEEDED(m_timestampReadback->Map(0, &readRange, &data))) {
+            const uint64_t* timestamps = reinterpret_cast<const uint64_t*>(static_cast<const uint8_t*>(data) + readRange.Begin);
+            if (timestamps[1] > timestamps[0]) {
+                m_lastFrameGpuMs = double(timestamps[1] - timestamps[0]) * 1000.0 / double(m_timestampFrequency);
+            }
+            const D3D12_RANGE writeRange = { .Begin = 0, .End = 0 };
+            m_timestampReadback->Unmap(0, &writeRange);
+        }
+    }
+}
+
+void RND_D3D12::EndFrame() {
+    // Layers normally submit before releasing their swapchain images, but flush anything that got recorded afterwards
+    SubmitFrameCommands();
+
+    FrameResources& frame = m_frames[m_frameSlot];
+    frame.fenceValue = ++m_lastSignalledValue;
+    checkHResult(m_queue->Signal(m_fence.Get(), frame.fenceValue), "Failed to signal fence for end-of-frame!");
+
+    m_frameSlot = (m_frameSlot + 1) % FRAMES_IN_FLIGHT;
+}
+
+void RND_D3D12::WaitForFenceValue(uint64_t value) {
+    if (m_fence->GetCompletedValue() >= value) {
+        return;
+    }
+    checkHResult(m_fence->SetEventOnCompletion(value, m_fenceEvent), "Failed to set event completion for frame fence!");
+    WaitForSingleObject(m_fenceEvent, INFINITE);
+}
+
+ID3D12GraphicsCommandList* RND_D3D12::GetFrameCommandList() {
+    if (!m_frameCmdListRecording) {
+        checkHResult(m_frameCmdList->Reset(GetFrameAllocator(), nullptr), "Failed to reset frame command list!");
+        m_frameCmdListRecording = true;
+        m_frameCmdList->EndQuery(m_timestampHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, m_frameSlot * 2);
+    }
+    return m_frameCmdList.Get();
+}
+
+void RND_D3D12::SubmitFrameCommands() {
+    if (!m_frameCmdListRecording) {
+        return;
+    }
+    m_frameCmdListRecording = false;
+
+    m_frameCmdList->EndQuery(m_timestampHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, m_frameSlot * 2 + 1);
+    m_frameCmdList->ResolveQueryData(m_timestampHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, m_frameSlot * 2, 2, m_timestampReadback.Get(), m_frameSlot * 2 * sizeof(uint64_t));
+    m_frames[m_frameSlot].wroteTimestamps = true;
+
+    checkHResult(m_frameCmdList->Close(), "Failed to close frame command list!");
+    ID3D12CommandList* collectedList[] = { m_frameCmdList.Get() };
+
+    for (auto& [texture, value] : m_frameWaitFor)
+        texture->d3d12WaitForFence(value);
+    m_queue->ExecuteCommandLists((UINT)std::size(collectedList), collectedList);
+    for (auto& [texture, value] : m_frameSignalTo)
+        texture->d3d12SignalFence(value);
+
+    // keeps the capacity around for the next frame
+    m_frameWaitFor.clear();
+    m_frameSignalTo.clear();
+}
+
+ID3D12GraphicsCommandList* RND_D3D12::BeginImmediateCommands() {
+    checkHResult(m_immediateAllocator->Reset(), "Failed to reset immediate command allocator!");
+    checkHResult(m_immediateCmdList->Reset(m_immediateAllocator.Get(), nullptr), "Failed to reset immediate command list!");
+    return m_immediateCmdList.Get();
+}
+
+void RND_D3D12::SubmitImmediateCommands(const std::vector<std::pair<Texture*, uint64_t>>& waitFor, const std::vector<std::pair<Texture*, uint64_t>>& signalTo) {
+    checkHResult(m_immediateCmdList->Close(), "Failed to close immediate command list!");
+    ID3D12CommandList* collectedList[] = { m_immediateCmdList.Get() };
+
+    for (auto& [texture, value] : waitFor)
+        texture->d3d12WaitForFence(value);
+    m_queue->ExecuteCommandLists((UINT)std::size(collectedList), collectedList);
+    for (auto& [texture, value] : signalTo)
+        texture->d3d12SignalFence(value);
+
+    // wait until the command list and the fence signal has been executed, which also makes the allocator safe to reset
+    checkHResult(m_queue->Signal(m_immediateFence.Get(), ++m_immediateFenceValue), "Failed to signal immediate fence!");
+    if (m_immediateFence->GetCompletedValue() < m_immediateFenceValue) {
+        checkHResult(m_immediateFence->SetEventOnCompletion(m_immediateFenceValue, m_immediateEvent), "Failed to set event completion for immediate fence!");
+        WaitForSingleObject(m_immediateEvent, INFINITE);
+    }
 }
 
 template <bool depth>
-RND_D3D12::PresentPipeline<depth>::PresentPipeline(RND_Renderer* pRenderer) {
+RND_D3D12::PresentPipeline<depth>::PresentPipeline(RND_Renderer* pRenderer, bool stereo): m_stereo(stereo), m_attachmentCount(depth ? (stereo ? 4 : 2) : 1) {
+    checkAssert(depth || !stereo, "Stereo rendering is only supported by the depth pipeline!");
+
     // This needs to know the format of the swapchain images, thus needs to wait until the swapchain images are created
-    m_vertexShader = D3D12Utils::CompileShader(depth ? presentDepthHLSL : presentHLSL, "VSMain", "vs_5_1");
-    m_pixelShader = D3D12Utils::CompileShader(depth ? presentDepthHLSL : presentHLSL, "PSMain", "ps_5_1");
+    const D3D_SHADER_MACRO stereoDefines[] = { { "STEREO", "1" }, { nullptr, nullptr } };
+    m_vertexShader = D3D12Utils::CompileShader(depth ? presentDepthHLSL : presentHLSL, "VSMain", "vs_5_1", stereo ? stereoDefines : nullptr);
+    m_pixelShader = D3D12Utils::CompileShader(depth ? presentDepthHLSL : presentHLSL, "PSMain", "ps_5_1", stereo ? stereoDefines : nullptr);
 
     auto createSignature = [this]() {
         // clang-format off
@@ -83,7 +244,7 @@ RND_D3D12::PresentPipeline<depth>::PresentPipeline(RND_Renderer* pRenderer) {
             // Input textures
             {
                 .RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV,
-                .NumDescriptors = (UINT)this->m_attachmentHandles.size(),
+                .NumDescriptors = this->m_attachmentCount,
                 .BaseShaderRegister = 0,
                 .RegisterSpace = 0,
                 .OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND
@@ -106,6 +267,15 @@ RND_D3D12::PresentPipeline<depth>::PresentPipeline(RND_Renderer* pRenderer) {
                     0
                 },
                 D3D12_SHADER_VISIBILITY_ALL
+            },
+            {
+                .ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS,
+                .Constants = {
+                    .ShaderRegister = 2,
+                    .RegisterSpace = 0,
+                    .Num32BitValues = sizeof(ReprojectionSettings) / sizeof(uint32_t)
+                },
+                .ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL
             }
         };
         // clang-format on
@@ -127,7 +297,8 @@ RND_D3D12::PresentPipeline<depth>::PresentPipeline(RND_Renderer* pRenderer) {
         };
 
         D3D12_ROOT_SIGNATURE_DESC rootSigDesc = {
-            .NumParameters = (UINT)std::size(rootParams),
+            // the reprojection constants are only used by the depth pipeline
+            .NumParameters = (UINT)std::size(rootParams) - (depth ? 0 : 1),
             .pParameters = rootParams,
             .NumStaticSamplers = 1,
             .pStaticSamplers = &textureSampler,
@@ -145,17 +316,19 @@ RND_D3D12::PresentPipeline<depth>::PresentPipeline(RND_Renderer* pRenderer) {
         return rootSigBlob;
     };
 
-    m_attachmentHeap = D3D12Utils::CreateDescriptorHeap(VRManager::instance().D3D12->GetDevice(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, true, (UINT)m_attachmentHandles.size());
+    m_attachmentHeap = D3D12Utils::CreateDescriptorHeap(VRManager::instance().D3D12->GetDevice(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, true, FRAMES_IN_FLIGHT * m_attachmentCount);
     m_targetHeap = D3D12Utils::CreateDescriptorHeap(VRManager::instance().D3D12->GetDevice(), D3D12_DESCRIPTOR_HEAP_TYPE_RTV, false, (UINT)m_targetHandles.size());
     if constexpr (depth) {
         m_depthHeap = D3D12Utils::CreateDescriptorHeap(VRManager::instance().D3D12->GetDevice(), D3D12_DESCRIPTOR_HEAP_TYPE_DSV, false, (UINT)m_depthTargetHandles.size());
     }
 
-    for (uint32_t i = 0; i < m_attachmentHandles.size(); i++) {
+    m_attachmentHandleSize = VRManager::instance().D3D12->GetDevice()->GetDescriptorHandleIncrementSize(m_attachmentHeap->GetDesc().Type);
+    for (uint32_t i = 0; i < FRAMES_IN_FLIGHT * m_attachmentCount; i++) {
         m_attachmentHandles[i] = m_attachmentHeap->GetCPUDescriptorHandleForHeapStart();
-        m_attachmentHandles[i].ptr += (i * VRManager::instance().D3D12->GetDevice()->GetDescriptorHandleIncrementSize(m_attachmentHeap->GetDesc().Type));
+        m_attachmentHandles[i].ptr += (i * m_attachmentHandleSize);
     }
 
+    // the render target and depth views only need to stay valid until they're recorded by OMSetRenderTargets, so one set of them is enough
     for (uint32_t i = 0; i < m_targetHandles.size(); i++) {
         m_targetHandles[i] = m_targetHeap->GetCPUDescriptorHandleForHeapStart();
         m_targetHandles[i].ptr += (i * VRManager::instance().D3D12->GetDevice()->GetDescriptorHandleIncrementSize(m_targetHeap->GetDesc().Type));
@@ -170,12 +343,9 @@ RND_D3D12::PresentPipeline<depth>::PresentPipeline(RND_Renderer* pRenderer) {
 
     // upload screen indices
     ComPtr<ID3D12Resource> screenIndicesStaging;
-    ComPtr<ID3D12CommandAllocator> uploadBufferAllocator;
     {
         ID3D12Device* device = VRManager::instance().D3D12->GetDevice();
-        ID3D12CommandQueue* queue = VRManager::instance().D3D12->GetCommandQueue();
-        device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&uploadBufferAllocator));
-        RND_D3D12::CommandContext<true> uploadBufferContext(device, queue, uploadBufferAllocator.Get(), [this, device, &screenIndicesStaging](RND_D3D12::CommandContext<true>* context) {
+        RND_D3D12::CommandContext<true> uploadBufferContext(VRManager::instance().D3D12.get(), [this, device, &screenIndicesStaging](RND_D3D12::CommandContext<true>* context) {
             m_screenIndicesBuffer = D3D12Utils::CreateConstantBuffer(device, D3D12_HEAP_TYPE_DEFAULT, sizeof(screenIndices));
 
             screenIndicesStaging = D3D12Utils::CreateConstantBuffer(device, D3D12_HEAP_TYPE_UPLOAD, sizeof(screenIndices));
@@ -204,14 +374,21 @@ void RND_D3D12::PresentPipeline<depth>::BindAttachment(uint32_t attachmentIdx, I
     srvDesc.Format = overwriteFormat != DXGI_FORMAT_UNKNOWN ? overwriteFormat : srcTexture->GetDesc().Format;
     srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
     srvDesc.Texture2D.MipLevels = 1;
-    VRManager::instance().D3D12->GetDevice()->CreateShaderResourceView(srcTexture, &srvDesc, m_attachmentHandles[attachmentIdx]);
+    const uint32_t frameSlot = VRManager::instance().D3D12->GetFrameSlot();
+    VRManager::instance().D3D12->GetDevice()->CreateShaderResourceView(srcTexture, &srvDesc, m_attachmentHandles[frameSlot * m_attachmentCount + attachmentIdx]);
 }
 
 template <bool depth>
 void RND_D3D12::PresentPipeline<depth>::BindTarget(uint32_t targetIdx, ID3D12Resource* dstTexture, DXGI_FORMAT overwriteFormat) {
     D3D12_RENDER_TARGET_VIEW_DESC rtvDesc = {};
     rtvDesc.Format = overwriteFormat != DXGI_FORMAT_UNKNOWN ? overwriteFormat : dstTexture->GetDesc().Format;
-    rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
+    if (m_stereo) {
+        rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
+        rtvDesc.Texture2DArray = { .MipSlice = 0, .FirstArraySlice = 0, .ArraySize = 2, .PlaneSlice = 0 };
+    }
+    else {
+        rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
+    }
     VRManager::instance().D3D12->GetDevice()->CreateRenderTargetView(dstTexture, &rtvDesc, m_targetHandles[targetIdx]);
 
     if (rtvDesc.Format != m_targetFormats[targetIdx]) {
@@ -224,7 +401,13 @@ template <bool depth>
 void RND_D3D12::PresentPipeline<depth>::BindDepthTarget(ID3D12Resource* dstTexture, DXGI_FORMAT overwriteFormat) {
     D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
     dsvDesc.Format = overwriteFormat != DXGI_FORMAT_UNKNOWN ? overwriteFormat : dstTexture->GetDesc().Format;
-    dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+    if (m_stereo) {
+        dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2DARRAY;
+        dsvDesc.Texture2DArray = { .MipSlice = 0, .FirstArraySlice = 0, .ArraySize = 2 };
+    }
+    else {
+        dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+    }
     dsvDesc.Flags = D3D12_DSV_FLAG_NONE;
     VRManager::instance().D3D12->GetDevice()->CreateDepthStencilView(dstTexture, &dsvDesc, m_depthTargetHandles[0]);
 
@@ -237,12 +420,9 @@ void RND_D3D12::PresentPipeline<depth>::BindDepthTarget(ID3D12Resource* dstTextu
 template <bool depth>
 void RND_D3D12::PresentPipeline<depth>::BindSettings(float screenWidth, float screenHeight) {
     ComPtr<ID3D12Resource> newSettingsStaging;
-    ComPtr<ID3D12CommandAllocator> newSettingsAllocator;
     {
         ID3D12Device* device = VRManager::instance().D3D12->GetDevice();
-        ID3D12CommandQueue* queue = VRManager::instance().D3D12->GetCommandQueue();
-        device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&newSettingsAllocator));
-        RND_D3D12::CommandContext<true> uploadBufferContext(device, queue, newSettingsAllocator.Get(), [this, device, &newSettingsStaging, screenWidth, screenHeight](RND_D3D12::CommandContext<true>* context) {
+        RND_D3D12::CommandContext<true> uploadBufferContext(VRManager::instance().D3D12.get(), [this, device, &newSettingsStaging, screenWidth, screenHeight](RND_D3D12::CommandContext<true>* context) {
             m_settingsBuffer = D3D12Utils::CreateConstantBuffer(device, D3D12_HEAP_TYPE_DEFAULT, sizeof(presentSettings));
 
             newSettingsStaging = D3D12Utils::CreateConstantBuffer(device, D3D12_HEAP_TYPE_UPLOAD, sizeof(presentSettings));
@@ -263,6 +443,33 @@ void RND_D3D12::PresentPipeline<depth>::BindSettings(float screenWidth, float sc
     }
 }
 
+template <bool depth>
+void RND_D3D12::PresentPipeline<depth>::BindReprojection(const XrView& srcView, const XrView& dstView, float nearZ, float farZ) {
+    checkAssert(depth, "Reprojection requires the depth of the source view!");
+
+    const glm::fmat4 srcPose = ToMat4(ToGLM(srcView.pose.position), ToGLM(srcView.pose.orientation));
+    const glm::fmat4 dstPose = ToMat4(ToGLM(dstView.pose.position), ToGLM(dstView.pose.orientation));
+    const glm::fmat4 dstToSrc = glm::inverse(srcPose) * dstPose;
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 4; column++) {
+            m_reprojection.dstToSrc[row][column] = dstToSrc[column][row];
+        }
+    }
+
+    auto toTangents = [](const XrFovf& fov, float (&tangents)[4]) {
+        tangents[0] = std::tan(fov.angleLeft);
+        tangents[1] = std::tan(fov.angleRight);
+        tangents[2] = std::tan(fov.angleUp);
+        tangents[3] = std::tan(fov.angleDown);
+    };
+    toTangents(srcView.fov, m_reprojection.srcTangents);
+    toTangents(dstView.fov, m_reprojection.dstTangents);
+
+    m_reprojection.nearZ = nearZ;
+    m_reprojection.farZ = farZ;
+    m_reprojection.enabled = 1;
+}
+
 template <bool depth>
 void RND_D3D12::PresentPipeline<depth>::RecreatePipeline() {
     // AMD GPU FIX: Don't declare SV_InstanceID/SV_VertexID in the input layout.
@@ -341,26 +548,33 @@ void RND_D3D12::PresentPipeline<depth>::RecreatePipeline() {
 }
 
 template <bool depth>
-void RND_D3D12::PresentPipeline<depth>::Render(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* swapchain) {
+void RND_D3D12::PresentPipeline<depth>::Render(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* swapchain, std::optional<XrExtent2Di> renderExtent) {
     cmdList->SetPipelineState(m_pipelineState.Get());
     cmdList->SetGraphicsRootSignature(m_signature.Get());
 
     // set framebuffer
-    D3D12_VIEWPORT viewportSize = { 0.0f, 0.0f, (float)swapchain->GetDesc().Width, (float)swapchain->GetDesc().Height, 0.0f, 1.0f };
+    const D3D12_RESOURCE_DESC swapchainDesc = swapchain->GetDesc();
+    const XrExtent2Di extent = renderExtent.value_or(XrExtent2Di{ (int32_t)swapchainDesc.Width, (int32_t)swapchainDesc.Height });
+    D3D12_VIEWPORT viewportSize = { 0.0f, 0.0f, (float)extent.width, (float)extent.height, 0.0f, 1.0f };
     cmdList->RSSetViewports(1, &viewportSize);
 
-    D3D12_RECT scissorRect = { 0, 0, (LONG)swapchain->GetDesc().Width, (LONG)swapchain->GetDesc().Height };
+    D3D12_RECT scissorRect = { 0, 0, (LONG)extent.width, (LONG)extent.height };
     cmdList->RSSetScissorRects(1, &scissorRect);
 
     // set settings
     checkAssert(m_settingsBuffer != nullptr, "Failed to present texture since graphics pipeline hasn't bound some settings yet!");
     cmdList->SetGraphicsRootConstantBufferView(1, m_settingsBuffer->GetGPUVirtualAddress());
+    if constexpr (depth) {
+        cmdList->SetGraphicsRoot32BitConstants(2, sizeof(ReprojectionSettings) / sizeof(uint32_t), &m_reprojection, 0);
+    }
 
     // set shared texture
     ID3D12DescriptorHeap* heaps[] = { m_attachmentHeap.Get() };
     cmdList->SetDescriptorHeaps((UINT)std::size(heaps), heaps);
 
-    cmdList->SetGraphicsRootDescriptorTable(0, m_attachmentHeap->GetGPUDescriptorHandleForHeapStart());
+    D3D12_GPU_DESCRIPTOR_HANDLE attachmentTable = m_attachmentHeap->GetGPUDescriptorHandleForHeapStart();
+    attachmentTable.ptr += (uint64_t)VRManager::instance().D3D12->GetFrameSlot() * m_attachmentCount * m_attachmentHandleSize;
+    cmdList->SetGraphicsRootDescriptorTable(0, attachmentTable);
 
     // set render target
     cmdList->OMSetRenderTargets(1, &m_targetHandles[0], true, depth ? &m_depthTargetHandles[0] : nullptr);
@@ -371,7 +585,8 @@ void RND_D3D12::PresentPipeline<depth>::Render(ID3D12GraphicsCommandList* cmdLis
 
     cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     cmdList->IASetIndexBuffer(&m_screenIndicesView);
-    cmdList->DrawIndexedInstanced((UINT)std::size(screenIndices), 1, 0, 0, 0);
+    // the instance is the eye, which also selects the layer of the render targets with stereo
+    cmdList->DrawIndexedInstanced((UINT)std::size(screenIndices), m_stereo ? 2 : 1, 0, 0, 0);
 }
 
 template class RND_D3D12::PresentPipeline<false>;
@@ -13,24 +13,17 @@ public:
 
     ID3D12CommandQueue* GetCommandQueue() { return m_queue.Get(); };
 
-    void StartFrame() {
-        checkHResult(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&m_allocator)), "Failed to created D3D12_CommandContext's allocator!");
-    }
-    void EndFrame() {
-        // Wait for GPU to finish queue
-        checkHResult(m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)), "Failed to create fence for end-of-frame waiting!");
-        checkHResult(m_queue->Signal(m_fence.Get(), 1), "Failed to signal fence for end-of-frame waiting!");
-
-        HANDLE waitEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
-        checkAssert(waitEvent != NULL, "Failed to create upload event!");
-        checkHResult(m_fence->SetEventOnCompletion(1, waitEvent), "Failed to set event completion for end-of-frame waiting!");
-        WaitForSingleObject(waitEvent, INFINITE);
-
-        // Reset allocator after queue is finished
-        m_allocator->Reset();
-    };
+    static constexpr uint32_t FRAMES_IN_FLIGHT = 2;
+
+    void StartFrame();
+    void EndFrame();
+    void WaitForFenceValue(uint64_t value);
+
+    ID3D12CommandAllocator* GetFrameAllocator() { return m_frames[m_frameSlot].allocator.Get(); };
+    uint32_t GetFrameSlot() const { return m_frameSlot; };
 
-    ID3D12CommandAllocator* GetFrameAllocator() { return m_allocator.Get(); };
+    // how long the GPU spent on the most recent frame command list that finished executing
+    double GetLastFrameGpuMs() const { return m_lastFrameGpuMs; };
 
     // todo: extract most to a base pipeline class if other pipelines are needed
     template <bool depth>
@@ -38,18 +31,40 @@ public:
         friend class Texture;
 
     public:
-        explicit PresentPipeline(RND_Renderer* pRenderer);
+        // stereo renders both eyes with one instanced draw into the two layers of array swapchain images, only supported by the depth pipeline.
+        // The second eye's attachments are then bound after the first eye's, so attachments 2 and 3.
+        explicit PresentPipeline(RND_Renderer* pRenderer, bool stereo = false);
         ~PresentPipeline() = default;
 
         void BindAttachment(uint32_t attachmentIdx, ID3D12Resource* srcTexture, DXGI_FORMAT overwriteFormat = DXGI_FORMAT_UNKNOWN);
         void BindTarget(uint32_t targetIdx, ID3D12Resource* dstTexture, DXGI_FORMAT overwriteFormat = DXGI_FORMAT_UNKNOWN);
         void BindDepthTarget(ID3D12Resource* dstTexture, DXGI_FORMAT overwriteFormat);
         void BindSettings(float screenWidth, float screenHeight);
-        void Render(ID3D12GraphicsCommandList* commandList, ID3D12Resource* swapchain);
+        // only used by the depth pipeline, makes the next Render() reconstruct dstView from attachments that were rendered from srcView.
+        // With stereo that's the second eye, reconstructed from the first eye's attachments.
+        void BindReprojection(const XrView& srcView, const XrView& dstView, float nearZ, float farZ);
+        void ClearReprojection() { m_reprojection = {}; }
+        // renders to the top-left renderExtent of the swapchain image, or the whole image if there's none
+        void Render(ID3D12GraphicsCommandList* commandList, ID3D12Resource* swapchain, std::optional<XrExtent2Di> renderExtent = std::nullopt);
 
     private:
         void RecreatePipeline();
 
+        // passed as root constants, layout matches g_reprojection in presentDepthHLSL
+        struct ReprojectionSettings {
+            float dstToSrc[3][4]; // row-major, view space of the destination eye to the view space of the source eye
+            float srcTangents[4]; // left, right, up, down
+            float dstTangents[4];
+            float nearZ;
+            float farZ;
+            uint32_t enabled;
+            uint32_t padding;
+        };
+        ReprojectionSettings m_reprojection = {};
+
+        bool m_stereo;
+        uint32_t m_attachmentCount;
+
         ComPtr<ID3DBlob> m_vertexShader;
         ComPtr<ID3DBlob> m_pixelShader;
 
@@ -61,7 +76,9 @@ public:
         ComPtr<ID3D12RootSignature> m_signature;
         ComPtr<ID3D12PipelineState> m_pipelineState;
 
-        std::array<D3D12_CPU_DESCRIPTOR_HANDLE, depth ? 2 : 1> m_attachmentHandles = {};
+        // each frame slot binds its own range of attachment descriptors, the GPU can still be reading the previous frame's range
+        std::array<D3D12_CPU_DESCRIPTOR_HANDLE, FRAMES_IN_FLIGHT * (depth ? 4 : 1)> m_attachmentHandles = {};
+        uint32_t m_attachmentHandleSize = 0;
         std::array<D3D12_CPU_DESCRIPTOR_HANDLE, 1> m_targetHandles = {};
         std::array<D3D12_CPU_DESCRIPTOR_HANDLE, depth ? 1 : 0> m_depthTargetHandles = {};
         ComPtr<ID3D12DescriptorHeap> m_attachmentHeap;
@@ -70,61 +87,88 @@ public:
         std::array<DXGI_FORMAT, 2> m_targetFormats = { DXGI_FORMAT_UNKNOWN, DXGI_FORMAT_D32_FLOAT };
     };
 
+    // Non-blocking contexts record into the frame's pooled command list, which only gets submitted once per frame by SubmitFrameCommands().
+    // Blocking contexts use a separate pooled command list that's executed and waited on when the context goes out of scope.
     template <bool blockTillExecuted>
     class CommandContext {
     public:
         template <typename F>
-        CommandContext(ID3D12Device* d3d12Device, ID3D12CommandQueue* d3d12Queue, ID3D12CommandAllocator* d3d12Allocator, F&& recordCallback): m_device(d3d12Device), m_queue(d3d12Queue) {
-            // Create commands to upload buffers
-            checkHResult(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, d3d12Allocator, nullptr, IID_PPV_ARGS(&this->m_cmdList)), "Failed to create D3D12_CommandContext's command list!");
+        CommandContext(RND_D3D12* d3d12, F&& recordCallback): m_d3d12(d3d12) {
+            if constexpr (blockTillExecuted) {
+                m_immediateLock = std::unique_lock(m_d3d12->m_immediateMutex);
+                m_cmdList = m_d3d12->BeginImmediateCommands();
+            }
+            else {
+                m_cmdList = m_d3d12->GetFrameCommandList();
+            }
 
             recordCallback(this);
         }
 
         ~CommandContext() {
-            // Close command list and then execute command list in queue
-            checkHResult(this->m_cmdList->Close(), "Failed to close D3D12_CommandContext's queue");
-            ID3D12CommandList* collectedList[] = { this->m_cmdList.Get() };
-
-            for (auto& [texture, value] : this->m_waitFor)
-                texture->d3d12WaitForFence(value);
-            m_queue->ExecuteCommandLists((UINT)std::size(collectedList), collectedList);
-            for (auto& [texture, value] : this->m_signalTo)
-                texture->d3d12SignalFence(value);
-
-            // If enabled, wait until the command list and the fence signal has been executed
             if constexpr (blockTillExecuted) {
-                m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&this->m_blockFence));
-                m_queue->Signal(this->m_blockFence.Get(), 1);
-
-                HANDLE waitEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
-                checkAssert(waitEvent != NULL, "Failed to create upload event!");
-
-                if (this->m_blockFence->GetCompletedValue() < 1) {
-                    this->m_blockFence->SetEventOnCompletion(1, waitEvent);
-                    WaitForSingleObject(waitEvent, INFINITE);
-                }
-                CloseHandle(waitEvent);
+                m_d3d12->SubmitImmediateCommands(m_waitFor, m_signalTo);
             }
         }
 
-        ID3D12GraphicsCommandList* GetRecordList() { return this->m_cmdList.Get(); }
-        void WaitFor(Texture* texture, uint64_t value) { this->m_waitFor.push_back({ texture, value }); }
-        void Signal(Texture* texture, uint64_t value) { this->m_signalTo.push_back({ texture, value }); }
+        ID3D12GraphicsCommandList* GetRecordList() { return this->m_cmdList; }
+        void WaitFor(Texture* texture, uint64_t value) {
+            if constexpr (blockTillExecuted) this->m_waitFor.emplace_back(texture, value);
+            else m_d3d12->m_frameWaitFor.emplace_back(texture, value);
+        }
+        void Signal(Texture* texture, uint64_t value) {
+            if constexpr (blockTillExecuted) this->m_signalTo.emplace_back(texture, value);
+            else m_d3d12->m_frameSignalTo.emplace_back(texture, value);
+        }
 
     private:
-        ID3D12Device* m_device;
-        ID3D12CommandQueue* m_queue;
-
-        ComPtr<ID3D12GraphicsCommandList> m_cmdList;
-        ComPtr<ID3D12Fence> m_blockFence;
+        RND_D3D12* m_d3d12;
+        ID3D12GraphicsCommandList* m_cmdList = nullptr;
+        std::unique_lock<std::mutex> m_immediateLock;
         std::vector<std::pair<Texture*, uint64_t>> m_waitFor;
         std::vector<std::pair<Texture*, uint64_t>> m_signalTo;
     };
 
+    ID3D12GraphicsCommandList* GetFrameCommandList();
+    void SubmitFrameCommands();
+
 private:
     ComPtr<ID3D12Device> m_device;
     ComPtr<ID3D12CommandQueue> m_queue;
-    ComPtr<ID3D12CommandAllocator> m_allocator;
+
+    // Per-frame resources, matching the renderer's double-buffered RenderFrames
+    struct FrameResources {
+        ComPtr<ID3D12CommandAllocator> allocator;
+        uint64_t fenceValue = 0;
+        bool wroteTimestamps = false;
+    };
+    std::array<FrameResources, FRAMES_IN_FLIGHT> m_frames;
+    uint32_t m_frameSlot = 0;
+
     ComPtr<ID3D12Fence> m_fence;
+    uint64_t m_lastSignalledValue = 0;
+    HANDLE m_fenceEvent = nullptr;
+
+    // All of a frame's layer rendering gets recorded into this list and submitted in one go
+    ComPtr<ID3D12GraphicsCommandList> m_frameCmdList;
+    bool m_frameCmdListRecording = false;
+    std::vector<std::pair<Texture*, uint64_t>> m_frameWaitFor;
+    std::vector<std::pair<Texture*, uint64_t>> m_frameSignalTo;
+
+    // Two timestamps per frame slot around the frame's command list, read back once the slot's fence has been reached
+    ComPtr<ID3D12QueryHeap> m_timestampHeap;
+    ComPtr<ID3D12Resource> m_timestampReadback;
+    uint64_t m_timestampFrequency = 0;
+    double m_lastFrameGpuMs = 0.0;
+
+    // Used for one-off blocking uploads, which can happen from other threads than the frame loop
+    ID3D12GraphicsCommandList* BeginImmediateCommands();
+    void SubmitImmediateCommands(const std::vector<std::pair<Texture*, uint64_t>>& waitFor, const std::vector<std::pair<Texture*, uint64_t>>& signalTo);
+
+    std::mutex m_immediateMutex;
+    ComPtr<ID3D12CommandAllocator> m_immediateAllocator;
+    ComPtr<ID3D12GraphicsCommandList> m_immediateCmdList;
+    ComPtr<ID3D12Fence> m_immediateFence;
+    uint64_t m_immediateFenceValue = 0;
+    HANDLE m_immediateEvent = nullptr;
 };
\ No newline at end of file
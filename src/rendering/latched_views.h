@@ -0,0 +1,32 @@
+#pragma once
+#include "utils/seqlock.h"
+
+// The views that each eye of a frame was rendered with, which get submitted in the projection views regardless of how old they are by then.
+// Only the camera hooks on Cemu's CPU thread latch and reset them, while Cemu's Vulkan thread and the presenting code read them,
+// so both eyes are published together through a SeqLock and readers never see a half-written view.
+template <typename View>
+class LatchedViews {
+public:
+    using Views = std::array<View, 2>;
+
+    // The left eye is the first pass of a game frame, so it replaces whatever views an earlier use of this frame slot left behind.
+    // Until the right eye gets latched it uses the same views as the left eye.
+    void Latch(size_t side, const Views& currViews) {
+        std::optional<Views> views = m_views.Load();
+        if (side == 0 || !views.has_value()) {
+            views = currViews;
+        }
+        else {
+            views.value()[side] = currViews[side];
+        }
+        m_views.Store(views);
+    }
+
+    // nothing when neither eye was latched since the last reset
+    std::optional<Views> Get() const { return m_views.Load(); }
+
+    void Reset() { m_views.Store(std::nullopt); }
+
+private:
+    SeqLock<std::optional<Views>> m_views;
+};
@@ -0,0 +1,127 @@
+#include "catch.h"
+#include "latched_views.h"
+
+#include <thread>
+
+namespace {
+    // stands in for XrView, every field depends on the locate call and eye it came from so torn copies stand out
+    struct TestView {
+        uint64_t locateIdx;
+        uint32_t side;
+        float yawDegrees;
+        uint64_t check;
+
+        bool IsConsistent() const {
+            return check == (locateIdx * 2 + side) && yawDegrees == (float)locateIdx;
+        }
+    };
+
+    using TestViews = LatchedViews<TestView>::Views;
+
+    // Mock of the runtime's xrLocateViews, the head turns a degree further every time the views are located
+    class MockRuntime {
+    public:
+        TestViews LocateViews() {
+            m_locateIdx++;
+            return { MakeView(0), MakeView(1) };
+        }
+
+    private:
+        TestView MakeView(uint32_t side) const {
+            return { m_locateIdx, side, (float)m_locateIdx, m_locateIdx * 2 + side };
+        }
+
+        uint64_t m_locateIdx = 0;
+    };
+}
+
+TEST_CASE("LatchedViews keep the views each eye was rendered with", "[latched_views]") {
+    MockRuntime runtime;
+    LatchedViews<TestView> frame;
+    CHECK_FALSE(frame.Get().has_value());
+
+    // StartFrame locates the views that the left eye's pass gets rendered with
+    const TestViews startViews = runtime.LocateViews();
+    frame.Latch(0, startViews);
+    REQUIRE(frame.Get().has_value());
+    CHECK(frame.Get()->at(0).locateIdx == 1);
+    // until the right eye's pass starts, it has the same views as the left eye
+    CHECK(frame.Get()->at(1).locateIdx == 1);
+
+    // the right eye's pass starts after the views were located again
+    const TestViews rightEyeViews = runtime.LocateViews();
+    frame.Latch(1, rightEyeViews);
+    CHECK(frame.Get()->at(0).locateIdx == 1);
+    CHECK(frame.Get()->at(1).locateIdx == 2);
+
+    // EndFrame locates the views once more, which only changes what the game logic sees next, not what gets submitted
+    const TestViews lateViews = runtime.LocateViews();
+    const std::optional<TestViews> submittedViews = frame.Get();
+    REQUIRE(submittedViews.has_value());
+    CHECK(submittedViews->at(0).yawDegrees == 1.0f);
+    CHECK(submittedViews->at(1).yawDegrees == 2.0f);
+    CHECK(lateViews[0].yawDegrees - submittedViews->at(0).yawDegrees == 2.0f);
+
+    frame.Reset();
+    CHECK_FALSE(frame.Get().has_value());
+}
+
+TEST_CASE("LatchedViews start over with the left eye of the next frame", "[latched_views]") {
+    MockRuntime runtime;
+    LatchedViews<TestView> frame;
+
+    // a right eye without a left eye before it, like the first frame after the session started
+    frame.Latch(1, runtime.LocateViews());
+    REQUIRE(frame.Get().has_value());
+    CHECK(frame.Get()->at(0).locateIdx == 1);
+    CHECK(frame.Get()->at(1).locateIdx == 1);
+
+    // the frame slot gets reused without being presented, the left eye replaces both views
+    runtime.LocateViews();
+    frame.Latch(0, runtime.LocateViews());
+    CHECK(frame.Get()->at(0).locateIdx == 3);
+    CHECK(frame.Get()->at(1).locateIdx == 3);
+    CHECK(frame.Get()->at(1).side == 1);
+}
+
+TEST_CASE("LatchedViews are never torn while the camera hooks latch them", "[latched_views]") {
+    constexpr uint32_t FRAME_COUNT = 2000;
+
+    LatchedViews<TestView> frame;
+    std::atomic_bool done = false;
+
+    // Cemu's CPU thread, which runs the camera hooks that latch both eyes and EndFrame, which resets the frame after presenting it
+    std::jthread cpuThread([&] {
+        MockRuntime runtime;
+        for (uint32_t i = 0; i < FRAME_COUNT; i++) {
+            frame.Latch(0, runtime.LocateViews());
+            frame.Latch(1, runtime.LocateViews());
+            if (i % 2 == 0) {
+                frame.Reset();
+            }
+            std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    // Cemu's Vulkan thread and the presenting code, which read the views at any point of the frame
+    uint64_t reads = 0;
+    uint64_t lastLeftLocateIdx = 0;
+    while (!done || reads == 0) {
+        const std::optional<TestViews> views = frame.Get();
+        reads++;
+        if (!views.has_value()) {
+            continue;
+        }
+        REQUIRE(views->at(0).side == 0);
+        REQUIRE(views->at(1).side == 1);
+        REQUIRE(views->at(0).IsConsistent());
+        REQUIRE(views->at(1).IsConsistent());
+        // the right eye is either latched together with the left eye or after it
+        REQUIRE(views->at(1).locateIdx >= views->at(0).locateIdx);
+        REQUIRE(views->at(0).locateIdx >= lastLeftLocateIdx);
+        lastLeftLocateIdx = views->at(0).locateIdx;
+    }
+    cpuThread.join();
+    CHECK(reads > 0);
+}
@@ -471,14 +471,14 @@ std::optional<OpenXR::InputState> OpenXR::UpdateActions(XrTime predictedFrameTim
     syncInfo.activeActionSets = &activeActionSet;
     checkXRResult(xrSyncActions(m_session, &syncInfo), "Failed to sync actions!");
 
-    const float playerHeightOffsetMeters = CemuHooks::GetSettings().playerHeightSetting.getLE();
+    const float playerHeightOffsetMeters = CemuHooks::GetSettings().GetPlayerHeight();
 
-    InputState newState = m_input.load();
+    InputState newState = m_input.Load();
     newState.inGame.in_game = !inMenu;
     newState.inGame.inputTime = predictedFrameTime;
-    //newState.inGame.lastPickupSide = m_input.load().inGame.lastPickupSide;
-    //newState.inGame.grabState = m_input.load().inGame.grabState;
-    //newState.inGame.mapAndInventoryState = m_input.load().inGame.mapAndInventoryState;
+    //newState.inGame.lastPickupSide = m_input.Load().inGame.lastPickupSide;
+    //newState.inGame.grabState = m_input.Load().inGame.grabState;
+    //newState.inGame.mapAndInventoryState = m_input.Load().inGame.mapAndInventoryState;
 
     if (inMenu) {
         XrActionStateGetInfo getScrollInfo = { XR_TYPE_ACTION_STATE_GET_INFO };
@@ -571,7 +571,7 @@ std::optional<OpenXR::InputState> OpenXR::UpdateActions(XrTime predictedFrameTim
                             // rotate angular velocity to world space when it's using a buggy runtime
                             auto mode = CemuHooks::GetSettings().AngularVelocityFixer_GetMode();
                             bool isUsingQuestRuntime = m_capabilities.isOculusLinkRuntime;
-                            if ((mode == data_VRSettingsIn::AngularVelocityFixerMode::AUTO && isUsingQuestRuntime) || mode == data_VRSettingsIn::AngularVelocityFixerMode::FORCED_ON) {
+                            if ((mode == VRSettings::AngularVelocityFixerMode::AUTO && isUsingQuestRuntime) || mode == VRSettings::AngularVelocityFixerMode::FORCED_ON) {
                                 glm::vec3 angularVelocity = ToGLM(spaceVelocity.angularVelocity);
                                 glm::fquat fix_angle = glm::fquat(0.924, -0.383, 0, 0);
                                 angularVelocity = (ToGLM(spaceLocation.pose.orientation) * (fix_angle * angularVelocity)); // TOD: Contact other modders for similar issues with angular velocity being not on the grip rotation (quest 2) + Tune the angular velocity based on manually calculated on rotation positions
@@ -701,7 +701,7 @@ std::optional<OpenXR::InputState> OpenXR::UpdateActions(XrTime predictedFrameTim
         newState.inGame.rightTrigger = { XR_TYPE_ACTION_STATE_BOOLEAN };
         checkXRResult(xrGetActionStateBoolean(m_session, &getRightTriggerInfo, &newState.inGame.rightTrigger), "Failed to get right trigger action value!");
     }
-    this->m_input.store(newState);
+    this->m_input.Store(newState);
     return newState;
 }
 
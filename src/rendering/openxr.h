@@ -1,6 +1,7 @@
 #pragma once
 
 #include "hooking/rumble.h"
+#include "utils/seqlock.h"
 
 class OpenXR {
     friend class RND_Renderer;
@@ -48,7 +49,6 @@ public:
             XrActionStateBoolean cancel;
             XrActionStateBoolean interact;
             std::array<XrActionStateFloat, 2> grab;
-            std::array<bool, 2> drop_weapon; // LEFT/RIGHT
 
             struct ButtonState {
                 enum class Event {
@@ -106,7 +106,8 @@ public:
             XrActionStateBoolean rightGrip;
         } inMenu;
     };
-    std::atomic<InputState> m_input = InputState{};
+    // only written by UpdateActions on the render thread
+    SeqLock<InputState> m_input;
     std::atomic<glm::fquat> m_inputCameraRotation = glm::identity<glm::fquat>();
 
     struct GameState {
@@ -117,9 +118,11 @@ public:
         std::chrono::steady_clock::time_point prevent_menu_time;
         bool prevent_grab_inputs = false;
         std::chrono::steady_clock::time_point prevent_grab_time;
+        std::array<bool, 2> drop_weapon = { false, false }; // LEFT/RIGHT
     } gameState ;
 
-    std::atomic<GameState> m_gameState{};
+    // only written by hook_InjectXRInput
+    SeqLock<GameState> m_gameState;
 
     void CreateSession(const XrGraphicsBindingD3D12KHR& d3d12Binding);
     void CreateActions();
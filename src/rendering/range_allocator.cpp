@@ -0,0 +1,49 @@
+#include "range_allocator.h"
+
+std::optional<uint64_t> RangeAllocator::Allocate(uint64_t size, uint64_t alignment) {
+    for (size_t i = 0; i < m_freeRanges.size(); i++) {
+        Range& range = m_freeRanges[i];
+        const uint64_t alignedOffset = (range.offset + alignment - 1) & ~(alignment - 1);
+        const uint64_t padding = alignedOffset - range.offset;
+        if (range.size < padding + size) {
+            continue;
+        }
+
+        // the padding in front of the allocation stays free, as does whatever is left behind it
+        const uint64_t remainingOffset = alignedOffset + size;
+        const uint64_t remainingSize = range.offset + range.size - remainingOffset;
+        if (padding > 0) {
+            range.size = padding;
+            if (remainingSize > 0) {
+                m_freeRanges.insert(m_freeRanges.begin() + (ptrdiff_t)i + 1, { remainingOffset, remainingSize });
+            }
+        }
+        else if (remainingSize > 0) {
+            range = { remainingOffset, remainingSize };
+        }
+        else {
+            m_freeRanges.erase(m_freeRanges.begin() + (ptrdiff_t)i);
+        }
+
+        m_allocationCount++;
+        return alignedOffset;
+    }
+    return std::nullopt;
+}
+
+void RangeAllocator::Free(uint64_t offset, uint64_t size) {
+    // insert the range back in order and merge it with its neighbours
+    auto next = std::ranges::lower_bound(m_freeRanges, offset, {}, &Range::offset);
+    auto it = m_freeRanges.insert(next, { offset, size });
+    if (auto after = it + 1; after != m_freeRanges.end() && it->offset + it->size == after->offset) {
+        it->size += after->size;
+        m_freeRanges.erase(after);
+    }
+    if (it != m_freeRanges.begin()) {
+        if (auto before = it - 1; before->offset + before->size == it->offset) {
+            before->size += it->size;
+            m_freeRanges.erase(it);
+        }
+    }
+    m_allocationCount--;
+}
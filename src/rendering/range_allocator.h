@@ -0,0 +1,28 @@
+#pragma once
+
+// First-fit allocator for ranges of a fixed-size block, used to suballocate image memory from RND_Vulkan's memory blocks.
+// Free ranges are kept sorted by offset and adjacent ones are always merged, so freeing everything leaves a single range.
+// Only keeps track of offsets and doesn't need Vulkan, so the host build can test it. Not thread-safe.
+class RangeAllocator {
+public:
+    struct Range {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    explicit RangeAllocator(uint64_t size): m_size(size), m_freeRanges{ { 0, size } } {}
+
+    // alignment has to be a power of two, returns the offset or nothing if no free range is large enough
+    std::optional<uint64_t> Allocate(uint64_t size, uint64_t alignment);
+    // size has to be the one that was allocated at the offset
+    void Free(uint64_t offset, uint64_t size);
+
+    uint64_t GetSize() const { return m_size; }
+    uint32_t GetAllocationCount() const { return m_allocationCount; }
+    const std::vector<Range>& GetFreeRanges() const { return m_freeRanges; }
+
+private:
+    uint64_t m_size;
+    uint32_t m_allocationCount = 0;
+    std::vector<Range> m_freeRanges;
+};
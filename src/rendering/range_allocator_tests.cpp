@@ -0,0 +1,122 @@
+#include "catch.h"
+#include "range_allocator.h"
+
+#include <random>
+
+namespace {
+    constexpr uint64_t MiB = 1024 * 1024;
+
+    bool Overlaps(const RangeAllocator::Range& lhs, const RangeAllocator::Range& rhs) {
+        return lhs.offset < rhs.offset + rhs.size && rhs.offset < lhs.offset + lhs.size;
+    }
+}
+
+TEST_CASE("RangeAllocator aligns allocations and keeps the padding free", "[range_allocator]") {
+    RangeAllocator allocator(64 * MiB);
+
+    CHECK(allocator.Allocate(100, 1) == 0u);
+    // the next 64 KiB aligned offset, the bytes from 100 up to it stay free
+    CHECK(allocator.Allocate(4096, 64 * 1024) == 64 * 1024u);
+    REQUIRE(allocator.GetFreeRanges().size() == 2);
+    CHECK(allocator.GetFreeRanges()[0].offset == 100);
+    CHECK(allocator.GetFreeRanges()[0].size == 64 * 1024 - 100);
+    CHECK(allocator.GetFreeRanges()[1].offset == 64 * 1024 + 4096);
+
+    // the padding gets used by later allocations that fit into it
+    CHECK(allocator.Allocate(256, 256) == 256u);
+    CHECK(allocator.GetAllocationCount() == 3);
+}
+
+TEST_CASE("RangeAllocator splits free ranges and fails when nothing fits", "[range_allocator]") {
+    RangeAllocator allocator(16 * MiB);
+
+    CHECK(allocator.Allocate(8 * MiB, 4096) == 0u);
+    CHECK(allocator.Allocate(4 * MiB, 4096) == 8 * MiB);
+    REQUIRE(allocator.GetFreeRanges().size() == 1);
+    CHECK(allocator.GetFreeRanges()[0].offset == 12 * MiB);
+    CHECK(allocator.GetFreeRanges()[0].size == 4 * MiB);
+
+    CHECK_FALSE(allocator.Allocate(4 * MiB + 1, 1).has_value());
+    // fits exactly, which uses up the last free range
+    CHECK(allocator.Allocate(4 * MiB, 4096) == 12 * MiB);
+    CHECK(allocator.GetFreeRanges().empty());
+    CHECK_FALSE(allocator.Allocate(1, 1).has_value());
+    CHECK(allocator.GetAllocationCount() == 3);
+}
+
+TEST_CASE("RangeAllocator merges freed ranges with their neighbours", "[range_allocator]") {
+    RangeAllocator allocator(4 * MiB);
+    const uint64_t a = allocator.Allocate(MiB, 4096).value();
+    const uint64_t b = allocator.Allocate(MiB, 4096).value();
+    const uint64_t c = allocator.Allocate(MiB, 4096).value();
+
+    allocator.Free(a, MiB);
+    allocator.Free(c, MiB);
+    REQUIRE(allocator.GetFreeRanges().size() == 2);
+    CHECK(allocator.GetFreeRanges()[0].offset == a);
+    CHECK(allocator.GetFreeRanges()[1].offset == c);
+    CHECK(allocator.GetFreeRanges()[1].size == 2 * MiB);
+
+    // freeing the range in between joins everything back into the whole block
+    allocator.Free(b, MiB);
+    REQUIRE(allocator.GetFreeRanges().size() == 1);
+    CHECK(allocator.GetFreeRanges()[0].offset == 0);
+    CHECK(allocator.GetFreeRanges()[0].size == 4 * MiB);
+    CHECK(allocator.GetAllocationCount() == 0);
+    CHECK(allocator.Allocate(4 * MiB, 4096) == 0u);
+}
+
+TEST_CASE("RangeAllocator never hands out overlapping ranges", "[range_allocator]") {
+    // images of a few render target sizes getting created and destroyed in random order
+    RangeAllocator allocator(64 * MiB);
+    std::mt19937 random(1234);
+    std::vector<RangeAllocator::Range> allocations;
+
+    for (uint32_t i = 0; i < 5000; i++) {
+        if (!allocations.empty() && random() % 3 == 0) {
+            const size_t victim = random() % allocations.size();
+            allocator.Free(allocations[victim].offset, allocations[victim].size);
+            allocations.erase(allocations.begin() + (ptrdiff_t)victim);
+            continue;
+        }
+
+        const uint64_t size = (random() % 2048 + 1) * 1024;
+        const uint64_t alignment = 1ull << (random() % 17);
+        const std::optional<uint64_t> offset = allocator.Allocate(size, alignment);
+        if (!offset.has_value()) {
+            continue;
+        }
+        const RangeAllocator::Range allocation = { offset.value(), size };
+        REQUIRE(allocation.offset % alignment == 0);
+        REQUIRE(allocation.offset + allocation.size <= allocator.GetSize());
+        for (const RangeAllocator::Range& other : allocations) {
+            REQUIRE_FALSE(Overlaps(allocation, other));
+        }
+        for (const RangeAllocator::Range& range : allocator.GetFreeRanges()) {
+            REQUIRE_FALSE(Overlaps(allocation, range));
+        }
+        allocations.push_back(allocation);
+    }
+    CHECK(allocator.GetAllocationCount() == allocations.size());
+
+    // free ranges stay sorted and merged, and together with the allocations cover the whole block
+    uint64_t freeBytes = 0;
+    const std::vector<RangeAllocator::Range>& freeRanges = allocator.GetFreeRanges();
+    for (size_t i = 0; i < freeRanges.size(); i++) {
+        freeBytes += freeRanges[i].size;
+        if (i > 0) {
+            CHECK(freeRanges[i - 1].offset + freeRanges[i - 1].size < freeRanges[i].offset);
+        }
+    }
+    uint64_t allocatedBytes = 0;
+    for (const RangeAllocator::Range& allocation : allocations) {
+        allocatedBytes += allocation.size;
+    }
+    CHECK(freeBytes + allocatedBytes == allocator.GetSize());
+
+    for (const RangeAllocator::Range& allocation : allocations) {
+        allocator.Free(allocation.offset, allocation.size);
+    }
+    REQUIRE(allocator.GetFreeRanges().size() == 1);
+    CHECK(allocator.GetFreeRanges()[0].size == allocator.GetSize());
+}
@@ -2,6 +2,7 @@
 #include "instance.h"
 #include "texture.h"
 #include "utils/d3d12_utils.h"
+#include "utils/telemetry.h"
 
 
 RND_Renderer::RND_Renderer(XrSession xrSession): m_session(xrSession) {
@@ -26,10 +27,17 @@ RND_Renderer::~RND_Renderer() {
 }
 
 void RND_Renderer::StartFrame() {
+    static const Telemetry::CounterId s_startFrameCounter = Telemetry::Register("StartFrame", Telemetry::Category::FRAME);
+    static const Telemetry::CounterId s_waitFrameCounter = Telemetry::Register("xrWaitFrame", Telemetry::Category::FRAME);
+    Telemetry::ScopedTimer timer(s_startFrameCounter);
+
     m_isInitialized = true;
 
     XrFrameWaitInfo waitFrameInfo = { XR_TYPE_FRAME_WAIT_INFO };
-    checkXRResult(xrWaitFrame(m_session, &waitFrameInfo, &m_frameState), "Failed to wait for next frame!");
+    {
+        Telemetry::ScopedTimer waitTimer(s_waitFrameCounter);
+        checkXRResult(xrWaitFrame(m_session, &waitFrameInfo, &m_frameState), "Failed to wait for next frame!");
+    }
 
     XrFrameBeginInfo beginFrameInfo = { XR_TYPE_FRAME_BEGIN_INFO };
     checkXRResult(xrBeginFrame(m_session, &beginFrameInfo), "Couldn't begin OpenXR frame!");
@@ -37,6 +45,9 @@ void RND_Renderer::StartFrame() {
     VRManager::instance().D3D12->StartFrame();
     this->UpdateViews(m_frameState.predictedDisplayTime);
 
+    // the images are only rendered to in EndFrame, which leaves the compositor the whole game frame to release them
+    PollSwapchainImages();
+
     // todo: update this as late as possible
     //VRManager::instance().XR->UpdateSpaces(m_frameState.predictedDisplayTime);
 
@@ -48,8 +59,20 @@ void RND_Renderer::StartFrame() {
     }
 }
 
+void RND_Renderer::PollSwapchainImages() {
+    if (m_layer3D) {
+        m_layer3D->AcquireImages();
+    }
+    if (m_layer2D) {
+        m_layer2D->AcquireImages();
+    }
+}
 
 void RND_Renderer::EndFrame() {
+    static const Telemetry::CounterId s_endFrameCounter = Telemetry::Register("EndFrame", Telemetry::Category::FRAME);
+    static const Telemetry::CounterId s_xrEndFrameCounter = Telemetry::Register("xrEndFrame", Telemetry::Category::FRAME);
+    Telemetry::ScopedTimer timer(s_endFrameCounter);
+
     static uint32_t s_endFrameCount = 0;
     s_endFrameCount++;
 
@@ -75,12 +98,56 @@ void RND_Renderer::EndFrame() {
         frameIdx = 1;
     }
 
+    // Re-locate the views as late as possible, so the game logic that runs before the next StartFrame (hands, weapons, controls) sees
+    // the newest head pose. The projection views keep using the views each eye was latched with, since that's what the
+    // image shows, and the runtime's reprojection corrects for the difference that gets logged here.
+    std::optional<float> lateLatchDeltaDegrees;
     if (frameIdx != -1) {
+        const std::optional<std::array<XrView, 2>> renderedViews = m_renderFrames[frameIdx].views.Get();
+        const std::optional<std::array<XrView, 2>> lateViews = UpdateViews(m_frameState.predictedDisplayTime);
+        if (renderedViews.has_value() && lateViews.has_value()) {
+            const glm::fquat renderedOrientation = ToGLM(renderedViews.value()[OpenXR::EyeSide::LEFT].pose.orientation);
+            const glm::fquat lateOrientation = ToGLM(lateViews.value()[OpenXR::EyeSide::LEFT].pose.orientation);
+            lateLatchDeltaDegrees = glm::degrees(glm::angle(glm::inverse(renderedOrientation) * lateOrientation));
+        }
+    }
+
+    if (CemuHooks::GetSettings().IsDynamicResolutionEnabled() && m_layer3D) {
+        // the game's timestamps are only read for the frame that gets presented, the scaler keeps using its smoothed timings in between
+        if (frameIdx != -1) {
+            if (const auto copyTimings = VRManager::instance().VK->ReadCopyTimings(frameIdx)) {
+                m_lastGpuTimings.copyMs = copyTimings->copyMs;
+                // the gap between both eyes' copies is the eye that's rendered second, with single-pass stereo there's no gap to measure
+                m_lastGpuTimings.gameMs = copyTimings->eyePassMs.transform([](double eyePassMs) { return eyePassMs * 2.0; });
+            }
+        }
+        m_lastGpuTimings.presentMs = VRManager::instance().D3D12->GetLastFrameGpuMs();
+        m_resolutionScaler.Update(m_lastGpuTimings, (double)m_frameState.predictedDisplayPeriod / 1000000.0, m_layer3D->GetRenderScale());
+    }
+    else {
+        m_resolutionScaler.Reset();
+    }
+
+    if (frameIdx != -1) {
+        // record all layers into the frame's command list first, it needs to be submitted before the swapchain images get released
+        bool render3D = m_layer3D && m_renderFrames[frameIdx].Is3DComplete();
+        if (render3D) {
+            m_layer3D->StartRendering();
+            if (m_renderFrames[frameIdx].reprojectRightEye) {
+                m_layer3D->RenderReprojected(frameIdx);
+            }
+            else {
+                m_layer3D->Render(frameIdx);
+            }
+        }
+        if (m_layer2D) {
+            m_layer2D->StartRendering();
+            m_layer2D->Render(frameIdx);
+        }
+        VRManager::instance().D3D12->SubmitFrameCommands();
+
         if (m_layer3D) {
-            if (m_renderFrames[frameIdx].Is3DComplete()) {
-                m_layer3D->StartRendering();
-                m_layer3D->Render(OpenXR::EyeSide::LEFT, frameIdx);
-                m_layer3D->Render(OpenXR::EyeSide::RIGHT, frameIdx);
+            if (render3D) {
                 layer3DViews = m_layer3D->FinishRendering(frameIdx);
                 layer3D.layerFlags = 0;
                 layer3D.space = VRManager::instance().XR->m_stageSpace;
@@ -99,8 +166,6 @@ void RND_Renderer::EndFrame() {
         }
 
         if (m_layer2D) {
-            m_layer2D->StartRendering();
-            m_layer2D->Render(frameIdx);
             layer2DQuads = m_layer2D->FinishRendering(m_frameState.predictedDisplayTime, frameIdx);
             m_presented2DLastFrame = true;
             for (auto& layer : layer2DQuads) {
@@ -118,13 +183,21 @@ void RND_Renderer::EndFrame() {
     frameEndInfo.layers = compositionLayers.data();
 
     if (s_endFrameCount % 500 == 0) {
-        Log::print<VERBOSE>("EndFrame #{}: frameIdx={}, layers={}, 3D={}, 2D={}",
+        Log::print<VERBOSE>("EndFrame #{}: frameIdx={}, layers={}, 3D={}, 2D={}, late latch delta={:.2f} degrees, GPU game={} copy={:.2f}ms present={:.2f}ms, dynamic scale={:.2f}",
             s_endFrameCount, frameIdx, compositionLayers.size(),
             (frameIdx != -1 && m_renderFrames[frameIdx].presented3D) ? "yes" : "no",
-            m_presented2DLastFrame ? "yes" : "no");
+            m_presented2DLastFrame ? "yes" : "no",
+            lateLatchDeltaDegrees.value_or(0.0f),
+            m_lastGpuTimings.gameMs.transform([](double gameMs) { return std::format("{:.2f}ms", gameMs); }).value_or("not measured"),
+            m_lastGpuTimings.copyMs, m_lastGpuTimings.presentMs,
+            m_resolutionScaler.GetDynamicScale());
     }
 
-    XrResult xrResult = xrEndFrame(m_session, &frameEndInfo);
+    XrResult xrResult;
+    {
+        Telemetry::ScopedTimer xrEndFrameTimer(s_xrEndFrameCounter);
+        xrResult = xrEndFrame(m_session, &frameEndInfo);
+    }
     if (XR_FAILED(xrResult)) {
         Log::print<ERROR>("xrEndFrame #{} FAILED with result {}", s_endFrameCount, (int)xrResult);
     }
@@ -132,20 +205,70 @@ void RND_Renderer::EndFrame() {
     VRManager::instance().D3D12->EndFrame();
 }
 
+void RND_Renderer::LatchView(OpenXR::EyeSide side, long frameIdx) {
+    if (const std::optional<std::array<XrView, 2>> currViews = m_currViews.Load()) {
+        m_renderFrames[frameIdx].views.Latch(side, currViews.value());
+    }
+}
+
+void RND_Renderer::On3DColorCopied(OpenXR::EyeSide side, long frameIdx) {
+    RenderFrame& frame = m_renderFrames[frameIdx];
+    if (side == OpenXR::EyeSide::LEFT && CemuHooks::GetSettings().IsSinglePassStereoEnabled()) {
+        frame.reprojectRightEye = true;
+    }
+    frame.copiedColor[side] = true;
+}
+
+void RND_Renderer::On3DDepthCopied(OpenXR::EyeSide side, long frameIdx) {
+    m_renderFrames[frameIdx].copiedDepth[side] = true;
+}
+
 RND_Renderer::Layer3D::Layer3D(VkExtent2D extent) {
     auto viewConfs = VRManager::instance().XR->GetViewConfigurations();
 
-    this->m_presentPipelines[OpenXR::EyeSide::LEFT] = std::make_unique<RND_D3D12::PresentPipeline<true>>(VRManager::instance().XR->GetRenderer());
-    this->m_presentPipelines[OpenXR::EyeSide::RIGHT] = std::make_unique<RND_D3D12::PresentPipeline<true>>(VRManager::instance().XR->GetRenderer());
+    // the stereo pipeline picks the layer to render to in the vertex shader, which some drivers only support by emulating a geometry shader
+    m_stereoSwapchains = CemuHooks::GetSettings().UseStereoSwapchains();
+    if (m_stereoSwapchains) {
+        D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+        checkHResult(VRManager::instance().D3D12->GetDevice()->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options)), "Failed to check D3D12 options!");
+        if (!options.VPAndRTArrayIndexFromAnyShaderFeedingRasterizerSupportedWithoutGSEmulation) {
+            Log::print<WARNING>("GPU can't select the render target layer from the vertex shader, using one swapchain per eye instead");
+            m_stereoSwapchains = false;
+        }
+    }
 
     // note: it's possible to make a swapchain that matches Cemu's internal resolution and let the headset downsample it, although I doubt there's a benefit
-    this->m_swapchains[OpenXR::EyeSide::LEFT] = std::make_unique<Swapchain<DXGI_FORMAT_R8G8B8A8_UNORM_SRGB>>(viewConfs[0].recommendedImageRectWidth, viewConfs[0].recommendedImageRectHeight, viewConfs[0].recommendedSwapchainSampleCount);
-    this->m_swapchains[OpenXR::EyeSide::RIGHT] = std::make_unique<Swapchain<DXGI_FORMAT_R8G8B8A8_UNORM_SRGB>>(viewConfs[1].recommendedImageRectWidth, viewConfs[1].recommendedImageRectHeight, viewConfs[1].recommendedSwapchainSampleCount);
-    this->m_depthSwapchains[OpenXR::EyeSide::LEFT] = std::make_unique<Swapchain<DXGI_FORMAT_D32_FLOAT>>(viewConfs[0].recommendedImageRectWidth, viewConfs[0].recommendedImageRectHeight, viewConfs[0].recommendedSwapchainSampleCount);
-    this->m_depthSwapchains[OpenXR::EyeSide::RIGHT] = std::make_unique<Swapchain<DXGI_FORMAT_D32_FLOAT>>(viewConfs[1].recommendedImageRectWidth, viewConfs[1].recommendedImageRectHeight, viewConfs[1].recommendedSwapchainSampleCount);
+    m_renderScale = CemuHooks::GetSettings().GetRenderScale();
+    std::array<ResolutionScaler::Extent, 2> sizes;
+    for (OpenXR::EyeSide side : { OpenXR::EyeSide::LEFT, OpenXR::EyeSide::RIGHT }) {
+        const XrViewConfigurationView& viewConf = viewConfs[side];
+        sizes[side] = ResolutionScaler::GetScaledSize(viewConf.recommendedImageRectWidth, viewConf.recommendedImageRectHeight, viewConf.maxImageRectWidth, viewConf.maxImageRectHeight, m_renderScale);
+        Log::print<INFO>("Using {}x{} for the {} eye ({}% of the recommended {}x{})", sizes[side].width, sizes[side].height, side == OpenXR::EyeSide::LEFT ? "left" : "right", m_renderScale * 100.0f, viewConf.recommendedImageRectWidth, viewConf.recommendedImageRectHeight);
+    }
 
-    this->m_presentPipelines[OpenXR::EyeSide::LEFT]->BindSettings((float)this->m_swapchains[OpenXR::EyeSide::LEFT]->GetWidth(), (float)this->m_swapchains[OpenXR::EyeSide::LEFT]->GetHeight());
-    this->m_presentPipelines[OpenXR::EyeSide::RIGHT]->BindSettings((float)this->m_swapchains[OpenXR::EyeSide::RIGHT]->GetWidth(), (float)this->m_swapchains[OpenXR::EyeSide::RIGHT]->GetHeight());
+    if (m_stereoSwapchains) {
+        // both eyes have to fit in the same image size, which in practice is the case for every headset anyway
+        const XrExtent2Di size = { std::max(sizes[0].width, sizes[1].width), std::max(sizes[0].height, sizes[1].height) };
+        Log::print<INFO>("Creating stereo swapchains at {}x{} with a layer for each eye", size.width, size.height);
+
+        this->m_swapchains[OpenXR::EyeSide::LEFT] = std::make_unique<Swapchain<DXGI_FORMAT_R8G8B8A8_UNORM_SRGB>>(size.width, size.height, viewConfs[0].recommendedSwapchainSampleCount, 2);
+        this->m_depthSwapchains[OpenXR::EyeSide::LEFT] = std::make_unique<Swapchain<DXGI_FORMAT_D32_FLOAT>>(size.width, size.height, viewConfs[0].recommendedSwapchainSampleCount, 2);
+        this->m_presentPipelines[OpenXR::EyeSide::LEFT] = std::make_unique<RND_D3D12::PresentPipeline<true>>(VRManager::instance().XR->GetRenderer(), true);
+    }
+    else {
+        for (OpenXR::EyeSide side : { OpenXR::EyeSide::LEFT, OpenXR::EyeSide::RIGHT }) {
+            this->m_swapchains[side] = std::make_unique<Swapchain<DXGI_FORMAT_R8G8B8A8_UNORM_SRGB>>(sizes[side].width, sizes[side].height, viewConfs[side].recommendedSwapchainSampleCount);
+            this->m_depthSwapchains[side] = std::make_unique<Swapchain<DXGI_FORMAT_D32_FLOAT>>(sizes[side].width, sizes[side].height, viewConfs[side].recommendedSwapchainSampleCount);
+            this->m_presentPipelines[side] = std::make_unique<RND_D3D12::PresentPipeline<true>>(VRManager::instance().XR->GetRenderer());
+        }
+    }
+
+    for (OpenXR::EyeSide side : { OpenXR::EyeSide::LEFT, OpenXR::EyeSide::RIGHT }) {
+        this->m_renderExtents[side] = { (int32_t)GetSwapchain(side)->GetWidth(), (int32_t)GetSwapchain(side)->GetHeight() };
+        if (this->m_presentPipelines[side]) {
+            this->m_presentPipelines[side]->BindSettings((float)this->m_swapchains[side]->GetWidth(), (float)this->m_swapchains[side]->GetHeight());
+        }
+    }
 
     // initialize textures
     for (int i = 0; i < 2; ++i) {
@@ -160,13 +283,8 @@ RND_Renderer::Layer3D::Layer3D(VkExtent2D extent) {
         this->m_depthTextures[OpenXR::EyeSide::RIGHT][i]->d3d12GetTexture()->SetName(L"Layer3D - Right Depth Texture");
     }
 
-    ComPtr<ID3D12CommandAllocator> cmdAllocator;
     {
-        ID3D12Device* d3d12Device = VRManager::instance().D3D12->GetDevice();
-        ID3D12CommandQueue* d3d12Queue = VRManager::instance().D3D12->GetCommandQueue();
-        d3d12Device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&cmdAllocator));
-
-        RND_D3D12::CommandContext<true> transitionInitialTextures(d3d12Device, d3d12Queue, cmdAllocator.Get(), [this](RND_D3D12::CommandContext<true>* context) {
+        RND_D3D12::CommandContext<true> transitionInitialTextures(VRManager::instance().D3D12.get(), [this](RND_D3D12::CommandContext<true>* context) {
             context->GetRecordList()->SetName(L"transitionInitialTextures");
             for (int i = 0; i < 2; ++i) {
                 // AMD GPU FIX: Use D3D12_RESOURCE_STATE_COMMON for cross-API shared resources.
@@ -188,7 +306,10 @@ RND_Renderer::Layer3D::~Layer3D() {
     }
 }
 
-SharedTexture* RND_Renderer::Layer3D::CopyColorToLayer(OpenXR::EyeSide side, VkCommandBuffer copyCmdBuffer, VkImage image, long frameIdx, VkImageLayout srcImageLayout) {
+SharedTexture* RND_Renderer::Layer3D::CopyColorToLayer(OpenXR::EyeSide side, VulkanUtils::BarrierBatch& barriers, VkImage image, long frameIdx, VkImageLayout srcImageLayout) {
+    static const Telemetry::CounterId s_copyCounter = Telemetry::Register("Layer3D::CopyColorToLayer", Telemetry::Category::FRAME);
+    Telemetry::ScopedTimer timer(s_copyCounter);
+
     static uint32_t s_copyCount = 0;
     static VkImage s_lastSrcImage = VK_NULL_HANDLE;
     s_copyCount++;
@@ -206,19 +327,27 @@ SharedTexture* RND_Renderer::Layer3D::CopyColorToLayer(OpenXR::EyeSide side, VkC
             s_copyCount, side == OpenXR::EyeSide::LEFT ? "L" : "R", frameIdx, (void*)image);
     }
     m_currentFrameIdx = frameIdx;
-    m_textures[side][frameIdx]->CopyFromVkImage(copyCmdBuffer, image, srcImageLayout);
+    VRManager::instance().VK->WriteCopyTimestamp(barriers.GetCommandBuffer(), side, frameIdx, false);
+    m_textures[side][frameIdx]->CopyFromVkImage(barriers, image, srcImageLayout);
+    VRManager::instance().VK->WriteCopyTimestamp(barriers.GetCommandBuffer(), side, frameIdx, true);
     return m_textures[side][frameIdx].get();
 }
 
-SharedTexture* RND_Renderer::Layer3D::CopyDepthToLayer(OpenXR::EyeSide side, VkCommandBuffer copyCmdBuffer, VkImage image, long frameIdx, VkImageLayout srcImageLayout) {
-    m_depthTextures[side][frameIdx]->CopyFromVkImage(copyCmdBuffer, image, srcImageLayout);
+SharedTexture* RND_Renderer::Layer3D::CopyDepthToLayer(OpenXR::EyeSide side, VulkanUtils::BarrierBatch& barriers, VkImage image, long frameIdx, VkImageLayout srcImageLayout) {
+    static const Telemetry::CounterId s_copyCounter = Telemetry::Register("Layer3D::CopyDepthToLayer", Telemetry::Category::FRAME);
+    Telemetry::ScopedTimer timer(s_copyCounter);
+
+    m_depthTextures[side][frameIdx]->CopyFromVkImage(barriers, image, srcImageLayout);
     return m_depthTextures[side][frameIdx].get();
 }
 
 void RND_Renderer::Layer3D::PrepareRendering(OpenXR::EyeSide side) {
     // Log::print("Preparing rendering for {} side", side == OpenXR::EyeSide::LEFT ? "left" : "right");
-    m_swapchains[side]->PrepareRendering();
-    m_depthSwapchains[side]->PrepareRendering();
+    // stereo swapchains only exist once, so they're prepared with the left eye
+    if (m_swapchains[side]) {
+        m_swapchains[side]->PrepareRendering();
+        m_depthSwapchains[side]->PrepareRendering();
+    }
 }
 
 std::optional<std::array<XrView, 2>> RND_Renderer::UpdateViews(XrTime predictedDisplayTime) {
@@ -233,13 +362,23 @@ std::optional<std::array<XrView, 2>> RND_Renderer::UpdateViews(XrTime predictedD
     if ((viewState.viewStateFlags & XR_VIEW_STATE_ORIENTATION_VALID_BIT) == 0)
         return std::nullopt; // what should occur when the orientation is invalid? keep rendering using old values?
 
-    const float playerHeightOffsetMeters = CemuHooks::GetSettings().playerHeightSetting.getLE();
+    const float playerHeightOffsetMeters = CemuHooks::GetSettings().GetPlayerHeight();
     for (auto& view : newViews) {
         view.pose.position.y += playerHeightOffsetMeters;
     }
 
-    m_currViews = newViews;
-    return m_currViews;
+    m_currViews.Store(newViews);
+    return newViews;
+}
+
+void RND_Renderer::Layer3D::AcquireImages() {
+    for (OpenXR::EyeSide side : { OpenXR::EyeSide::LEFT, OpenXR::EyeSide::RIGHT }) {
+        if (!this->m_swapchains[side]) {
+            continue;
+        }
+        this->m_swapchains[side]->AcquireAndPoll();
+        this->m_depthSwapchains[side]->AcquireAndPoll();
+    }
 }
 
 void RND_Renderer::Layer3D::StartRendering() {
@@ -248,23 +387,36 @@ void RND_Renderer::Layer3D::StartRendering() {
     // checkAssert((this->m_textures[OpenXR::EyeSide::LEFT][0] == nullptr && this->m_textures[OpenXR::EyeSide::RIGHT][0] == nullptr) || (this->m_textures[OpenXR::EyeSide::LEFT][0] != nullptr && this->m_textures[OpenXR::EyeSide::RIGHT][0] != nullptr), "Both textures must be either null or not null");
     // checkAssert((this->m_depthTextures[OpenXR::EyeSide::LEFT][0] == nullptr && this->m_depthTextures[OpenXR::EyeSide::RIGHT][0] == nullptr) || (this->m_depthTextures[OpenXR::EyeSide::LEFT][0] != nullptr && this->m_depthTextures[OpenXR::EyeSide::RIGHT][0] != nullptr), "Both depth textures must be either null or not null");
 
-    this->m_swapchains[OpenXR::EyeSide::LEFT]->PrepareRendering();
-    this->m_swapchains[OpenXR::EyeSide::LEFT]->StartRendering();
-    this->m_depthSwapchains[OpenXR::EyeSide::LEFT]->PrepareRendering();
-    this->m_depthSwapchains[OpenXR::EyeSide::LEFT]->StartRendering();
-    this->m_swapchains[OpenXR::EyeSide::RIGHT]->PrepareRendering();
-    this->m_swapchains[OpenXR::EyeSide::RIGHT]->StartRendering();
-    this->m_depthSwapchains[OpenXR::EyeSide::RIGHT]->PrepareRendering();
-    this->m_depthSwapchains[OpenXR::EyeSide::RIGHT]->StartRendering();
+    for (OpenXR::EyeSide side : { OpenXR::EyeSide::LEFT, OpenXR::EyeSide::RIGHT }) {
+        if (!this->m_swapchains[side]) {
+            continue;
+        }
+        this->m_swapchains[side]->PrepareRendering();
+        this->m_swapchains[side]->StartRendering();
+        this->m_depthSwapchains[side]->PrepareRendering();
+        this->m_depthSwapchains[side]->StartRendering();
+    }
+
+    const ResolutionScaler& scaler = VRManager::instance().XR->GetRenderer()->GetResolutionScaler();
+    for (OpenXR::EyeSide side : { OpenXR::EyeSide::LEFT, OpenXR::EyeSide::RIGHT }) {
+        const ResolutionScaler::Extent extent = scaler.GetRenderExtent(GetSwapchain(side)->GetWidth(), GetSwapchain(side)->GetHeight());
+        m_renderExtents[side] = { extent.width, extent.height };
+    }
 }
 
-void RND_Renderer::Layer3D::Render(OpenXR::EyeSide side, long frameIdx) {
-    ID3D12Device* device = VRManager::instance().D3D12->GetDevice();
-    ID3D12CommandQueue* queue = VRManager::instance().D3D12->GetCommandQueue();
-    ID3D12CommandAllocator* allocator = VRManager::instance().D3D12->GetFrameAllocator();
+void RND_Renderer::Layer3D::Render(long frameIdx) {
+    if (m_stereoSwapchains) {
+        RenderStereo(frameIdx);
+    }
+    else {
+        RenderEye(OpenXR::EyeSide::LEFT, frameIdx);
+        RenderEye(OpenXR::EyeSide::RIGHT, frameIdx);
+    }
+}
 
-    RND_D3D12::CommandContext<false> renderSharedTexture(device, queue, allocator, [this, side, frameIdx](RND_D3D12::CommandContext<false>* context) {
-        context->GetRecordList()->SetName(L"RenderSharedTexture");
+void RND_Renderer::Layer3D::RenderEye(OpenXR::EyeSide side, long frameIdx) {
+    // gets recorded into the frame's command list, which the renderer submits once all layers are recorded
+    RND_D3D12::CommandContext<false> renderSharedTexture(VRManager::instance().D3D12.get(), [this, side, frameIdx](RND_D3D12::CommandContext<false>* context) {
         auto& texture = m_textures[side][frameIdx];
         auto& depthTexture = m_depthTextures[side][frameIdx];
 
@@ -274,40 +426,8 @@ void RND_Renderer::Layer3D::Render(OpenXR::EyeSide side, long frameIdx) {
         texture->d3d12TransitionLayout(context->GetRecordList(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
         depthTexture->d3d12TransitionLayout(context->GetRecordList(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
-        // AMD GPU FIX: Transition OpenXR swapchain images to render target states
-        // OpenXR swapchain images are acquired in COMMON state. AMD strictly enforces this.
-        D3D12_RESOURCE_BARRIER preBarriers[2] = {};
-        preBarriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        preBarriers[0].Transition.pResource = m_swapchains[side]->GetTexture();
-        preBarriers[0].Transition.StateBefore = D3D12_RESOURCE_STATE_COMMON;
-        preBarriers[0].Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        preBarriers[0].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        preBarriers[1].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        preBarriers[1].Transition.pResource = m_depthSwapchains[side]->GetTexture();
-        preBarriers[1].Transition.StateBefore = D3D12_RESOURCE_STATE_COMMON;
-        preBarriers[1].Transition.StateAfter = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-        preBarriers[1].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        context->GetRecordList()->ResourceBarrier(2, preBarriers);
-
-        m_presentPipelines[side]->BindAttachment(0, texture->d3d12GetTexture());
-        m_presentPipelines[side]->BindAttachment(1, depthTexture->d3d12GetTexture(), DXGI_FORMAT_R32_FLOAT);
-        m_presentPipelines[side]->BindTarget(0, m_swapchains[side]->GetTexture(), m_swapchains[side]->GetFormat());
-        m_presentPipelines[side]->BindDepthTarget(m_depthSwapchains[side]->GetTexture(), m_depthSwapchains[side]->GetFormat());
-        m_presentPipelines[side]->Render(context->GetRecordList(), m_swapchains[side]->GetTexture());
-
-        // AMD GPU FIX: Transition OpenXR swapchain images back to COMMON
-        D3D12_RESOURCE_BARRIER postBarriers[2] = {};
-        postBarriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        postBarriers[0].Transition.pResource = m_swapchains[side]->GetTexture();
-        postBarriers[0].Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        postBarriers[0].Transition.StateAfter = D3D12_RESOURCE_STATE_COMMON;
-        postBarriers[0].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        postBarriers[1].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        postBarriers[1].Transition.pResource = m_depthSwapchains[side]->GetTexture();
-        postBarriers[1].Transition.StateBefore = D3D12_RESOURCE_STATE_DEPTH_WRITE;
-        postBarriers[1].Transition.StateAfter = D3D12_RESOURCE_STATE_COMMON;
-        postBarriers[1].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        context->GetRecordList()->ResourceBarrier(2, postBarriers);
+        m_presentPipelines[side]->ClearReprojection();
+        RenderToSwapchain(context->GetRecordList(), side, { texture.get(), nullptr }, { depthTexture.get(), nullptr });
 
         // AMD GPU FIX: Transition to COMMON before handing back to Vulkan.
         // Shared resources MUST be in D3D12_RESOURCE_STATE_COMMON for cross-API access.
@@ -321,11 +441,106 @@ void RND_Renderer::Layer3D::Render(OpenXR::EyeSide side, long frameIdx) {
     // Log::print("[D3D12 - 3D Layer] Rendering finished");
 }
 
+void RND_Renderer::Layer3D::RenderStereo(long frameIdx) {
+    RND_D3D12::CommandContext<false> renderSharedTexture(VRManager::instance().D3D12.get(), [this, frameIdx](RND_D3D12::CommandContext<false>* context) {
+        const std::array<SharedTexture*, 2> textures = { m_textures[OpenXR::EyeSide::LEFT][frameIdx].get(), m_textures[OpenXR::EyeSide::RIGHT][frameIdx].get() };
+        const std::array<SharedTexture*, 2> depthTextures = { m_depthTextures[OpenXR::EyeSide::LEFT][frameIdx].get(), m_depthTextures[OpenXR::EyeSide::RIGHT][frameIdx].get() };
+        const std::array<SharedTexture*, 4> allTextures = { textures[0], textures[1], depthTextures[0], depthTextures[1] };
+
+        // AMD GPU FIX: Use monotonically increasing fence values
+        for (SharedTexture* texture : allTextures) {
+            context->WaitFor(texture, texture->GetD3D12WaitValue());
+            texture->d3d12TransitionLayout(context->GetRecordList(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        }
+
+        m_presentPipelines[OpenXR::EyeSide::LEFT]->ClearReprojection();
+        RenderToSwapchain(context->GetRecordList(), OpenXR::EyeSide::LEFT, textures, depthTextures);
+
+        // AMD GPU FIX: Transition to COMMON before handing back to Vulkan.
+        for (SharedTexture* texture : allTextures) {
+            texture->d3d12TransitionLayout(context->GetRecordList(), D3D12_RESOURCE_STATE_COMMON);
+            context->Signal(texture, texture->GetD3D12SignalValue());
+        }
+    });
+}
+
+void RND_Renderer::Layer3D::RenderReprojected(long frameIdx) {
+    // both eyes read from the left eye's textures, so they're rendered within one wait and signal of those
+    RND_D3D12::CommandContext<false> renderSharedTexture(VRManager::instance().D3D12.get(), [this, frameIdx](RND_D3D12::CommandContext<false>* context) {
+        auto& texture = m_textures[OpenXR::EyeSide::LEFT][frameIdx];
+        auto& depthTexture = m_depthTextures[OpenXR::EyeSide::LEFT][frameIdx];
+
+        context->WaitFor(texture.get(), texture->GetD3D12WaitValue());
+        context->WaitFor(depthTexture.get(), depthTexture->GetD3D12WaitValue());
+        texture->d3d12TransitionLayout(context->GetRecordList(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        depthTexture->d3d12TransitionLayout(context->GetRecordList(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+        const std::array<XrView, 2> views = VRManager::instance().XR->GetRenderer()->GetPoses(frameIdx).value();
+        if (m_stereoSwapchains) {
+            // the stereo pipeline only reprojects its second eye, so the left eye's textures can be bound for both
+            m_presentPipelines[OpenXR::EyeSide::LEFT]->BindReprojection(views[OpenXR::EyeSide::LEFT], views[OpenXR::EyeSide::RIGHT], CemuHooks::GetSettings().GetZNear(), CemuHooks::GetSettings().GetZFar());
+            RenderToSwapchain(context->GetRecordList(), OpenXR::EyeSide::LEFT, { texture.get(), texture.get() }, { depthTexture.get(), depthTexture.get() });
+        }
+        else {
+            m_presentPipelines[OpenXR::EyeSide::LEFT]->ClearReprojection();
+            m_presentPipelines[OpenXR::EyeSide::RIGHT]->BindReprojection(views[OpenXR::EyeSide::LEFT], views[OpenXR::EyeSide::RIGHT], CemuHooks::GetSettings().GetZNear(), CemuHooks::GetSettings().GetZFar());
+            RenderToSwapchain(context->GetRecordList(), OpenXR::EyeSide::LEFT, { texture.get(), nullptr }, { depthTexture.get(), nullptr });
+            RenderToSwapchain(context->GetRecordList(), OpenXR::EyeSide::RIGHT, { texture.get(), nullptr }, { depthTexture.get(), nullptr });
+        }
+
+        texture->d3d12TransitionLayout(context->GetRecordList(), D3D12_RESOURCE_STATE_COMMON);
+        depthTexture->d3d12TransitionLayout(context->GetRecordList(), D3D12_RESOURCE_STATE_COMMON);
+        context->Signal(texture.get(), texture->GetD3D12SignalValue());
+        context->Signal(depthTexture.get(), depthTexture->GetD3D12SignalValue());
+    });
+}
+
+void RND_Renderer::Layer3D::RenderToSwapchain(ID3D12GraphicsCommandList* cmdList, OpenXR::EyeSide side, const std::array<SharedTexture*, 2>& textures, const std::array<SharedTexture*, 2>& depthTextures) {
+    // AMD GPU FIX: Transition OpenXR swapchain images to render target states
+    // OpenXR swapchain images are acquired in COMMON state. AMD strictly enforces this.
+    D3D12_RESOURCE_BARRIER preBarriers[2] = {};
+    preBarriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    preBarriers[0].Transition.pResource = m_swapchains[side]->GetTexture();
+    preBarriers[0].Transition.StateBefore = D3D12_RESOURCE_STATE_COMMON;
+    preBarriers[0].Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
+    preBarriers[0].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    preBarriers[1].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    preBarriers[1].Transition.pResource = m_depthSwapchains[side]->GetTexture();
+    preBarriers[1].Transition.StateBefore = D3D12_RESOURCE_STATE_COMMON;
+    preBarriers[1].Transition.StateAfter = D3D12_RESOURCE_STATE_DEPTH_WRITE;
+    preBarriers[1].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    cmdList->ResourceBarrier(2, preBarriers);
+
+    for (uint32_t eye = 0; eye < (m_stereoSwapchains ? 2u : 1u); eye++) {
+        m_presentPipelines[side]->BindAttachment(eye * 2, textures[eye]->d3d12GetTexture());
+        m_presentPipelines[side]->BindAttachment(eye * 2 + 1, depthTextures[eye]->d3d12GetTexture(), DXGI_FORMAT_R32_FLOAT);
+    }
+    m_presentPipelines[side]->BindTarget(0, m_swapchains[side]->GetTexture(), m_swapchains[side]->GetFormat());
+    m_presentPipelines[side]->BindDepthTarget(m_depthSwapchains[side]->GetTexture(), m_depthSwapchains[side]->GetFormat());
+    m_presentPipelines[side]->Render(cmdList, m_swapchains[side]->GetTexture(), m_renderExtents[side]);
+
+    // AMD GPU FIX: Transition OpenXR swapchain images back to COMMON
+    D3D12_RESOURCE_BARRIER postBarriers[2] = {};
+    postBarriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    postBarriers[0].Transition.pResource = m_swapchains[side]->GetTexture();
+    postBarriers[0].Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
+    postBarriers[0].Transition.StateAfter = D3D12_RESOURCE_STATE_COMMON;
+    postBarriers[0].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    postBarriers[1].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    postBarriers[1].Transition.pResource = m_depthSwapchains[side]->GetTexture();
+    postBarriers[1].Transition.StateBefore = D3D12_RESOURCE_STATE_DEPTH_WRITE;
+    postBarriers[1].Transition.StateAfter = D3D12_RESOURCE_STATE_COMMON;
+    postBarriers[1].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    cmdList->ResourceBarrier(2, postBarriers);
+}
+
 const std::array<XrCompositionLayerProjectionView, 2>& RND_Renderer::Layer3D::FinishRendering(long frameIdx) {
-    this->m_swapchains[OpenXR::EyeSide::LEFT]->FinishRendering();
-    this->m_depthSwapchains[OpenXR::EyeSide::LEFT]->FinishRendering();
-    this->m_swapchains[OpenXR::EyeSide::RIGHT]->FinishRendering();
-    this->m_depthSwapchains[OpenXR::EyeSide::RIGHT]->FinishRendering();
+    for (OpenXR::EyeSide side : { OpenXR::EyeSide::LEFT, OpenXR::EyeSide::RIGHT }) {
+        if (this->m_swapchains[side]) {
+            this->m_swapchains[side]->FinishRendering();
+            this->m_depthSwapchains[side]->FinishRendering();
+        }
+    }
 
     // clang-format off
     m_projectionViews[OpenXR::EyeSide::LEFT] = {
@@ -334,27 +549,23 @@ const std::array<XrCompositionLayerProjectionView, 2>& RND_Renderer::Layer3D::Fi
         .pose = VRManager::instance().XR->GetRenderer()->GetPose(OpenXR::EyeSide::LEFT, frameIdx).value(),
         .fov = VRManager::instance().XR->GetRenderer()->GetFOV(OpenXR::EyeSide::LEFT, frameIdx).value(),
         .subImage = {
-            .swapchain = this->m_swapchains[OpenXR::EyeSide::LEFT]->GetHandle(),
+            .swapchain = this->GetSwapchain(OpenXR::EyeSide::LEFT)->GetHandle(),
             .imageRect = {
                 .offset = { 0, 0 },
-                .extent = {
-                    .width = (int32_t)this->m_swapchains[OpenXR::EyeSide::LEFT]->GetWidth(),
-                    .height = (int32_t)this->m_swapchains[OpenXR::EyeSide::LEFT]->GetHeight()
-                }
-            }
+                .extent = this->m_renderExtents[OpenXR::EyeSide::LEFT]
+            },
+            .imageArrayIndex = this->GetArrayIndex(OpenXR::EyeSide::LEFT)
         }
     };
     m_projectionViewsDepthInfo[OpenXR::EyeSide::LEFT] = {
         .type = XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR,
         .subImage = {
-            .swapchain = this->m_depthSwapchains[OpenXR::EyeSide::LEFT]->GetHandle(),
+            .swapchain = this->GetDepthSwapchain(OpenXR::EyeSide::LEFT)->GetHandle(),
             .imageRect = {
                 .offset = { 0, 0 },
-                .extent = {
-                    .width = (int32_t)this->m_depthSwapchains[OpenXR::EyeSide::LEFT]->GetWidth(),
-                    .height = (int32_t)this->m_depthSwapchains[OpenXR::EyeSide::LEFT]->GetHeight()
-                }
+                .extent = this->m_renderExtents[OpenXR::EyeSide::LEFT]
             },
+            .imageArrayIndex = this->GetArrayIndex(OpenXR::EyeSide::LEFT),
         },
         .minDepth = 0.0f,
         .maxDepth = 1.0f,
@@ -367,27 +578,23 @@ const std::array<XrCompositionLayerProjectionView, 2>& RND_Renderer::Layer3D::Fi
         .pose = VRManager::instance().XR->GetRenderer()->GetPose(OpenXR::EyeSide::RIGHT, frameIdx).value(),
         .fov = VRManager::instance().XR->GetRenderer()->GetFOV(OpenXR::EyeSide::RIGHT, frameIdx).value(),
         .subImage = {
-            .swapchain = this->m_swapchains[OpenXR::EyeSide::RIGHT]->GetHandle(),
+            .swapchain = this->GetSwapchain(OpenXR::EyeSide::RIGHT)->GetHandle(),
             .imageRect = {
                 .offset = { 0, 0 },
-                .extent = {
-                    .width = (int32_t)this->m_swapchains[OpenXR::EyeSide::RIGHT]->GetWidth(),
-                    .height = (int32_t)this->m_swapchains[OpenXR::EyeSide::RIGHT]->GetHeight()
-                }
-            }
+                .extent = this->m_renderExtents[OpenXR::EyeSide::RIGHT]
+            },
+            .imageArrayIndex = this->GetArrayIndex(OpenXR::EyeSide::RIGHT)
         }
     };
     m_projectionViewsDepthInfo[OpenXR::EyeSide::RIGHT] = {
         .type = XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR,
         .subImage = {
-            .swapchain = this->m_depthSwapchains[OpenXR::EyeSide::RIGHT]->GetHandle(),
+            .swapchain = this->GetDepthSwapchain(OpenXR::EyeSide::RIGHT)->GetHandle(),
             .imageRect = {
                 .offset = { 0, 0 },
-                .extent = {
-                    .width = (int32_t)this->m_depthSwapchains[OpenXR::EyeSide::RIGHT]->GetWidth(),
-                    .height = (int32_t)this->m_depthSwapchains[OpenXR::EyeSide::RIGHT]->GetHeight()
-                }
+                .extent = this->m_renderExtents[OpenXR::EyeSide::RIGHT]
             },
+            .imageArrayIndex = this->GetArrayIndex(OpenXR::EyeSide::RIGHT),
         },
         .minDepth = 0.0f,
         .maxDepth = 1.0f,
@@ -405,7 +612,9 @@ RND_Renderer::Layer2D::Layer2D(VkExtent2D extent) {
     this->m_presentPipeline = std::make_unique<RND_D3D12::PresentPipeline<false>>(VRManager::instance().XR->GetRenderer());
 
     // note: it's possible to make a swapchain that matches Cemu's internal resolution and let the headset downsample it, although I doubt there's a benefit
-    this->m_swapchain = std::make_unique<Swapchain<DXGI_FORMAT_R8G8B8A8_UNORM_SRGB>>(viewConfs[0].recommendedImageRectWidth, viewConfs[0].recommendedImageRectHeight, viewConfs[0].recommendedSwapchainSampleCount);
+    // the HUD quad has its own scale since text stays readable at lower resolutions than the game world
+    const ResolutionScaler::Extent size = ResolutionScaler::GetScaledSize(viewConfs[0].recommendedImageRectWidth, viewConfs[0].recommendedImageRectHeight, viewConfs[0].maxImageRectWidth, viewConfs[0].maxImageRectHeight, CemuHooks::GetSettings().GetHUDScale());
+    this->m_swapchain = std::make_unique<Swapchain<DXGI_FORMAT_R8G8B8A8_UNORM_SRGB>>(size.width, size.height, viewConfs[0].recommendedSwapchainSampleCount);
 
     this->m_presentPipeline->BindSettings((float)this->m_swapchain->GetWidth(), (float)this->m_swapchain->GetHeight());
 
@@ -415,13 +624,8 @@ RND_Renderer::Layer2D::Layer2D(VkExtent2D extent) {
         this->m_textures[i]->d3d12GetTexture()->SetName(L"Layer2D - Color Texture");
     }
 
-    ComPtr<ID3D12CommandAllocator> cmdAllocator;
     {
-        ID3D12Device* d3d12Device = VRManager::instance().D3D12->GetDevice();
-        ID3D12CommandQueue* d3d12Queue = VRManager::instance().D3D12->GetCommandQueue();
-        d3d12Device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&cmdAllocator));
-
-        RND_D3D12::CommandContext<true> transitionInitialTextures(d3d12Device, d3d12Queue, cmdAllocator.Get(), [this](RND_D3D12::CommandContext<true>* context) {
+        RND_D3D12::CommandContext<true> transitionInitialTextures(VRManager::instance().D3D12.get(), [this](RND_D3D12::CommandContext<true>* context) {
             context->GetRecordList()->SetName(L"transitionInitialTextures");
             for (int i = 0; i < 2; ++i) {
                 // AMD GPU FIX: Use D3D12_RESOURCE_STATE_COMMON for cross-API shared resources.
@@ -436,29 +640,32 @@ RND_Renderer::Layer2D::~Layer2D() {
     m_swapchain.reset();
 }
 
-SharedTexture* RND_Renderer::Layer2D::CopyColorToLayer(VkCommandBuffer copyCmdBuffer, VkImage image, long frameIdx, VkImageLayout srcImageLayout) {
+SharedTexture* RND_Renderer::Layer2D::CopyColorToLayer(VulkanUtils::BarrierBatch& barriers, VkImage image, long frameIdx, VkImageLayout srcImageLayout) {
+    static const Telemetry::CounterId s_copyCounter = Telemetry::Register("Layer2D::CopyColorToLayer", Telemetry::Category::FRAME);
+    Telemetry::ScopedTimer timer(s_copyCounter);
+
     static uint32_t s_copyCount = 0;
     s_copyCount++;
     if (s_copyCount % 100 == 0) {
         Log::print<VERBOSE>("Layer2D::CopyColorToLayer #{} - frameIdx={}, srcImage={}", s_copyCount, frameIdx, (void*)image);
     }
     m_currentFrameIdx = frameIdx;
-    m_textures[frameIdx]->CopyFromVkImage(copyCmdBuffer, image, srcImageLayout);
+    m_textures[frameIdx]->CopyFromVkImage(barriers, image, srcImageLayout);
     return m_textures[frameIdx].get();
 }
 
+void RND_Renderer::Layer2D::AcquireImages() const {
+    m_swapchain->AcquireAndPoll();
+}
+
 void RND_Renderer::Layer2D::StartRendering() const {
     m_swapchain->PrepareRendering();
     m_swapchain->StartRendering();
 }
 
 void RND_Renderer::Layer2D::Render(long frameIdx) {
-    ID3D12Device* device = VRManager::instance().D3D12->GetDevice();
-    ID3D12CommandQueue* queue = VRManager::instance().D3D12->GetCommandQueue();
-    ID3D12CommandAllocator* allocator = VRManager::instance().D3D12->GetFrameAllocator();
-
-    RND_D3D12::CommandContext<false> renderSharedTexture(device, queue, allocator, [this, frameIdx](RND_D3D12::CommandContext<false>* context) {
-        context->GetRecordList()->SetName(L"RenderSharedTexture");
+    // gets recorded into the frame's command list, which the renderer submits once all layers are recorded
+    RND_D3D12::CommandContext<false> renderSharedTexture(VRManager::instance().D3D12.get(), [this, frameIdx](RND_D3D12::CommandContext<false>* context) {
 
         // wait for both since we only have one 2D swap buffer to render to
         // fixme: Why do we signal to the global command list instead of the local one?!
@@ -559,7 +766,7 @@ std::vector<XrCompositionLayerQuad> RND_Renderer::Layer2D::FinishRendering(XrTim
     // clang-format on
 
     // render layer twice to visualize the controller positions in debug mode
-    auto inputs = VRManager::instance().XR->m_input.load();
+    auto inputs = VRManager::instance().XR->m_input.Load();
 
     if (!(inputs.inGame.in_game && inputs.inGame.pose[OpenXR::EyeSide::LEFT].isActive && inputs.inGame.pose[OpenXR::EyeSide::RIGHT].isActive)) {
         return layers;
@@ -2,7 +2,9 @@
 
 #include "pch.h"
 #include "d3d12.h"
+#include "latched_views.h"
 #include "openxr.h"
+#include "resolution_scaler.h"
 #include "swapchain.h"
 #include "texture.h"
 
@@ -14,33 +16,41 @@ public:
     ~RND_Renderer();
 
     struct RenderFrame {
-        std::optional<std::array<XrView, 2>> views;
+        LatchedViews<XrView> views;
         std::atomic_bool copiedColor[2] = { false, false };
         std::atomic_bool copiedDepth[2] = { false, false };
         std::atomic_bool copied2D = false;
         std::atomic_bool presented3D = false;
+        // single-pass stereo, the game only drew the left eye and the right eye gets reprojected from it
+        std::atomic_bool reprojectRightEye = false;
 
         std::unique_ptr<VulkanTexture> mainFramebuffer;
         std::unique_ptr<VulkanTexture> hudFramebuffer;
-        std::unique_ptr<VulkanTexture> hudWithoutAlphaFramebuffer;
         std::unique_ptr<VulkanFramebuffer> imguiFramebuffer;
         VkDescriptorSet mainFramebufferDS = VK_NULL_HANDLE;
         VkDescriptorSet hudFramebufferDS = VK_NULL_HANDLE;
+        // samples hudFramebuffer through its opaque view
         VkDescriptorSet hudWithoutAlphaFramebufferDS = VK_NULL_HANDLE;
         float mainFramebufferAspectRatio = 1.0f;
 
         bool ranMotionAnalysis[2] = { false, false };
 
-        bool Is3DComplete() const { return copiedColor[0] && copiedColor[1] && copiedDepth[0] && copiedDepth[1]; }
+        bool Is3DComplete() const {
+            if (reprojectRightEye) {
+                return copiedColor[OpenXR::EyeSide::LEFT] && copiedDepth[OpenXR::EyeSide::LEFT];
+            }
+            return copiedColor[0] && copiedColor[1] && copiedDepth[0] && copiedDepth[1];
+        }
         bool Is2DComplete() const { return copied2D; }
 
         void Reset() {
-            views = std::nullopt;
+            views.Reset();
             copiedColor[0] = false;
             copiedColor[1] = false;
             copiedDepth[0] = false;
             copiedDepth[1] = false;
             copied2D = false;
+            reprojectRightEye = false;
 
             ranMotionAnalysis[0] = false;
             ranMotionAnalysis[1] = false;
@@ -49,33 +59,35 @@ public:
 
     void StartFrame();
     void EndFrame();
+    // acquires this frame's swapchain images and polls them without blocking, so EndFrame rarely has to wait on the compositor
+    void PollSwapchainImages();
     std::optional<std::array<XrView, 2>> UpdateViews(XrTime predictedDisplayTime);
     
-    std::optional<std::array<XrView, 2>> GetPoses(long frameIdx = -1) const { 
-        if (frameIdx != -1 && m_renderFrames[frameIdx].views.has_value()) return m_renderFrames[frameIdx].views;
-        return m_currViews; 
+    // the views a frame was rendered with, or the latest located views when there's no frame or it wasn't rendered yet
+    std::optional<std::array<XrView, 2>> GetPoses(long frameIdx = -1) const {
+        if (frameIdx != -1) {
+            if (auto views = m_renderFrames[frameIdx].views.Get()) return views;
+        }
+        return m_currViews.Load();
     }
     
     std::optional<XrFovf> GetFOV(OpenXR::EyeSide side, long frameIdx = -1) const { 
-        const auto& views = (frameIdx != -1 && m_renderFrames[frameIdx].views.has_value()) ? m_renderFrames[frameIdx].views : m_currViews;
-        return views.transform([side](auto& views) { return views[side].fov; }); 
+        return GetPoses(frameIdx).transform([side](const auto& views) { return views[side].fov; }); 
     }
     
     std::optional<XrPosef> GetPose(OpenXR::EyeSide side, long frameIdx = -1) const { 
-        const auto& views = (frameIdx != -1 && m_renderFrames[frameIdx].views.has_value()) ? m_renderFrames[frameIdx].views : m_currViews;
-        return views.transform([side](auto& views) { return views[side].pose; }); 
+        return GetPoses(frameIdx).transform([side](const auto& views) { return views[side].pose; }); 
     }
     
     std::optional<glm::fmat4> GetPoseAsMatrix(OpenXR::EyeSide side, long frameIdx = -1) const {
-        const auto& views = (frameIdx != -1 && m_renderFrames[frameIdx].views.has_value()) ? m_renderFrames[frameIdx].views : m_currViews;
-        return views.transform([side](auto& views) {
+        return GetPoses(frameIdx).transform([side](const auto& views) {
             const XrPosef& pose = views[side].pose;
             return ToMat4(ToGLM(pose.position), ToGLM(pose.orientation));
         });
     };
     
     std::optional<glm::fmat4> GetMiddlePose(long frameIdx = -1) const {
-        const auto& views = (frameIdx != -1 && m_renderFrames[frameIdx].views.has_value()) ? m_renderFrames[frameIdx].views : m_currViews;
+        const auto views = GetPoses(frameIdx);
         if (!views.has_value()) return std::nullopt;
         const XrPosef& leftPose = views->at(OpenXR::EyeSide::LEFT).pose;
         const XrPosef& rightPose = views->at(OpenXR::EyeSide::RIGHT).pose;
@@ -85,15 +97,9 @@ public:
         return ToMat4(middlePos, middleOri);
     };
 
-    void On3DColorCopied(OpenXR::EyeSide side, long frameIdx) {
-        m_renderFrames[frameIdx].copiedColor[side] = true;
-        if (!m_renderFrames[frameIdx].views.has_value()) m_renderFrames[frameIdx].views = m_currViews;
-    }
-
-    void On3DDepthCopied(OpenXR::EyeSide side, long frameIdx) {
-        m_renderFrames[frameIdx].copiedDepth[side] = true;
-        if (!m_renderFrames[frameIdx].views.has_value()) m_renderFrames[frameIdx].views = m_currViews;
-    }
+    void LatchView(OpenXR::EyeSide side, long frameIdx);
+    void On3DColorCopied(OpenXR::EyeSide side, long frameIdx);
+    void On3DDepthCopied(OpenXR::EyeSide side, long frameIdx);
 
     void On2DCopied(long frameIdx) {
         m_renderFrames[frameIdx].copied2D = true;
@@ -107,17 +113,36 @@ public:
         explicit Layer3D(VkExtent2D extent);
         ~Layer3D();
 
-        SharedTexture* CopyColorToLayer(OpenXR::EyeSide side, VkCommandBuffer copyCmdBuffer, VkImage image, long frameIdx, VkImageLayout srcImageLayout);
-        SharedTexture* CopyDepthToLayer(OpenXR::EyeSide side, VkCommandBuffer copyCmdBuffer, VkImage image, long frameIdx, VkImageLayout srcImageLayout);
+        SharedTexture* CopyColorToLayer(OpenXR::EyeSide side, VulkanUtils::BarrierBatch& barriers, VkImage image, long frameIdx, VkImageLayout srcImageLayout);
+        SharedTexture* CopyDepthToLayer(OpenXR::EyeSide side, VulkanUtils::BarrierBatch& barriers, VkImage image, long frameIdx, VkImageLayout srcImageLayout);
         void PrepareRendering(OpenXR::EyeSide side);
+        void AcquireImages();
         void StartRendering();
-        void Render(OpenXR::EyeSide side, long frameIdx);
+        // renders both eyes, either one after another or with a single draw when the eyes share stereo swapchains
+        void Render(long frameIdx);
+        // renders the left eye, and reconstructs the right eye from the left eye's color and depth
+        void RenderReprojected(long frameIdx);
         const std::array<XrCompositionLayerProjectionView, 2>& FinishRendering(long frameIdx);
 
-        float GetAspectRatio(OpenXR::EyeSide side) const { return m_swapchains[side]->GetWidth() / (float)m_swapchains[side]->GetHeight(); }
+        float GetAspectRatio(OpenXR::EyeSide side) const { return GetSwapchain(side)->GetWidth() / (float)GetSwapchain(side)->GetHeight(); }
         long GetCurrentFrameIdx() const { return m_currentFrameIdx; }
+        // the user's scale the swapchains were created with, relative to the runtime's recommended size
+        float GetRenderScale() const { return m_renderScale; }
 
     private:
+        // with stereo swapchains only the LEFT swapchains and present pipeline exist, and each eye is a layer of their images
+        Swapchain<DXGI_FORMAT_R8G8B8A8_UNORM_SRGB>* GetSwapchain(OpenXR::EyeSide side) const { return m_swapchains[m_stereoSwapchains ? OpenXR::EyeSide::LEFT : side].get(); }
+        Swapchain<DXGI_FORMAT_D32_FLOAT>* GetDepthSwapchain(OpenXR::EyeSide side) const { return m_depthSwapchains[m_stereoSwapchains ? OpenXR::EyeSide::LEFT : side].get(); }
+        uint32_t GetArrayIndex(OpenXR::EyeSide side) const { return m_stereoSwapchains ? (uint32_t)side : 0; }
+
+        void RenderEye(OpenXR::EyeSide side, long frameIdx);
+        void RenderStereo(long frameIdx);
+        // binds the textures of both eyes with stereo swapchains, otherwise only the first ones are used
+        void RenderToSwapchain(ID3D12GraphicsCommandList* cmdList, OpenXR::EyeSide side, const std::array<SharedTexture*, 2>& textures, const std::array<SharedTexture*, 2>& depthTextures);
+
+        bool m_stereoSwapchains = false;
+        float m_renderScale = 1.0f;
+
         std::array<std::unique_ptr<Swapchain<DXGI_FORMAT_R8G8B8A8_UNORM_SRGB>>, 2> m_swapchains;
         std::array<std::unique_ptr<Swapchain<DXGI_FORMAT_D32_FLOAT>>, 2> m_depthSwapchains;
         std::array<std::unique_ptr<RND_D3D12::PresentPipeline<true>>, 2> m_presentPipelines;
@@ -126,6 +151,8 @@ public:
 
         std::array<XrCompositionLayerProjectionView, 2> m_projectionViews = {};
         std::array<XrCompositionLayerDepthInfoKHR, 2> m_projectionViewsDepthInfo = {};
+        // part of the swapchain images that's rendered to this frame, smaller than the swapchains when the dynamic mode gives back some supersampling
+        std::array<XrExtent2Di, 2> m_renderExtents = {};
 
         long m_currentFrameIdx = 0;
     };
@@ -135,13 +162,14 @@ public:
         explicit Layer2D(VkExtent2D extent);
         ~Layer2D();
 
-        SharedTexture* CopyColorToLayer(VkCommandBuffer copyCmdBuffer, VkImage image, long frameIdx, VkImageLayout srcImageLayout);
+        SharedTexture* CopyColorToLayer(VulkanUtils::BarrierBatch& barriers, VkImage image, long frameIdx, VkImageLayout srcImageLayout);
         // AMD GPU FIX: With incrementing values, Vulkan signals odd values (1,3,5...), D3D12 signals even values (2,4,6...)
         // Texture is ready for D3D12 when Vulkan has signaled (odd value > 0)
         bool IsTextureReady(long frameIdx) const {
             uint64_t lastSignal = m_textures[frameIdx]->GetLastSignalledValue();
             return lastSignal > 0 && (lastSignal % 2 == 1);
         };
+        void AcquireImages() const;
         void StartRendering() const;
         void Render(long frameIdx);
         std::vector<XrCompositionLayerQuad> FinishRendering(XrTime predictedDisplayTime, long frameIdx);
@@ -168,11 +196,11 @@ public:
 
         void BeginFrame(long frameIdx, bool renderBackground);
         // AMD GPU FIX: Added srcLayout parameter to specify the actual source image layout
-        static void Draw3DLayerAsBackground(VkCommandBuffer cb, VkImage srcImage, float aspectRatio, long frameIdx, VkImageLayout srcLayout);
-        static void DrawHUDLayerAsBackground(VkCommandBuffer cb, VkImage srcImage, long frameIdx, VkImageLayout srcLayout);
+        static void Draw3DLayerAsBackground(VulkanUtils::BarrierBatch& barriers, VkImage srcImage, float aspectRatio, long frameIdx, VkImageLayout srcLayout);
+        static void DrawHUDLayerAsBackground(VulkanUtils::BarrierBatch& barriers, VkImage srcImage, long frameIdx, VkImageLayout srcLayout);
         void Update();
         void Render();
-        void DrawAndCopyToImage(VkCommandBuffer cb, VkImage destImage, long frameIdx);
+        void DrawAndCopyToImage(VulkanUtils::BarrierBatch& barriers, VkImage destImage, long frameIdx);
 
     private:
         VkDescriptorPool m_descriptorPool;
@@ -197,12 +225,18 @@ public:
     bool IsInitialized() {
         return m_isInitialized;
     }
+    const ResolutionScaler& GetResolutionScaler() const {
+        return m_resolutionScaler;
+    }
 
 protected:
     XrSession m_session;
     XrFrameState m_frameState = { XR_TYPE_FRAME_STATE };
-    std::optional<std::array<XrView, 2>> m_currViews;
+    // only written by UpdateViews, which StartFrame and EndFrame call from the camera hooks, while the framebuffer copies on Cemu's render thread read it too
+    SeqLock<std::optional<std::array<XrView, 2>>> m_currViews;
     std::array<RenderFrame, 2> m_renderFrames;
+    ResolutionScaler m_resolutionScaler;
+    ResolutionScaler::GpuTimings m_lastGpuTimings;
 
     std::atomic_bool m_isInitialized = false;
     std::atomic_bool m_presented2DLastFrame = false;
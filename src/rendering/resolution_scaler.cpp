@@ -0,0 +1,66 @@
+#include "resolution_scaler.h"
+
+ResolutionScaler::Extent ResolutionScaler::GetScaledSize(uint32_t recommendedWidth, uint32_t recommendedHeight, uint32_t maxWidth, uint32_t maxHeight, float scale) {
+    auto scaleDimension = [scale](uint32_t recommended, uint32_t max) -> int32_t {
+        uint32_t size = (uint32_t)std::lround((double)recommended * scale);
+        size = std::clamp(size, std::min(MIN_SWAPCHAIN_SIZE, max), max);
+        // some runtimes don't like odd sizes, and the dynamic mode halves them
+        return (int32_t)(size > 1 ? size & ~1u : size);
+    };
+    return { scaleDimension(recommendedWidth, maxWidth), scaleDimension(recommendedHeight, maxHeight) };
+}
+
+void ResolutionScaler::Update(const GpuTimings& timings, double frameIntervalMs, float renderScale) {
+    if (timings.presentMs <= 0.0 || frameIntervalMs <= 0.0) {
+        return;
+    }
+
+    // the present passes cost roughly the amount of pixels they write, so track what they'd take at the full size
+    const double fullPresentMs = timings.presentMs / double(m_dynamicScale * m_dynamicScale);
+    if (!m_smoothedTimings.has_value()) {
+        m_smoothedTimings = timings;
+        m_fullPresentMs = fullPresentMs;
+    }
+    else {
+        auto smooth = [](double& smoothed, double sample) {
+            smoothed += (sample - smoothed) * SMOOTHING_FACTOR;
+        };
+        if (!timings.gameMs.has_value() || !m_smoothedTimings->gameMs.has_value()) {
+            m_smoothedTimings->gameMs = timings.gameMs;
+        }
+        else {
+            smooth(m_smoothedTimings->gameMs.value(), timings.gameMs.value());
+        }
+        smooth(m_smoothedTimings->copyMs, timings.copyMs);
+        smooth(m_smoothedTimings->presentMs, timings.presentMs);
+        smooth(m_fullPresentMs, fullPresentMs);
+    }
+
+    // only the supersampling can be given back, going below the recommended size is left to the user's scale
+    const float minScale = std::clamp(1.0f / renderScale, MIN_DYNAMIC_SCALE, 1.0f);
+    m_dynamicScale = std::max(m_dynamicScale, minScale);
+
+    const double targetMs = frameIntervalMs * TARGET_INTERVAL_FRACTION;
+    const double fixedMs = m_smoothedTimings->gameMs.value_or(0.0) + m_smoothedTimings->copyMs;
+    if (fixedMs >= targetMs) {
+        // the game alone doesn't fit, shrinking the image rects can't bring the frame back so don't sacrifice any sharpness for it
+        return;
+    }
+
+    const float wantedScale = std::clamp((float)std::sqrt((targetMs - fixedMs) / m_fullPresentMs), minScale, 1.0f);
+
+    // drop quickly when over budget since that's judder, but grow back slowly to avoid oscillating around the limit
+    if (wantedScale < m_dynamicScale) {
+        m_dynamicScale = std::max(wantedScale, m_dynamicScale - SCALE_DOWN_STEP);
+    }
+    else if (wantedScale > m_dynamicScale + SCALE_UP_HYSTERESIS || wantedScale == 1.0f) {
+        m_dynamicScale = std::min(wantedScale, m_dynamicScale + SCALE_UP_STEP);
+    }
+}
+
+ResolutionScaler::Extent ResolutionScaler::GetRenderExtent(uint32_t width, uint32_t height) const {
+    return {
+        std::max(1, (int32_t)std::lround(width * m_dynamicScale)),
+        std::max(1, (int32_t)std::lround(height * m_dynamicScale))
+    };
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+// Decides how large the swapchains are and how much of them gets rendered to.
+// The swapchains are allocated once at the headset's recommended size times the user's scale. When that supersamples,
+// the dynamic mode gives back some of the supersampling by presenting to a smaller part of the swapchain images, which
+// only changes the image rects that get submitted instead of recreating the swapchains.
+//
+// This doesn't control the GPU frame time. The game's own passes render at the graphic pack's resolution regardless,
+// so only the layer's present passes and the runtime's compositor get cheaper. The game and copy times are treated as a
+// fixed cost, and the image rect is sized so that the present passes fit into what's left of the frame interval. It never
+// goes below the recommended size, presenting the game's image at less than that costs sharpness without saving much.
+// It doesn't touch anything besides its own state and doesn't need OpenXR, so the host build can feed it synthetic timings.
+class ResolutionScaler {
+public:
+    static constexpr float MIN_DYNAMIC_SCALE = 0.5f;
+    static constexpr uint32_t MIN_SWAPCHAIN_SIZE = 64;
+
+    // same fields as XrExtent2Di
+    struct Extent {
+        int32_t width;
+        int32_t height;
+    };
+
+    struct GpuTimings {
+        std::optional<double> gameMs; // not measurable when the game only draws one eye
+        double copyMs = 0.0;
+        double presentMs = 0.0;
+    };
+
+    // recommended size times scale, clamped to what the runtime supports
+    static Extent GetScaledSize(uint32_t recommendedWidth, uint32_t recommendedHeight, uint32_t maxWidth, uint32_t maxHeight, float scale);
+
+    // renderScale is the scale the swapchains were created with, the dynamic scale only takes back what's above 1
+    void Update(const GpuTimings& timings, double frameIntervalMs, float renderScale);
+    void Reset() {
+        m_dynamicScale = 1.0f;
+        m_smoothedTimings.reset();
+    }
+
+    float GetDynamicScale() const { return m_dynamicScale; }
+    const std::optional<GpuTimings>& GetSmoothedTimings() const { return m_smoothedTimings; }
+    Extent GetRenderExtent(uint32_t width, uint32_t height) const;
+
+private:
+    // leave some of the frame interval for the runtime's compositor
+    static constexpr double TARGET_INTERVAL_FRACTION = 0.85;
+    // weight of each new sample, the timings of single frames are too noisy to act on
+    static constexpr double SMOOTHING_FACTOR = 0.1;
+    static constexpr float SCALE_DOWN_STEP = 0.05f;
+    static constexpr float SCALE_UP_STEP = 0.01f;
+    // only grow again once the wanted scale is clearly above the current one, otherwise it'd flip between two sizes every other frame
+    static constexpr float SCALE_UP_HYSTERESIS = 0.05f;
+
+    float m_dynamicScale = 1.0f;
+    std::optional<GpuTimings> m_smoothedTimings;
+    double m_fullPresentMs = 0.0;
+};
@@ -0,0 +1,143 @@
+#include "catch.h"
+#include "rendering/resolution_scaler.h"
+
+TEST_CASE("ResolutionScaler sizes swapchains from the recommended size", "[resolution_scaler]") {
+    // Quest 3's recommended and maximum image rect
+    constexpr uint32_t RECOMMENDED_WIDTH = 2064;
+    constexpr uint32_t RECOMMENDED_HEIGHT = 2208;
+    constexpr uint32_t MAX_WIDTH = 4128;
+    constexpr uint32_t MAX_HEIGHT = 4416;
+
+    auto scaledSize = [](float scale) {
+        return ResolutionScaler::GetScaledSize(RECOMMENDED_WIDTH, RECOMMENDED_HEIGHT, MAX_WIDTH, MAX_HEIGHT, scale);
+    };
+
+    CHECK(scaledSize(1.0f).width == 2064);
+    CHECK(scaledSize(1.0f).height == 2208);
+    CHECK(scaledSize(0.5f).width == 1032);
+    CHECK(scaledSize(0.5f).height == 1104);
+
+    SECTION("sizes are rounded down to even numbers") {
+        const ResolutionScaler::Extent size = scaledSize(0.7f);
+        CHECK(size.width == 1444); // 1444.8 rounds to 1445, which is odd
+        CHECK(size.height == 1546);
+        CHECK(size.width % 2 == 0);
+        CHECK(size.height % 2 == 0);
+    }
+
+    SECTION("supersampling stops at the runtime's maximum") {
+        CHECK(scaledSize(1.5f).width == 3096);
+        CHECK(scaledSize(3.0f).width == (int32_t)MAX_WIDTH);
+        CHECK(scaledSize(3.0f).height == (int32_t)MAX_HEIGHT);
+    }
+
+    SECTION("tiny scales still get a usable swapchain") {
+        CHECK(scaledSize(0.001f).width == (int32_t)ResolutionScaler::MIN_SWAPCHAIN_SIZE);
+        CHECK(scaledSize(0.0f).height == (int32_t)ResolutionScaler::MIN_SWAPCHAIN_SIZE);
+    }
+
+    SECTION("a maximum below the minimum size wins") {
+        const ResolutionScaler::Extent size = ResolutionScaler::GetScaledSize(100, 100, 32, 31, 1.0f);
+        CHECK(size.width == 32);
+        CHECK(size.height == 30);
+    }
+}
+
+namespace {
+    constexpr double FRAME_INTERVAL_MS = 1000.0 / 90.0;
+
+    // present passes that cost presentMsAtFullSize when rendering to the whole swapchain, and less in proportion to the pixels otherwise
+    ResolutionScaler::GpuTimings PresentTimings(const ResolutionScaler& scaler, std::optional<double> gameMs, double presentMsAtFullSize) {
+        const double scale = scaler.GetDynamicScale();
+        return { .gameMs = gameMs, .copyMs = 0.5, .presentMs = presentMsAtFullSize * scale * scale };
+    }
+}
+
+TEST_CASE("ResolutionScaler renders to the full swapchain unless the dynamic mode scaled it down", "[resolution_scaler]") {
+    ResolutionScaler scaler;
+    CHECK(scaler.GetDynamicScale() == 1.0f);
+    CHECK(scaler.GetRenderExtent(2064, 2208).width == 2064);
+    CHECK(scaler.GetRenderExtent(2064, 2208).height == 2208);
+    CHECK_FALSE(scaler.GetSmoothedTimings().has_value());
+
+    // timings that don't fit make it shrink, resetting returns to the full size
+    scaler.Update({ .gameMs = 2.0, .copyMs = 0.5, .presentMs = 20.0 }, FRAME_INTERVAL_MS, 1.5f);
+    CHECK(scaler.GetDynamicScale() < 1.0f);
+    CHECK(scaler.GetRenderExtent(2064, 2208).width < 2064);
+
+    scaler.Reset();
+    CHECK(scaler.GetDynamicScale() == 1.0f);
+    CHECK_FALSE(scaler.GetSmoothedTimings().has_value());
+    CHECK(scaler.GetRenderExtent(1, 1).width == 1);
+}
+
+TEST_CASE("ResolutionScaler only gives back supersampling", "[resolution_scaler]") {
+    ResolutionScaler scaler;
+
+    SECTION("without supersampling it never shrinks") {
+        for (int frame = 0; frame < 200; frame++) {
+            scaler.Update(PresentTimings(scaler, 4.0, 20.0), FRAME_INTERVAL_MS, 1.0f);
+        }
+        CHECK(scaler.GetDynamicScale() == 1.0f);
+    }
+
+    SECTION("it stops at the recommended size") {
+        for (int frame = 0; frame < 200; frame++) {
+            scaler.Update(PresentTimings(scaler, 4.0, 20.0), FRAME_INTERVAL_MS, 1.25f);
+        }
+        CHECK(scaler.GetDynamicScale() == Approx(1.0f / 1.25f));
+    }
+
+    SECTION("it never goes below the minimum dynamic scale") {
+        for (int frame = 0; frame < 200; frame++) {
+            scaler.Update(PresentTimings(scaler, 4.0, 50.0), FRAME_INTERVAL_MS, 3.0f);
+        }
+        CHECK(scaler.GetDynamicScale() == ResolutionScaler::MIN_DYNAMIC_SCALE);
+    }
+}
+
+TEST_CASE("ResolutionScaler fits the present passes into the rest of the frame interval", "[resolution_scaler]") {
+    ResolutionScaler scaler;
+    const double budgetMs = FRAME_INTERVAL_MS * 0.85;
+
+    // a heavy scene: the present passes at the full supersampled size take twice what's left after the game
+    const double gameMs = 5.0;
+    const double presentMsAtFullSize = (budgetMs - gameMs - 0.5) * 2.0;
+    for (int frame = 0; frame < 300; frame++) {
+        scaler.Update(PresentTimings(scaler, gameMs, presentMsAtFullSize), FRAME_INTERVAL_MS, 2.0f);
+    }
+    const float heavyScale = scaler.GetDynamicScale();
+    CHECK(heavyScale == Approx(std::sqrt(0.5f)).margin(0.02f));
+    CHECK(PresentTimings(scaler, gameMs, presentMsAtFullSize).presentMs + gameMs + 0.5 <= budgetMs * 1.01);
+
+    // it grows back slowly once the scene gets lighter
+    scaler.Update(PresentTimings(scaler, gameMs, presentMsAtFullSize / 4.0), FRAME_INTERVAL_MS, 2.0f);
+    CHECK(scaler.GetDynamicScale() <= heavyScale + 0.01f + 1e-6f);
+    for (int frame = 0; frame < 300; frame++) {
+        scaler.Update(PresentTimings(scaler, gameMs, presentMsAtFullSize / 4.0), FRAME_INTERVAL_MS, 2.0f);
+    }
+    CHECK(scaler.GetDynamicScale() == 1.0f);
+}
+
+TEST_CASE("ResolutionScaler doesn't trade sharpness for frames the game alone misses", "[resolution_scaler]") {
+    ResolutionScaler scaler;
+    for (int frame = 0; frame < 200; frame++) {
+        scaler.Update(PresentTimings(scaler, 15.0, 20.0), FRAME_INTERVAL_MS, 2.0f);
+    }
+    CHECK(scaler.GetDynamicScale() == 1.0f);
+}
+
+TEST_CASE("ResolutionScaler works without the game's GPU time", "[resolution_scaler]") {
+    // with single-pass stereo only one eye gets copied, so there's no gap between copies to measure the game with
+    ResolutionScaler scaler;
+    for (int frame = 0; frame < 200; frame++) {
+        scaler.Update(PresentTimings(scaler, std::nullopt, 20.0), FRAME_INTERVAL_MS, 2.0f);
+    }
+    REQUIRE(scaler.GetSmoothedTimings().has_value());
+    CHECK_FALSE(scaler.GetSmoothedTimings()->gameMs.has_value());
+    CHECK(scaler.GetDynamicScale() < 1.0f);
+
+    // once it's measured again it's used right away instead of being smoothed from zero
+    scaler.Update(PresentTimings(scaler, 3.0, 20.0), FRAME_INTERVAL_MS, 2.0f);
+    CHECK(scaler.GetSmoothedTimings()->gameMs == 3.0);
+}
@@ -1,9 +1,10 @@
 #include "swapchain.h"
 #include "utils/d3d12_utils.h"
+#include "utils/telemetry.h"
 #include "instance.h"
 
 template <DXGI_FORMAT T>
-Swapchain<T>::Swapchain(uint32_t width, uint32_t height, uint32_t sampleCount): m_width(width), m_height(height) {
+Swapchain<T>::Swapchain(uint32_t width, uint32_t height, uint32_t sampleCount, uint32_t arraySize): m_width(width), m_height(height), m_arraySize(arraySize) {
     auto getBestSwapchainFormat = [](const std::vector<DXGI_FORMAT>& applicationSupportedFormats) -> DXGI_FORMAT {
         // Finds the first matching DXGI_FORMAT (int) that matches the int64 from OpenXR
         uint32_t swapchainCount = 0;
@@ -27,7 +28,7 @@ Swapchain<T>::Swapchain(uint32_t width, uint32_t height, uint32_t sampleCount):
     XrSwapchainCreateInfo swapchainCreateInfo = { XR_TYPE_SWAPCHAIN_CREATE_INFO };
     swapchainCreateInfo.width = width;
     swapchainCreateInfo.height = height;
-    swapchainCreateInfo.arraySize = 1;
+    swapchainCreateInfo.arraySize = arraySize;
     swapchainCreateInfo.sampleCount = sampleCount;
     swapchainCreateInfo.format = m_format;
     swapchainCreateInfo.mipCount = 1;
@@ -48,17 +49,44 @@ Swapchain<T>::Swapchain(uint32_t width, uint32_t height, uint32_t sampleCount):
     }
 }
 
+template <DXGI_FORMAT T>
+bool Swapchain<T>::AcquireAndPoll() {
+    PrepareRendering();
+    if (m_imageState == ImageState::ACQUIRED) {
+        XrSwapchainImageWaitInfo waitSwapchainInfo = { XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO };
+        waitSwapchainInfo.timeout = 0;
+        XrResult waitResult = xrWaitSwapchainImage(m_swapchain, &waitSwapchainInfo);
+        if (waitResult == XR_SUCCESS) {
+            m_imageState = ImageState::READY;
+        }
+        else if (waitResult != XR_TIMEOUT_EXPIRED) {
+            checkXRResult(waitResult, "Failed to poll swapchain image!");
+        }
+    }
+    return m_imageState == ImageState::READY;
+}
+
 template <DXGI_FORMAT T>
 void Swapchain<T>::PrepareRendering() {
-    checkXRResult(xrAcquireSwapchainImage(m_swapchain, NULL, &m_swapchainImageIdx), "Can't acquire OpenXR swapchain image!");
+    if (m_imageState == ImageState::RELEASED) {
+        checkXRResult(xrAcquireSwapchainImage(m_swapchain, NULL, &m_swapchainImageIdx), "Can't acquire OpenXR swapchain image!");
+        m_imageState = ImageState::ACQUIRED;
+    }
 }
 
 template <DXGI_FORMAT T>
 ID3D12Resource* Swapchain<T>::StartRendering() {
-    XrSwapchainImageWaitInfo waitSwapchainInfo = { XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO };
-    waitSwapchainInfo.timeout = XR_INFINITE_DURATION;
-    if (XrResult waitResult = xrWaitSwapchainImage(m_swapchain, &waitSwapchainInfo); waitResult == XR_TIMEOUT_EXPIRED || XR_FAILED(waitResult)) {
-        checkXRResult(waitResult, "Failed to wait for swapchain image!");
+    static const Telemetry::CounterId s_blockingWaitCounter = Telemetry::Register("xrWaitSwapchainImage (Blocking)", Telemetry::Category::FRAME);
+
+    checkAssert(m_imageState != ImageState::RELEASED, "Swapchain image needs to be acquired before rendering to it!");
+    if (m_imageState == ImageState::ACQUIRED) {
+        Telemetry::ScopedTimer timer(s_blockingWaitCounter);
+        XrSwapchainImageWaitInfo waitSwapchainInfo = { XR_TYPE_SWAPCHAIN_IMAGE_WAIT_INFO };
+        waitSwapchainInfo.timeout = XR_INFINITE_DURATION;
+        if (XrResult waitResult = xrWaitSwapchainImage(m_swapchain, &waitSwapchainInfo); waitResult == XR_TIMEOUT_EXPIRED || XR_FAILED(waitResult)) {
+            checkXRResult(waitResult, "Failed to wait for swapchain image!");
+        }
+        m_imageState = ImageState::READY;
     }
     return m_swapchainTextures[m_swapchainImageIdx].Get();
 }
@@ -67,6 +95,7 @@ template <DXGI_FORMAT T>
 void Swapchain<T>::FinishRendering() {
     XrSwapchainImageReleaseInfo releaseSwapchainInfo = { XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO };
     checkXRResult(xrReleaseSwapchainImage(m_swapchain, &releaseSwapchainInfo), "Failed to release swapchain image!");
+    m_imageState = ImageState::RELEASED;
 }
 
 template <DXGI_FORMAT T>
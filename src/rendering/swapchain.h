@@ -3,10 +3,16 @@
 template <DXGI_FORMAT T>
 class Swapchain {
 public:
-    Swapchain(uint32_t width, uint32_t height, uint32_t sampleCount);
+    // arraySize of 2 holds both eyes, which are then told apart by XrSwapchainSubImage::imageArrayIndex
+    Swapchain(uint32_t width, uint32_t height, uint32_t sampleCount, uint32_t arraySize = 1);
     ~Swapchain();
 
+    // Acquires the next image if none is held yet, and checks without blocking whether the runtime is done reading it.
+    // Can be called as often as wanted before StartRendering(), returns whether the image is ready to be rendered to.
+    bool AcquireAndPoll();
+
     void PrepareRendering();
+    // only blocks if the image still wasn't ready the last time it got polled
     ID3D12Resource* StartRendering();
     void FinishRendering();
 
@@ -16,13 +22,23 @@ public:
     DXGI_FORMAT GetFormat() const { return m_format; };
     [[nodiscard]] uint32_t GetWidth() const { return m_width; };
     [[nodiscard]] uint32_t GetHeight() const { return m_height; };
+    [[nodiscard]] uint32_t GetArraySize() const { return m_arraySize; };
 
 private:
     XrSwapchain m_swapchain = XR_NULL_HANDLE;
     uint32_t m_width;
     uint32_t m_height;
+    uint32_t m_arraySize;
     DXGI_FORMAT m_format;
 
     std::vector<ComPtr<ID3D12Resource>> m_swapchainTextures;
     uint32_t m_swapchainImageIdx = 0;
+
+    // an acquired image can be held across frames that don't render this swapchain, until it's released by FinishRendering()
+    enum class ImageState {
+        RELEASED,
+        ACQUIRED,
+        READY
+    };
+    ImageState m_imageState = ImageState::RELEASED;
 };
\ No newline at end of file
@@ -15,21 +15,16 @@ BaseVulkanTexture::~BaseVulkanTexture() {
     }
 }
 
-void BaseVulkanTexture::vkPipelineBarrier(VkCommandBuffer cmdBuffer) {
-    return VulkanUtils::DebugPipelineBarrier(cmdBuffer);
-}
-
 VkImageAspectFlags BaseVulkanTexture::GetAspectMask() const {
     return VulkanUtils::GetAspectMaskForFormat(m_vkFormat);
 }
 
-void BaseVulkanTexture::vkTransitionLayout(VkCommandBuffer cmdBuffer, VkImageLayout newLayout) {
-    VulkanUtils::TransitionLayout(cmdBuffer, m_vkImage, m_vkCurrLayout, newLayout, GetAspectMask());
+void BaseVulkanTexture::vkTransitionLayout(VulkanUtils::BarrierBatch& barriers, VkImageLayout newLayout) {
+    barriers.Transition(m_vkImage, m_vkCurrLayout, newLayout, GetAspectMask());
     m_vkCurrLayout = newLayout;
 }
 
-void BaseVulkanTexture::vkCopyToImage(VkCommandBuffer cmdBuffer, VkImage dstImage) {
-    auto* dispatch = VRManager::instance().VK->GetDeviceDispatch();
+void BaseVulkanTexture::vkCopyToImage(VulkanUtils::BarrierBatch& barriers, VkImage dstImage) {
     VkImageAspectFlags aspectMask = GetAspectMask();
 
     const VkImageCopy region = {
@@ -44,24 +39,12 @@ void BaseVulkanTexture::vkCopyToImage(VkCommandBuffer cmdBuffer, VkImage dstImag
         }
     };
 
-    dispatch->CmdCopyImage(cmdBuffer, m_vkImage, m_vkCurrLayout, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-    // AMD GPU FIX: Add memory barrier after copy to ensure data is visible
-    VkMemoryBarrier2 postCopyBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
-    postCopyBarrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-    postCopyBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-    postCopyBarrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-    postCopyBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
-
-    VkDependencyInfo depInfo = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
-    depInfo.memoryBarrierCount = 1;
-    depInfo.pMemoryBarriers = &postCopyBarrier;
-    dispatch->CmdPipelineBarrier2(cmdBuffer, &depInfo);
+    // the caller transitions dstImage out of TRANSFER_DST_OPTIMAL afterwards, which also makes the copied data visible
+    barriers.Flush();
+    barriers.GetDispatch()->CmdCopyImage(barriers.GetCommandBuffer(), m_vkImage, m_vkCurrLayout, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 }
 
-void BaseVulkanTexture::vkClear(VkCommandBuffer cmdBuffer, VkClearColorValue color) {
-    auto* dispatch = VRManager::instance().VK->GetDeviceDispatch();
-
+void BaseVulkanTexture::vkClear(VulkanUtils::BarrierBatch& barriers, VkClearColorValue color) {
     // Only use CmdClearColorImage for color images
     if (VulkanUtils::IsDepthFormat(m_vkFormat)) {
         Log::print<WARNING>("vkClear called on depth image - use vkClearDepth instead");
@@ -71,8 +54,7 @@ void BaseVulkanTexture::vkClear(VkCommandBuffer cmdBuffer, VkClearColorValue col
     // AMD GPU FIX: Transition to GENERAL if not already in a valid clear layout
     // CmdClearColorImage requires GENERAL or TRANSFER_DST_OPTIMAL
     if (m_vkCurrLayout != VK_IMAGE_LAYOUT_GENERAL && m_vkCurrLayout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-        VulkanUtils::TransitionLayout(cmdBuffer, m_vkImage, m_vkCurrLayout, VK_IMAGE_LAYOUT_GENERAL);
-        m_vkCurrLayout = VK_IMAGE_LAYOUT_GENERAL;
+        vkTransitionLayout(barriers, VK_IMAGE_LAYOUT_GENERAL);
     }
 
     const VkImageSubresourceRange range = {
@@ -83,12 +65,11 @@ void BaseVulkanTexture::vkClear(VkCommandBuffer cmdBuffer, VkClearColorValue col
         .layerCount = VK_REMAINING_ARRAY_LAYERS
     };
 
-    dispatch->CmdClearColorImage(cmdBuffer, m_vkImage, m_vkCurrLayout, &color, 1, &range);
+    barriers.Flush();
+    barriers.GetDispatch()->CmdClearColorImage(barriers.GetCommandBuffer(), m_vkImage, m_vkCurrLayout, &color, 1, &range);
 }
 
-void BaseVulkanTexture::vkClearDepth(VkCommandBuffer cmdBuffer, float depth, uint32_t stencil) {
-    auto* dispatch = VRManager::instance().VK->GetDeviceDispatch();
-
+void BaseVulkanTexture::vkClearDepth(VulkanUtils::BarrierBatch& barriers, float depth, uint32_t stencil) {
     if (!VulkanUtils::IsDepthFormat(m_vkFormat)) {
         Log::print<WARNING>("vkClearDepth called on color image - use vkClear instead");
         return;
@@ -97,8 +78,7 @@ void BaseVulkanTexture::vkClearDepth(VkCommandBuffer cmdBuffer, float depth, uin
     // AMD GPU FIX: Transition to GENERAL if not already in a valid clear layout
     // CmdClearDepthStencilImage requires GENERAL or TRANSFER_DST_OPTIMAL
     if (m_vkCurrLayout != VK_IMAGE_LAYOUT_GENERAL && m_vkCurrLayout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-        VulkanUtils::TransitionLayout(cmdBuffer, m_vkImage, m_vkCurrLayout, VK_IMAGE_LAYOUT_GENERAL, GetAspectMask());
-        m_vkCurrLayout = VK_IMAGE_LAYOUT_GENERAL;
+        vkTransitionLayout(barriers, VK_IMAGE_LAYOUT_GENERAL);
     }
 
     VkClearDepthStencilValue clearValue = {
@@ -114,11 +94,11 @@ void BaseVulkanTexture::vkClearDepth(VkCommandBuffer cmdBuffer, float depth, uin
         .layerCount = VK_REMAINING_ARRAY_LAYERS
     };
 
-    dispatch->CmdClearDepthStencilImage(cmdBuffer, m_vkImage, m_vkCurrLayout, &clearValue, 1, &range);
+    barriers.Flush();
+    barriers.GetDispatch()->CmdClearDepthStencilImage(barriers.GetCommandBuffer(), m_vkImage, m_vkCurrLayout, &clearValue, 1, &range);
 }
 
-void BaseVulkanTexture::vkCopyFromImage(VkCommandBuffer cmdBuffer, VkImage srcImage, VkImageLayout srcLayout) {
-    auto* dispatch = VRManager::instance().VK->GetDeviceDispatch();
+void BaseVulkanTexture::vkCopyFromImage(VulkanUtils::BarrierBatch& barriers, VkImage srcImage, VkImageLayout srcLayout) {
     VkImageAspectFlags aspectMask = GetAspectMask();
 
     // AMD GPU FIX: If srcLayout is already TRANSFER_SRC_OPTIMAL, the caller has managed the transition
@@ -126,31 +106,9 @@ void BaseVulkanTexture::vkCopyFromImage(VkCommandBuffer cmdBuffer, VkImage srcIm
     bool callerManagedLayout = (srcLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
 
     if (!callerManagedLayout) {
-        // Pre-copy barrier: transition source to TRANSFER_SRC_OPTIMAL
-        VkImageMemoryBarrier2 srcPreBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
-        srcPreBarrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-        srcPreBarrier.srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT;
-        srcPreBarrier.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-        srcPreBarrier.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
-        srcPreBarrier.oldLayout = srcLayout;
-        srcPreBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        srcPreBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        srcPreBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        srcPreBarrier.image = srcImage;
-        // AMD GPU FIX: Use VK_REMAINING to cover all subresources
-        srcPreBarrier.subresourceRange = {
-            .aspectMask = aspectMask,
-            .baseMipLevel = 0,
-            .levelCount = VK_REMAINING_MIP_LEVELS,
-            .baseArrayLayer = 0,
-            .layerCount = VK_REMAINING_ARRAY_LAYERS
-        };
-
-        VkDependencyInfo preBarrierDep = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
-        preBarrierDep.imageMemoryBarrierCount = 1;
-        preBarrierDep.pImageMemoryBarriers = &srcPreBarrier;
-        dispatch->CmdPipelineBarrier2(cmdBuffer, &preBarrierDep);
+        barriers.Transition(srcImage, srcLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, aspectMask);
     }
+    vkTransitionLayout(barriers, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 
     const VkImageCopy region = {
         .srcSubresource = { aspectMask, 0, 0, 1 },
@@ -164,37 +122,15 @@ void BaseVulkanTexture::vkCopyFromImage(VkCommandBuffer cmdBuffer, VkImage srcIm
         }
     };
 
-    dispatch->CmdCopyImage(cmdBuffer, srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    barriers.Flush();
+    barriers.GetDispatch()->CmdCopyImage(barriers.GetCommandBuffer(), srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
     if (!callerManagedLayout) {
-        // Post-copy barrier: transition source back to original layout
-        VkImageMemoryBarrier2 srcPostBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
-        srcPostBarrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-        srcPostBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
-        srcPostBarrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-        srcPostBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT;
-        srcPostBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        srcPostBarrier.newLayout = srcLayout;
-        srcPostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        srcPostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        srcPostBarrier.image = srcImage;
-        // AMD GPU FIX: Use VK_REMAINING to cover all subresources
-        srcPostBarrier.subresourceRange = {
-            .aspectMask = aspectMask,
-            .baseMipLevel = 0,
-            .levelCount = VK_REMAINING_MIP_LEVELS,
-            .baseArrayLayer = 0,
-            .layerCount = VK_REMAINING_ARRAY_LAYERS
-        };
-
-        VkDependencyInfo postBarrierDep = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
-        postBarrierDep.imageMemoryBarrierCount = 1;
-        postBarrierDep.pImageMemoryBarriers = &srcPostBarrier;
-        dispatch->CmdPipelineBarrier2(cmdBuffer, &postBarrierDep);
+        barriers.Transition(srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcLayout, aspectMask);
     }
 }
 
-VulkanTexture::VulkanTexture(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, bool disableAlphaThroughSwizzling): BaseVulkanTexture(width, height, format) {
+VulkanTexture::VulkanTexture(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, bool createOpaqueView): BaseVulkanTexture(width, height, format) {
     const auto* dispatch = VRManager::instance().VK->GetDeviceDispatch();
 
     VkImageCreateInfo imageCreateInfo = { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
@@ -217,17 +153,8 @@ VulkanTexture::VulkanTexture(uint32_t width, uint32_t height, VkFormat format, V
     imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
     checkVkResult(dispatch->CreateImage(VRManager::instance().VK->GetDevice(), &imageCreateInfo, nullptr, &m_vkImage), "Failed to create image!");
 
-    VkMemoryRequirements memRequirements;
-    dispatch->GetImageMemoryRequirements(VRManager::instance().VK->GetDevice(), m_vkImage, &memRequirements);
-
-    uint32_t memoryTypeIndex = VRManager::instance().VK->FindMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-    VkMemoryAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = memoryTypeIndex;
-    checkVkResult(dispatch->AllocateMemory(VRManager::instance().VK->GetDevice(), &allocInfo, nullptr, &m_vkMemory), "Failed to allocate memory!");
-
-    checkVkResult(dispatch->BindImageMemory(VRManager::instance().VK->GetDevice(), m_vkImage, m_vkMemory, 0), "Failed to bind memory to image!");
+    // suballocated from the layer's memory blocks, so m_vkMemory stays null and is never freed by BaseVulkanTexture
+    m_allocation = VRManager::instance().VK->AllocateImageMemory(m_vkImage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
     VkImageViewCreateInfo imageViewCreateInfo = { VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
     imageViewCreateInfo.image = m_vkImage;
@@ -237,7 +164,7 @@ VulkanTexture::VulkanTexture(uint32_t width, uint32_t height, VkFormat format, V
         .r = VK_COMPONENT_SWIZZLE_IDENTITY,
         .g = VK_COMPONENT_SWIZZLE_IDENTITY,
         .b = VK_COMPONENT_SWIZZLE_IDENTITY,
-        .a = disableAlphaThroughSwizzling ? VK_COMPONENT_SWIZZLE_ONE : VK_COMPONENT_SWIZZLE_IDENTITY
+        .a = VK_COMPONENT_SWIZZLE_IDENTITY
     };
     imageViewCreateInfo.subresourceRange = {
         .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
@@ -247,16 +174,30 @@ VulkanTexture::VulkanTexture(uint32_t width, uint32_t height, VkFormat format, V
         .layerCount = 1
     };
     checkVkResult(dispatch->CreateImageView(VRManager::instance().VK->GetDevice(), &imageViewCreateInfo, nullptr, &m_vkImageView), "Failed to create image view!");
+
+    if (createOpaqueView) {
+        imageViewCreateInfo.components.a = VK_COMPONENT_SWIZZLE_ONE;
+        checkVkResult(dispatch->CreateImageView(VRManager::instance().VK->GetDevice(), &imageViewCreateInfo, nullptr, &m_vkOpaqueImageView), "Failed to create opaque image view!");
+    }
 }
 
 VulkanTexture::~VulkanTexture() {
-    // AMD GPU FIX: Only destroy the image view here.
-    // DO NOT destroy m_vkImage/m_vkMemory - BaseVulkanTexture::~BaseVulkanTexture() handles them.
-    // Double-destroy was causing undefined behavior and AMD-specific crashes.
+    // AMD GPU FIX: Only destroy the image views and the image here, and null the image afterwards.
+    // BaseVulkanTexture::~BaseVulkanTexture() skips null handles, double-destroy was causing undefined behavior and AMD-specific crashes.
+    // The image has to be gone before its memory range is handed back to the memory blocks.
     if (m_vkImageView != VK_NULL_HANDLE) {
         VRManager::instance().VK->GetDeviceDispatch()->DestroyImageView(VRManager::instance().VK->GetDevice(), m_vkImageView, nullptr);
         m_vkImageView = VK_NULL_HANDLE;
     }
+    if (m_vkOpaqueImageView != VK_NULL_HANDLE) {
+        VRManager::instance().VK->GetDeviceDispatch()->DestroyImageView(VRManager::instance().VK->GetDevice(), m_vkOpaqueImageView, nullptr);
+        m_vkOpaqueImageView = VK_NULL_HANDLE;
+    }
+    if (m_vkImage != VK_NULL_HANDLE) {
+        VRManager::instance().VK->GetDeviceDispatch()->DestroyImage(VRManager::instance().VK->GetDevice(), m_vkImage, nullptr);
+        m_vkImage = VK_NULL_HANDLE;
+    }
+    VRManager::instance().VK->FreeImageMemory(m_allocation);
 }
 
 VulkanFramebuffer::VulkanFramebuffer(uint32_t width, uint32_t height, VkFormat format, VkRenderPass renderPass): VulkanTexture(width, height, format, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT) {
@@ -465,11 +406,10 @@ SharedTexture::~SharedTexture() {
         VRManager::instance().VK->GetDeviceDispatch()->DestroySemaphore(VRManager::instance().VK->GetDevice(), m_vkSemaphore, nullptr);
 }
 
-void SharedTexture::CopyFromVkImage(VkCommandBuffer cmdBuffer, VkImage srcImage, VkImageLayout srcImageLayout) {
+void SharedTexture::CopyFromVkImage(VulkanUtils::BarrierBatch& barriers, VkImage srcImage, VkImageLayout srcImageLayout) {
     static uint32_t s_copyCount = 0;
     s_copyCount++;
 
-    auto* dispatch = VRManager::instance().VK->GetDeviceDispatch();
     // AMD GPU FIX: Use GetAspectMask() from Vulkan format, NOT D3D12 format detection.
     // D3D12 depth resources are created as typeless (e.g., DXGI_FORMAT_R32_TYPELESS),
     // which would incorrectly return false for IsDepthFormat().
@@ -497,126 +437,30 @@ void SharedTexture::CopyFromVkImage(VkCommandBuffer cmdBuffer, VkImage srcImage,
             desc.Width, desc.Height, (int)srcImageLayout, (int)m_vkCurrLayout, callerManagedLayout);
     }
 
-    // Pre-copy barrier: destination always needs transition, source only if not caller-managed
-    VkImageMemoryBarrier2 dstBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
-    dstBarrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-    dstBarrier.srcAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
-    dstBarrier.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-    dstBarrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-    dstBarrier.oldLayout = m_vkCurrLayout;
-    dstBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    dstBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    dstBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    dstBarrier.image = this->m_vkImage;
-    // AMD GPU FIX: Use VK_REMAINING to cover all subresources
-    dstBarrier.subresourceRange = {
-        .aspectMask = aspectMask,
-        .baseMipLevel = 0,
-        .levelCount = VK_REMAINING_MIP_LEVELS,
-        .baseArrayLayer = 0,
-        .layerCount = VK_REMAINING_ARRAY_LAYERS
-    };
-
-    if (callerManagedLayout) {
-        // Only transition destination
-        VkDependencyInfo preCopyDep = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
-        preCopyDep.imageMemoryBarrierCount = 1;
-        preCopyDep.pImageMemoryBarriers = &dstBarrier;
-        dispatch->CmdPipelineBarrier2(cmdBuffer, &preCopyDep);
-    } else {
-        // Transition both source and destination
-        VkImageMemoryBarrier2 srcBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
-        srcBarrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-        srcBarrier.srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT;
-        srcBarrier.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-        srcBarrier.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
-        srcBarrier.oldLayout = srcImageLayout;
-        srcBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        srcBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        srcBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        srcBarrier.image = srcImage;
-        // AMD GPU FIX: Use VK_REMAINING to cover all subresources
-        srcBarrier.subresourceRange = {
-            .aspectMask = aspectMask,
-            .baseMipLevel = 0,
-            .levelCount = VK_REMAINING_MIP_LEVELS,
-            .baseArrayLayer = 0,
-            .layerCount = VK_REMAINING_ARRAY_LAYERS
-        };
-
-        VkImageMemoryBarrier2 barriers[2] = { srcBarrier, dstBarrier };
-        VkDependencyInfo preCopyDep = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
-        preCopyDep.imageMemoryBarrierCount = 2;
-        preCopyDep.pImageMemoryBarriers = barriers;
-        dispatch->CmdPipelineBarrier2(cmdBuffer, &preCopyDep);
+    // Pre-copy transitions: destination always needs one, source only if not caller-managed.
+    // Any transitions the caller queued before this (e.g. its own source transition) get flushed in the same barrier.
+    if (!callerManagedLayout) {
+        barriers.Transition(srcImage, srcImageLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, aspectMask);
     }
-
-    m_vkCurrLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    vkTransitionLayout(barriers, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 
     VkImageCopy copyRegion = {
         .srcSubresource = { aspectMask, 0, 0, 1 },
         .srcOffset = { 0, 0, 0 },
         .dstSubresource = { aspectMask, 0, 0, 1 },
         .dstOffset = { 0, 0, 0 },
-        .extent = { (uint32_t)this->m_d3d12Texture->GetDesc().Width, (uint32_t)this->m_d3d12Texture->GetDesc().Height, 1 }
+        .extent = { m_width, m_height, 1 }
     };
 
     // Copy using the correct layouts
-    dispatch->CmdCopyImage(cmdBuffer, srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, this->m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
-
-    // Post-copy barrier: destination always transitions to GENERAL, source only if not caller-managed
-    VkImageMemoryBarrier2 dstPostBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
-    dstPostBarrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-    dstPostBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
-    dstPostBarrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-    dstPostBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
-    dstPostBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    dstPostBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
-    dstPostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    dstPostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    dstPostBarrier.image = this->m_vkImage;
-    // AMD GPU FIX: Use VK_REMAINING to cover all subresources
-    dstPostBarrier.subresourceRange = {
-        .aspectMask = aspectMask,
-        .baseMipLevel = 0,
-        .levelCount = VK_REMAINING_MIP_LEVELS,
-        .baseArrayLayer = 0,
-        .layerCount = VK_REMAINING_ARRAY_LAYERS
-    };
+    barriers.Flush();
+    barriers.GetDispatch()->CmdCopyImage(barriers.GetCommandBuffer(), srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, this->m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
 
-    if (callerManagedLayout) {
-        // Only transition destination - source stays in TRANSFER_SRC_OPTIMAL for caller to restore
-        VkDependencyInfo postCopyDep = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
-        postCopyDep.imageMemoryBarrierCount = 1;
-        postCopyDep.pImageMemoryBarriers = &dstPostBarrier;
-        dispatch->CmdPipelineBarrier2(cmdBuffer, &postCopyDep);
-    } else {
-        // Transition both source and destination
-        VkImageMemoryBarrier2 srcPostBarrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
-        srcPostBarrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
-        srcPostBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
-        srcPostBarrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-        srcPostBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT;
-        srcPostBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-        srcPostBarrier.newLayout = srcImageLayout;  // Restore to ORIGINAL layout for Cemu
-        srcPostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        srcPostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        srcPostBarrier.image = srcImage;
-        // AMD GPU FIX: Use VK_REMAINING to cover all subresources
-        srcPostBarrier.subresourceRange = {
-            .aspectMask = aspectMask,
-            .baseMipLevel = 0,
-            .levelCount = VK_REMAINING_MIP_LEVELS,
-            .baseArrayLayer = 0,
-            .layerCount = VK_REMAINING_ARRAY_LAYERS
-        };
-
-        VkImageMemoryBarrier2 postBarriers[2] = { srcPostBarrier, dstPostBarrier };
-        VkDependencyInfo postCopyDep = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
-        postCopyDep.imageMemoryBarrierCount = 2;
-        postCopyDep.pImageMemoryBarriers = postBarriers;
-        dispatch->CmdPipelineBarrier2(cmdBuffer, &postCopyDep);
+    // Post-copy transitions: destination always goes to GENERAL for D3D12, source back to its ORIGINAL layout for Cemu if not caller-managed.
+    // These stay queued so that they can be merged with whatever the caller records next.
+    // The D3D12 side only reads the texture after the submit signals its semaphore, which covers all prior commands.
+    vkTransitionLayout(barriers, VK_IMAGE_LAYOUT_GENERAL);
+    if (!callerManagedLayout) {
+        barriers.Transition(srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcImageLayout, aspectMask);
     }
-
-    m_vkCurrLayout = VK_IMAGE_LAYOUT_GENERAL;
-}
\ No newline at end of file
+}
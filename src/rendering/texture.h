@@ -1,4 +1,5 @@
 #pragma once
+#include "utils/vulkan_utils.h"
 
 class SharedTexture;
 
@@ -9,15 +10,15 @@ public:
     BaseVulkanTexture(uint32_t width, uint32_t height, VkFormat vkFormat): m_width(width), m_height(height), m_vkFormat(vkFormat) {}
     virtual ~BaseVulkanTexture();
 
-    void vkPipelineBarrier(VkCommandBuffer cmdBuffer);
-    void vkTransitionLayout(VkCommandBuffer cmdBuffer, VkImageLayout newLayout);
+    // Transitions are queued in the barrier batch, the clear and copy functions flush it right before recording their command
+    void vkTransitionLayout(VulkanUtils::BarrierBatch& barriers, VkImageLayout newLayout);
 
-    void vkClear(VkCommandBuffer cmdBuffer, VkClearColorValue color);
-    void vkClearDepth(VkCommandBuffer cmdBuffer, float depth, uint32_t stencil = 0);
-    void vkCopyToImage(VkCommandBuffer cmdBuffer, VkImage dstImage);
+    void vkClear(VulkanUtils::BarrierBatch& barriers, VkClearColorValue color);
+    void vkClearDepth(VulkanUtils::BarrierBatch& barriers, float depth, uint32_t stencil = 0);
+    void vkCopyToImage(VulkanUtils::BarrierBatch& barriers, VkImage dstImage);
     // AMD GPU FIX: srcLayout parameter to specify the actual source image layout
     // If srcLayout is TRANSFER_SRC_OPTIMAL, assume caller has already transitioned and skip internal transitions
-    void vkCopyFromImage(VkCommandBuffer cmdBuffer, VkImage srcImage, VkImageLayout srcLayout = VK_IMAGE_LAYOUT_GENERAL);
+    void vkCopyFromImage(VulkanUtils::BarrierBatch& barriers, VkImage srcImage, VkImageLayout srcLayout = VK_IMAGE_LAYOUT_GENERAL);
     uint32_t GetWidth() const { return m_width; }
     uint32_t GetHeight() const { return m_height; }
     VkFormat GetFormat() const { return m_vkFormat; }
@@ -35,15 +36,19 @@ protected:
 class VulkanTexture : public BaseVulkanTexture {
     friend class VulkanFramebuffer;
 public:
-    VulkanTexture(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, bool disableAlphaThroughSwizzling);
+    // createOpaqueView: also create a second view of the same image that swizzles alpha to one, so an alpha-less variant can be sampled without a second copy
+    VulkanTexture(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage, bool createOpaqueView);
     VulkanTexture(uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags usage): VulkanTexture(width, height, format, usage, false) {
     }
     ~VulkanTexture() override;
 
     VkImageView GetImageView() const { return m_vkImageView; }
+    VkImageView GetOpaqueImageView() const { return m_vkOpaqueImageView; }
 
 private:
     VkImageView m_vkImageView = VK_NULL_HANDLE;
+    VkImageView m_vkOpaqueImageView = VK_NULL_HANDLE;
+    VulkanUtils::MemoryAllocation m_allocation;
 };
 
 class VulkanFramebuffer : public VulkanTexture {
@@ -115,7 +120,8 @@ public:
     ~SharedTexture() override;
 
     // srcImageLayout: the ACTUAL current layout of srcImage (e.g., from Cemu's CmdClearColorImage hook)
-    void CopyFromVkImage(VkCommandBuffer cmdBuffer, VkImage srcImage, VkImageLayout srcImageLayout = VK_IMAGE_LAYOUT_GENERAL);
+    // The transitions back to GENERAL (and srcImageLayout when not caller-managed) are left queued in the barrier batch
+    void CopyFromVkImage(VulkanUtils::BarrierBatch& barriers, VkImage srcImage, VkImageLayout srcImageLayout = VK_IMAGE_LAYOUT_GENERAL);
     const VkSemaphore& GetSemaphore() const { return m_vkSemaphore; }
 
     // AMD GPU FIX: Timeline semaphores require strictly increasing values.
@@ -27,12 +27,128 @@ RND_Vulkan::RND_Vulkan(VkInstance vkInstance, VkPhysicalDevice vkPhysDevice, VkD
     if (localVramBytes > 0) {
         Log::print<INFO>("GPU VRAM (device local): {:.2f} GiB", double(localVramBytes) / (1024.0 * 1024.0 * 1024.0));
     }
+
+    // Cemu records everything on its graphics queue, so that's the queue family the timestamps need to be supported on
+    uint32_t queueFamilyCount = 0;
+    m_instanceDispatch->GetPhysicalDeviceQueueFamilyProperties(vkPhysDevice, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    m_instanceDispatch->GetPhysicalDeviceQueueFamilyProperties(vkPhysDevice, &queueFamilyCount, queueFamilies.data());
+    auto graphicsFamily = std::ranges::find_if(queueFamilies, [](const VkQueueFamilyProperties& family) { return (family.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0; });
+    if (graphicsFamily != queueFamilies.end() && graphicsFamily->timestampValidBits != 0 && props.limits.timestampPeriod > 0.0f) {
+        VkQueryPoolCreateInfo queryPoolInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+        queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = TIMESTAMPS_PER_FRAME * 2;
+        checkVkResult(m_deviceDispatch->CreateQueryPool(m_device, &queryPoolInfo, nullptr, &m_timestampPool), "Failed to create timestamp query pool!");
+
+        m_timestampPeriodNs = props.limits.timestampPeriod;
+        m_timestampMask = graphicsFamily->timestampValidBits >= 64 ? ~0ull : (1ull << graphicsFamily->timestampValidBits) - 1;
+    }
+    else {
+        Log::print<WARNING>("GPU doesn't support timestamps on the graphics queue, the dynamic resolution won't see the game's GPU time");
+    }
 }
 
 RND_Vulkan::~RND_Vulkan() {
+    if (m_timestampPool != VK_NULL_HANDLE) {
+        m_deviceDispatch->DestroyQueryPool(m_device, m_timestampPool, nullptr);
+        m_timestampPool = VK_NULL_HANDLE;
+    }
+
+    std::scoped_lock lock(m_memoryBlocksMutex);
+    for (MemoryBlock& block : m_memoryBlocks) {
+        if (block.ranges.GetAllocationCount() != 0) {
+            Log::print<WARNING>("Freeing memory block of type {} which still has {} allocations", block.memoryTypeIndex, block.ranges.GetAllocationCount());
+        }
+        m_deviceDispatch->FreeMemory(m_device, block.memory, nullptr);
+    }
+    m_memoryBlocks.clear();
+}
+
+void RND_Vulkan::WriteCopyTimestamp(VkCommandBuffer commandBuffer, OpenXR::EyeSide side, long frameIdx, bool copyEnd) {
+    if (m_timestampPool == VK_NULL_HANDLE) {
+        return;
+    }
+
+    const uint32_t firstQuery = (uint32_t)frameIdx * TIMESTAMPS_PER_FRAME + (uint32_t)side * 2;
+    if (!copyEnd) {
+        // queries start out in an undefined state, so the first recording resets all of them, including the ones of an eye that never gets copied
+        if (m_timestampPoolNeedsReset.exchange(false, std::memory_order_relaxed)) {
+            m_deviceDispatch->CmdResetQueryPool(commandBuffer, m_timestampPool, 0, TIMESTAMPS_PER_FRAME * 2);
+        }
+        else {
+            m_deviceDispatch->CmdResetQueryPool(commandBuffer, m_timestampPool, firstQuery, 2);
+        }
+    }
+    // bottom of pipe for both, so the start timestamp is when the eye's rendering finished and the end timestamp when the copy did
+    m_deviceDispatch->CmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampPool, firstQuery + (copyEnd ? 1 : 0));
+
+    if (copyEnd) {
+        m_recordedTimestamps[frameIdx].fetch_or(uint8_t(1 << side), std::memory_order_release);
+    }
+}
+
+std::optional<RND_Vulkan::CopyTimings> RND_Vulkan::ReadCopyTimings(long frameIdx) {
+    const uint8_t recordedSides = m_recordedTimestamps[frameIdx].exchange(0, std::memory_order_acquire);
+    if (m_timestampPool == VK_NULL_HANDLE || recordedSides == 0) {
+        return std::nullopt;
+    }
+
+    // the pool only gets reset by the first recording, so wait until that has certainly been submitted before reading it
+    if (m_recordedTimestampCycles[frameIdx].fetch_add(1, std::memory_order_relaxed) == 0) {
+        return std::nullopt;
+    }
+
+    struct TimestampResult {
+        uint64_t value;
+        uint64_t available;
+    };
+    struct EyeTimestamps {
+        TimestampResult start;
+        TimestampResult end;
+    };
+
+    // only read the eyes that got copied this frame, in single-pass stereo the right eye's queries are never written
+    std::array<std::optional<EyeTimestamps>, 2> eyes;
+    for (OpenXR::EyeSide side : { OpenXR::EyeSide::LEFT, OpenXR::EyeSide::RIGHT }) {
+        if ((recordedSides & (1 << side)) == 0) {
+            continue;
+        }
+        EyeTimestamps& timestamps = eyes[side].emplace();
+        const uint32_t firstQuery = (uint32_t)frameIdx * TIMESTAMPS_PER_FRAME + (uint32_t)side * 2;
+        VkResult result = m_deviceDispatch->GetQueryPoolResults(m_device, m_timestampPool, firstQuery, 2, sizeof(timestamps), &timestamps, sizeof(TimestampResult), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if ((result != VK_SUCCESS && result != VK_NOT_READY) || !timestamps.start.available || !timestamps.end.available) {
+            return std::nullopt;
+        }
+    }
+
+    auto toMs = [this](uint64_t start, uint64_t end) {
+        return double((end - start) & m_timestampMask) * m_timestampPeriodNs / 1000000.0;
+    };
+
+    CopyTimings timings;
+    for (const std::optional<EyeTimestamps>& eye : eyes) {
+        if (eye.has_value()) {
+            timings.copyMs += toMs(eye->start.value, eye->end.value);
+        }
+    }
+
+    if (eyes[OpenXR::EyeSide::LEFT].has_value() && eyes[OpenXR::EyeSide::RIGHT].has_value()) {
+        const bool leftFirst = eyes[OpenXR::EyeSide::LEFT]->start.value <= eyes[OpenXR::EyeSide::RIGHT]->start.value;
+        const EyeTimestamps& earlier = leftFirst ? eyes[OpenXR::EyeSide::LEFT].value() : eyes[OpenXR::EyeSide::RIGHT].value();
+        const EyeTimestamps& later = leftFirst ? eyes[OpenXR::EyeSide::RIGHT].value() : eyes[OpenXR::EyeSide::LEFT].value();
+        timings.eyePassMs = toMs(earlier.end.value, later.start.value);
+    }
+    return timings;
 }
 
 uint32_t RND_Vulkan::FindMemoryType(uint32_t memoryTypeBitsRequirement, VkMemoryPropertyFlags requirementsMask) {
+    std::scoped_lock lock(m_memoryTypeCacheMutex);
+    for (const MemoryTypeCacheEntry& entry : m_memoryTypeCache) {
+        if (entry.memoryTypeBits == memoryTypeBitsRequirement && entry.properties == requirementsMask) {
+            return entry.memoryTypeIndex;
+        }
+    }
+
     // AMD GPU FIX: Use actual memoryTypeCount instead of VK_MAX_MEMORY_TYPES to avoid reading uninitialized data
     const uint32_t memoryTypeCount = m_memoryProperties.memoryProperties.memoryTypeCount;
     for (uint32_t i = 0; i < memoryTypeCount; i++) {
@@ -41,6 +157,7 @@ uint32_t RND_Vulkan::FindMemoryType(uint32_t memoryTypeBitsRequirement, VkMemory
         const bool satisfiesFlags = (m_memoryProperties.memoryProperties.memoryTypes[i].propertyFlags & requirementsMask) == requirementsMask;
 
         if (isRequiredMemoryType && satisfiesFlags) {
+            m_memoryTypeCache.push_back({ memoryTypeBitsRequirement, requirementsMask, i });
             return i;
         }
     }
@@ -48,6 +165,99 @@ uint32_t RND_Vulkan::FindMemoryType(uint32_t memoryTypeBitsRequirement, VkMemory
     return 0;
 }
 
+VulkanUtils::MemoryAllocation RND_Vulkan::AllocateImageMemory(VkImage image, VkMemoryPropertyFlags properties) {
+    VkMemoryDedicatedRequirements dedicatedRequirements = { VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS };
+    VkMemoryRequirements2 requirements = { VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2 };
+    requirements.pNext = &dedicatedRequirements;
+    VkImageMemoryRequirementsInfo2 requirementsInfo = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2 };
+    requirementsInfo.image = image;
+    m_deviceDispatch->GetImageMemoryRequirements2(m_device, &requirementsInfo, &requirements);
+
+    const VkMemoryRequirements& memRequirements = requirements.memoryRequirements;
+    const uint32_t memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
+
+    VulkanUtils::MemoryAllocation allocation = {};
+
+    // images that are larger than a block or that the driver insists on keeping separate get their own allocation
+    if (dedicatedRequirements.requiresDedicatedAllocation || memRequirements.size > MEMORY_BLOCK_SIZE) {
+        VkMemoryDedicatedAllocateInfo dedicatedAllocateInfo = { VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO };
+        dedicatedAllocateInfo.image = image;
+
+        VkMemoryAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        allocInfo.pNext = &dedicatedAllocateInfo;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = memoryTypeIndex;
+        checkVkResult(m_deviceDispatch->AllocateMemory(m_device, &allocInfo, nullptr, &allocation.memory), "Failed to allocate dedicated memory!");
+
+        allocation.size = memRequirements.size;
+        allocation.dedicated = true;
+        checkVkResult(m_deviceDispatch->BindImageMemory(m_device, image, allocation.memory, 0), "Failed to bind memory to image!");
+
+        std::scoped_lock lock(m_memoryBlocksMutex);
+        m_dedicatedAllocationCount++;
+        return allocation;
+    }
+
+    std::scoped_lock lock(m_memoryBlocksMutex);
+
+    // first-fit over the free ranges of every block with a matching memory type
+    auto tryAllocateFromBlock = [&](MemoryBlock& block) {
+        const std::optional<VkDeviceSize> offset = block.ranges.Allocate(memRequirements.size, memRequirements.alignment);
+        if (!offset.has_value()) {
+            return false;
+        }
+        allocation.memory = block.memory;
+        allocation.offset = offset.value();
+        allocation.size = memRequirements.size;
+        return true;
+    };
+
+    bool allocated = false;
+    for (MemoryBlock& block : m_memoryBlocks) {
+        if (block.memoryTypeIndex == memoryTypeIndex && tryAllocateFromBlock(block)) {
+            allocated = true;
+            break;
+        }
+    }
+
+    if (!allocated) {
+        MemoryBlock& block = m_memoryBlocks.emplace_back();
+        block.memoryTypeIndex = memoryTypeIndex;
+
+        VkMemoryAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        allocInfo.allocationSize = MEMORY_BLOCK_SIZE;
+        allocInfo.memoryTypeIndex = memoryTypeIndex;
+        checkVkResult(m_deviceDispatch->AllocateMemory(m_device, &allocInfo, nullptr, &block.memory), "Failed to allocate memory block!");
+        Log::print<INFO>("Allocated {} MiB memory block for memory type {} ({} blocks, {} dedicated allocations in total)", MEMORY_BLOCK_SIZE / (1024 * 1024), memoryTypeIndex, m_memoryBlocks.size(), m_dedicatedAllocationCount);
+
+        allocated = tryAllocateFromBlock(block);
+        checkAssert(allocated, "Failed to suballocate from a new memory block!");
+    }
+
+    checkVkResult(m_deviceDispatch->BindImageMemory(m_device, image, allocation.memory, allocation.offset), "Failed to bind memory to image!");
+    return allocation;
+}
+
+void RND_Vulkan::FreeImageMemory(VulkanUtils::MemoryAllocation& allocation) {
+    if (allocation.memory == VK_NULL_HANDLE) {
+        return;
+    }
+
+    std::scoped_lock lock(m_memoryBlocksMutex);
+    if (allocation.dedicated) {
+        m_deviceDispatch->FreeMemory(m_device, allocation.memory, nullptr);
+        m_dedicatedAllocationCount--;
+        allocation = {};
+        return;
+    }
+
+    auto blockIt = std::ranges::find(m_memoryBlocks, allocation.memory, &MemoryBlock::memory);
+    checkAssert(blockIt != m_memoryBlocks.end(), "Couldn't find the memory block of the allocation!");
+
+    blockIt->ranges.Free(allocation.offset, allocation.size);
+    allocation = {};
+}
+
 
 VkResult VRLayer::VkDeviceOverrides::CreateSwapchainKHR(const vkroots::VkDeviceDispatch* pDispatch, VkDevice device, const VkSwapchainCreateInfoKHR* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkSwapchainKHR* pSwapchain) {
     return pDispatch->CreateSwapchainKHR(device, pCreateInfo, pAllocator, pSwapchain);
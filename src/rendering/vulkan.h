@@ -1,5 +1,6 @@
 #pragma once
 #include "openxr.h"
+#include "range_allocator.h"
 #include "texture.h"
 
 
@@ -9,6 +10,23 @@ public:
     ~RND_Vulkan();
 
     uint32_t FindMemoryType(uint32_t memoryTypeBitsRequirement, VkMemoryPropertyFlags requirementsMask);
+
+    // Layer-internal images are suballocated from a few large blocks instead of each getting their own VkDeviceMemory,
+    // since Cemu already uses a lot of the device's maxMemoryAllocationCount. Shared/imported images still allocate their own memory.
+    VulkanUtils::MemoryAllocation AllocateImageMemory(VkImage image, VkMemoryPropertyFlags properties);
+    void FreeImageMemory(VulkanUtils::MemoryAllocation& allocation);
+
+    // Timestamps written by the layer around its copies out of Cemu's eye images, two per eye for each frame index.
+    // The start timestamp also resets that eye's queries, so it has to be recorded outside of a render pass.
+    struct CopyTimings {
+        double copyMs = 0.0;
+        // the GPU time between both eyes' copies, which is roughly one of the game's eye passes. Not set if only one eye was copied.
+        std::optional<double> eyePassMs;
+    };
+    void WriteCopyTimestamp(VkCommandBuffer commandBuffer, OpenXR::EyeSide side, long frameIdx, bool copyEnd);
+    // doesn't wait for the GPU, returns nothing if the timestamps of the frame index haven't been executed yet
+    std::optional<CopyTimings> ReadCopyTimings(long frameIdx);
+
     VkInstance GetInstance() { return m_instance; }
     VkDevice GetDevice() { return m_device; }
     VkPhysicalDevice GetPhysicalDevice() { return m_physicalDevice; }
@@ -23,6 +41,33 @@ private:
     VkDevice m_device;
     VkPhysicalDeviceMemoryProperties2 m_memoryProperties = {};
 
+    struct MemoryTypeCacheEntry {
+        uint32_t memoryTypeBits;
+        VkMemoryPropertyFlags properties;
+        uint32_t memoryTypeIndex;
+    };
+    std::mutex m_memoryTypeCacheMutex;
+    std::vector<MemoryTypeCacheEntry> m_memoryTypeCache;
+
+    static constexpr VkDeviceSize MEMORY_BLOCK_SIZE = 64ull * 1024 * 1024;
+    struct MemoryBlock {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        uint32_t memoryTypeIndex = 0;
+        RangeAllocator ranges = RangeAllocator(MEMORY_BLOCK_SIZE);
+    };
+    std::mutex m_memoryBlocksMutex;
+    std::vector<MemoryBlock> m_memoryBlocks;
+    uint32_t m_dedicatedAllocationCount = 0;
+
+    static constexpr uint32_t TIMESTAMPS_PER_FRAME = 4;
+    VkQueryPool m_timestampPool = VK_NULL_HANDLE;
+    double m_timestampPeriodNs = 0.0;
+    uint64_t m_timestampMask = 0;
+    std::atomic_bool m_timestampPoolNeedsReset = true;
+    // bits of the eyes whose timestamps got recorded for each frame index, and how often all of them were
+    std::array<std::atomic_uint8_t, 2> m_recordedTimestamps = {};
+    std::array<std::atomic_uint32_t, 2> m_recordedTimestampCycles = {};
+
     // todo: use these with caution
     const vkroots::VkInstanceDispatch* m_instanceDispatch;
     const vkroots::VkPhysicalDeviceDispatch* m_physicalDeviceDispatch;
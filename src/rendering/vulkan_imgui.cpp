@@ -1,6 +1,8 @@
 #include "instance.h"
 #include "vulkan.h"
 #include "hooking/entity_debugger.h"
+#include "utils/telemetry.h"
+#include "utils/vulkan_utils.h"
 
 RND_Renderer::ImGuiOverlay::ImGuiOverlay(VkCommandBuffer cb, uint32_t width, uint32_t height, VkFormat format) {
     ImGui::CreateContext();
@@ -161,23 +163,17 @@ RND_Renderer::ImGuiOverlay::ImGuiOverlay(VkCommandBuffer cb, uint32_t width, uin
     }
     m_cemuRenderWindow = iteratedHwnd;
 
+    VulkanUtils::BarrierBatch barriers(cb, VRManager::instance().VK->GetDeviceDispatch());
     for (int i = 0; i < 2; ++i) {
         auto& frame = renderer->GetFrame(i);
         frame.mainFramebuffer = std::make_unique<VulkanTexture>(width, height, VK_FORMAT_B10G11R11_UFLOAT_PACK32, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, false);
-        frame.hudFramebuffer = std::make_unique<VulkanTexture>(width, height, VK_FORMAT_A2B10G10R10_UNORM_PACK32, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, false);
-        frame.hudWithoutAlphaFramebuffer = std::make_unique<VulkanTexture>(width, height, VK_FORMAT_A2B10G10R10_UNORM_PACK32, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, true);
+        frame.hudFramebuffer = std::make_unique<VulkanTexture>(width, height, VK_FORMAT_A2B10G10R10_UNORM_PACK32, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, true);
 
-        frame.mainFramebuffer->vkPipelineBarrier(cb);
-        frame.mainFramebuffer->vkTransitionLayout(cb, VK_IMAGE_LAYOUT_GENERAL);
-        frame.mainFramebuffer->vkClear(cb, { 0.0f, 0.0f, 0.0f, 0.0f });
+        frame.mainFramebuffer->vkTransitionLayout(barriers, VK_IMAGE_LAYOUT_GENERAL);
+        frame.hudFramebuffer->vkTransitionLayout(barriers, VK_IMAGE_LAYOUT_GENERAL);
 
-        frame.hudFramebuffer->vkPipelineBarrier(cb);
-        frame.hudFramebuffer->vkTransitionLayout(cb, VK_IMAGE_LAYOUT_GENERAL);
-        frame.hudFramebuffer->vkClear(cb, { 0.0f, 0.0f, 0.0f, 0.0f });
-
-        frame.hudWithoutAlphaFramebuffer->vkPipelineBarrier(cb);
-        frame.hudWithoutAlphaFramebuffer->vkTransitionLayout(cb, VK_IMAGE_LAYOUT_GENERAL);
-        frame.hudWithoutAlphaFramebuffer->vkClear(cb, { 0.0f, 0.0f, 0.0f, 0.0f });
+        frame.mainFramebuffer->vkClear(barriers, { 0.0f, 0.0f, 0.0f, 0.0f });
+        frame.hudFramebuffer->vkClear(barriers, { 0.0f, 0.0f, 0.0f, 0.0f });
     }
 
     // create sampler
@@ -210,12 +206,10 @@ RND_Renderer::ImGuiOverlay::~ImGuiOverlay() {
             frame.mainFramebuffer.reset();
         if (frame.hudFramebufferDS != VK_NULL_HANDLE)
             ImGui_ImplVulkan_RemoveTexture(frame.hudFramebufferDS);
-        if (frame.hudFramebuffer != nullptr)
-            frame.hudFramebuffer.reset();
         if (frame.hudWithoutAlphaFramebufferDS != VK_NULL_HANDLE)
             ImGui_ImplVulkan_RemoveTexture(frame.hudWithoutAlphaFramebufferDS);
-        if (frame.hudWithoutAlphaFramebuffer != nullptr)
-            frame.hudWithoutAlphaFramebuffer.reset();
+        if (frame.hudFramebuffer != nullptr)
+            frame.hudFramebuffer.reset();
         if (frame.imguiFramebuffer != nullptr)
             frame.imguiFramebuffer.reset();
     }
@@ -249,11 +243,11 @@ void RND_Renderer::ImGuiOverlay::BeginFrame(long frameIdx, bool renderBackground
         frame.hudFramebufferDS = ImGui_ImplVulkan_AddTexture(m_sampler, frame.hudFramebuffer->GetImageView(), VK_IMAGE_LAYOUT_GENERAL);
     }
     if (frame.hudWithoutAlphaFramebufferDS == VK_NULL_HANDLE) {
-        frame.hudWithoutAlphaFramebufferDS = ImGui_ImplVulkan_AddTexture(m_sampler, frame.hudWithoutAlphaFramebuffer->GetImageView(), VK_IMAGE_LAYOUT_GENERAL);
+        frame.hudWithoutAlphaFramebufferDS = ImGui_ImplVulkan_AddTexture(m_sampler, frame.hudFramebuffer->GetOpaqueImageView(), VK_IMAGE_LAYOUT_GENERAL);
     }
 
     if (renderBackground || CemuHooks::UseBlackBarsDuringEvents()) {
-        const bool shouldCrop3DTo16_9 = CemuHooks::GetSettings().cropFlatTo16x9Setting == 1;
+        const bool shouldCrop3DTo16_9 = CemuHooks::GetSettings().ShouldFlatPreviewBeCroppedTo16x9();
 
         // calculate width minus the retina scaling
         ImVec2 windowSize = ImGui::GetIO().DisplaySize;
@@ -346,42 +340,30 @@ void RND_Renderer::ImGuiOverlay::BeginFrame(long frameIdx, bool renderBackground
     if (VRManager::instance().Hooks->m_entityDebugger) {
         VRManager::instance().Hooks->m_entityDebugger->DrawEntityInspector();
         VRManager::instance().Hooks->DrawDebugOverlays();
+        Telemetry::DrawOverlay();
     }
 }
 
-void RND_Renderer::ImGuiOverlay::Draw3DLayerAsBackground(VkCommandBuffer cb, VkImage srcImage, float aspectRatio, long frameIdx, VkImageLayout srcLayout) {
+void RND_Renderer::ImGuiOverlay::Draw3DLayerAsBackground(VulkanUtils::BarrierBatch& barriers, VkImage srcImage, float aspectRatio, long frameIdx, VkImageLayout srcLayout) {
     // Log::print("Drawing 3D layer as background with aspect ratio {}, and isRendering3D {}", aspectRatio, VRManager::instance().XR->GetRenderer()->IsRendering3D());
     auto* renderer = VRManager::instance().XR->GetRenderer();
     auto& frame = renderer->GetFrame(frameIdx);
 
-    frame.mainFramebuffer->vkPipelineBarrier(cb);
-    frame.mainFramebuffer->vkTransitionLayout(cb, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
     // AMD GPU FIX: Pass the actual source layout for proper transitions
-    frame.mainFramebuffer->vkCopyFromImage(cb, srcImage, srcLayout);
-
-    frame.mainFramebuffer->vkPipelineBarrier(cb);
-    frame.mainFramebuffer->vkTransitionLayout(cb, VK_IMAGE_LAYOUT_GENERAL);
+    frame.mainFramebuffer->vkCopyFromImage(barriers, srcImage, srcLayout);
+    frame.mainFramebuffer->vkTransitionLayout(barriers, VK_IMAGE_LAYOUT_GENERAL);
 
     frame.mainFramebufferAspectRatio = aspectRatio;
 }
 
-void RND_Renderer::ImGuiOverlay::DrawHUDLayerAsBackground(VkCommandBuffer cb, VkImage srcImage, long frameIdx, VkImageLayout srcLayout) {
+void RND_Renderer::ImGuiOverlay::DrawHUDLayerAsBackground(VulkanUtils::BarrierBatch& barriers, VkImage srcImage, long frameIdx, VkImageLayout srcLayout) {
     auto* renderer = VRManager::instance().XR->GetRenderer();
     auto& frame = renderer->GetFrame(frameIdx);
 
-    frame.hudFramebuffer->vkPipelineBarrier(cb);
-    frame.hudFramebuffer->vkTransitionLayout(cb, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    // AMD GPU FIX: Pass the actual source layout for proper transitions
-    frame.hudFramebuffer->vkCopyFromImage(cb, srcImage, srcLayout);
-    frame.hudFramebuffer->vkPipelineBarrier(cb);
-    frame.hudFramebuffer->vkTransitionLayout(cb, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-    frame.hudWithoutAlphaFramebuffer->vkPipelineBarrier(cb);
-    frame.hudWithoutAlphaFramebuffer->vkTransitionLayout(cb, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    // the HUD is only copied once, the variant without alpha is sampled through the opaque view of the same image
     // AMD GPU FIX: Pass the actual source layout for proper transitions
-    frame.hudWithoutAlphaFramebuffer->vkCopyFromImage(cb, srcImage, srcLayout);
-    frame.hudWithoutAlphaFramebuffer->vkPipelineBarrier(cb);
-    frame.hudWithoutAlphaFramebuffer->vkTransitionLayout(cb, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    frame.hudFramebuffer->vkCopyFromImage(barriers, srcImage, srcLayout);
+    frame.hudFramebuffer->vkTransitionLayout(barriers, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 }
 
 void RND_Renderer::ImGuiOverlay::Render() {
@@ -436,15 +418,16 @@ void RND_Renderer::ImGuiOverlay::Update() {
     }
 }
 
-void RND_Renderer::ImGuiOverlay::DrawAndCopyToImage(VkCommandBuffer cb, VkImage destImage, long frameIdx) {
-    auto* dispatch = VRManager::instance().VK->GetDeviceDispatch();
+void RND_Renderer::ImGuiOverlay::DrawAndCopyToImage(VulkanUtils::BarrierBatch& barriers, VkImage destImage, long frameIdx) {
+    auto* dispatch = barriers.GetDispatch();
+    VkCommandBuffer cb = barriers.GetCommandBuffer();
     auto* renderer = VRManager::instance().XR->GetRenderer();
     auto& frame = renderer->GetFrame(frameIdx);
 
-    // transition framebuffer to color attachment
-    frame.imguiFramebuffer->vkTransitionLayout(cb, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-    frame.imguiFramebuffer->vkPipelineBarrier(cb);
-    frame.imguiFramebuffer->vkClear(cb, { 0.0f, 0.0f, 0.0f, 0.0f });
+    // clear the framebuffer, then transition it to the layout the render pass expects
+    frame.imguiFramebuffer->vkClear(barriers, { 0.0f, 0.0f, 0.0f, 0.0f });
+    frame.imguiFramebuffer->vkTransitionLayout(barriers, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    barriers.Flush();
 
     // start render pass
     VkClearValue clearValue = { .color = { 0.0f, 0.0f, 0.0f, 0.0f } };
@@ -467,8 +450,6 @@ void RND_Renderer::ImGuiOverlay::DrawAndCopyToImage(VkCommandBuffer cb, VkImage
     dispatch->CmdEndRenderPass(cb);
 
     // transition framebuffer to now be a transfer source
-    frame.imguiFramebuffer->vkPipelineBarrier(cb);
-    frame.imguiFramebuffer->vkTransitionLayout(cb, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
-    frame.imguiFramebuffer->vkCopyToImage(cb, destImage);
-    frame.imguiFramebuffer->vkPipelineBarrier(cb);
+    frame.imguiFramebuffer->vkTransitionLayout(barriers, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+    frame.imguiFramebuffer->vkCopyToImage(barriers, destImage);
 }
\ No newline at end of file
@@ -7,6 +7,11 @@ struct VSInput {
 struct PSInput {
     float4 position : SV_POSITION;
     float2 uv : TEXCOORD;
+    nointerpolation uint eye : EYE;
+#ifdef STEREO
+    // both eyes are drawn as two instances, each into its own layer of the swapchain images
+    uint layer : SV_RenderTargetArrayIndex;
+#endif
 };
 
 struct PSOutput {
@@ -21,24 +26,124 @@ cbuffer g_settings : register(b1) {
     float swapchainHeight;
 };
 
+// when enabled, the attachments were rendered from another eye and get reprojected into this eye using their depth
+// with stereo the first eye's attachments get reprojected into the second eye
+cbuffer g_reprojection : register(b2) {
+    row_major float3x4 dstToSrc;
+    float4 srcTangents; // left, right, up, down
+    float4 dstTangents;
+    float nearZ;
+    float farZ;
+    uint reprojectionEnabled;
+};
+
 Texture2D g_colorTexture : register(t0);
 Texture2D<float> g_depthTexture : register(t1);
+#ifdef STEREO
+Texture2D g_secondColorTexture : register(t2);
+Texture2D<float> g_secondDepthTexture : register(t3);
+static const uint REPROJECTED_EYE = 1;
+#else
+static const uint REPROJECTED_EYE = 0;
+#endif
 SamplerState g_sampler : register(s0);
 
+static const int REPROJECTION_STEPS = 32;
+static const int REPROJECTION_REFINE_STEPS = 6;
+
+// same depth mapping that gets reported to the runtime through XrCompositionLayerDepthInfoKHR
+float LinearizeDepth(float depth) {
+    return nearZ * farZ / (farZ - depth * (farZ - nearZ));
+}
+
+float DelinearizeDepth(float viewDepth) {
+    return farZ * (viewDepth - nearZ) / (viewDepth * (farZ - nearZ));
+}
+
+float2 ViewToSourceUV(float3 srcPosition) {
+    float2 tangent = srcPosition.xy / -srcPosition.z;
+    return float2((tangent.x - srcTangents.x) / (srcTangents.y - srcTangents.x), (srcTangents.z - tangent.y) / (srcTangents.z - srcTangents.w));
+}
+
+// whether the point along the ray of this eye is behind the surface that the source eye saw
+bool IsBehindSourceSurface(float3 dstRay, float invViewDepth, out float2 srcUV) {
+    float3 srcPosition = mul(dstToSrc, float4(dstRay / invViewDepth, 1.0));
+    srcUV = ViewToSourceUV(srcPosition);
+    float surfaceDepth = LinearizeDepth(g_depthTexture.SampleLevel(g_sampler, srcUV, 0));
+    return -srcPosition.z >= surfaceDepth;
+}
+
+PSOutput Reproject(float2 uv) {
+    float3 dstRay = float3(lerp(dstTangents.x, dstTangents.y, uv.x), lerp(dstTangents.z, dstTangents.w, uv.y), -1.0);
+
+    // march from near to far in steps of inverse depth, since those move the sample point by roughly the same distance in the source eye
+    float nearInvDepth = 1.0 / nearZ;
+    float farInvDepth = 1.0 / farZ;
+    float frontInvDepth = nearInvDepth;
+    float backInvDepth = farInvDepth;
+    float2 srcUV;
+    [loop]
+    for (int i = 1; i <= REPROJECTION_STEPS; i++) {
+        float invDepth = lerp(nearInvDepth, farInvDepth, i / (float)REPROJECTION_STEPS);
+        if (IsBehindSourceSurface(dstRay, invDepth, srcUV)) {
+            backInvDepth = invDepth;
+            break;
+        }
+        frontInvDepth = invDepth;
+    }
+
+    [loop]
+    for (int j = 0; j < REPROJECTION_REFINE_STEPS; j++) {
+        float invDepth = (frontInvDepth + backInvDepth) * 0.5;
+        if (IsBehindSourceSurface(dstRay, invDepth, srcUV)) {
+            backInvDepth = invDepth;
+        }
+        else {
+            frontInvDepth = invDepth;
+        }
+    }
+
+    // rays that never hit anything end up sampling whatever the source eye saw at the far plane
+    IsBehindSourceSurface(dstRay, backInvDepth, srcUV);
+
+    PSOutput output;
+    output.Color = g_colorTexture.SampleLevel(g_sampler, srcUV, 0);
+    output.Depth = saturate(DelinearizeDepth(1.0 / backInvDepth));
+    return output;
+}
+
 PSInput VSMain(VSInput input) {
 	PSInput output;
 	output.uv = float2(input.vertexId%2, input.vertexId%4/2);
 
     //float swapchainAspectRatio = swapchainWidth / swapchainHeight;
 	output.position = float4((output.uv.x-0.5f)*2.0f, -(output.uv.y-0.5f)*2.0f, 0.0, 1.0);
+    output.eye = input.instId;
+#ifdef STEREO
+    output.layer = input.instId;
+#endif
 
 	return output;
 }
 
 PSOutput PSMain(PSInput input) {
+    if (reprojectionEnabled != 0 && input.eye == REPROJECTED_EYE) {
+        return Reproject(input.uv);
+    }
+
 	float4 renderColor = float4(0.0, 1.0, 1.0, 1.0);
 	float2 samplePosition = input.uv;
 
+#ifdef STEREO
+    // the attachments have no mips, so sampling level 0 is the same as Sample() without needing derivatives inside the branch
+    if (input.eye != 0) {
+        PSOutput secondOutput;
+        secondOutput.Color = g_secondColorTexture.SampleLevel(g_sampler, samplePosition, 0);
+        secondOutput.Depth = g_secondDepthTexture.SampleLevel(g_sampler, samplePosition, 0);
+        return secondOutput;
+    }
+#endif
+
     float4 colorTexture = g_colorTexture.Sample(g_sampler, samplePosition);
     float depthTexture = g_depthTexture.Sample(g_sampler, samplePosition);
 
@@ -1,7 +1,7 @@
 #pragma once
 
 namespace D3D12Utils {
-    static ComPtr<ID3DBlob> CompileShader(const char* sourceHLSL, const char* entryPoint, const char* version) {
+    static ComPtr<ID3DBlob> CompileShader(const char* sourceHLSL, const char* entryPoint, const char* version, const D3D_SHADER_MACRO* defines = nullptr) {
         DWORD shaderCompileFlags = D3DCOMPILE_PACK_MATRIX_COLUMN_MAJOR | D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_WARNINGS_ARE_ERRORS;
 #ifdef _DEBUG
         shaderCompileFlags |= D3DCOMPILE_SKIP_OPTIMIZATION;
@@ -11,7 +11,7 @@ namespace D3D12Utils {
 #endif
         ComPtr<ID3DBlob> shaderBytes;
         ID3DBlob* hlslCompilationErrors;
-        if (FAILED(D3DCompile(sourceHLSL, strlen(sourceHLSL), nullptr, nullptr, nullptr, entryPoint, version, shaderCompileFlags, 0, &shaderBytes, &hlslCompilationErrors))) {
+        if (FAILED(D3DCompile(sourceHLSL, strlen(sourceHLSL), nullptr, defines, nullptr, entryPoint, version, shaderCompileFlags, 0, &shaderBytes, &hlslCompilationErrors))) {
             std::string errorMessage((const char*)hlslCompilationErrors->GetBufferPointer(), hlslCompilationErrors->GetBufferSize());
             Log::print<ERROR>("Vertex Shader Compilation Error:");
             Log::print<ERROR>(errorMessage.c_str());
@@ -0,0 +1,206 @@
+#pragma once
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <optional>
+
+// Fixed-capacity concurrent map from Vulkan handles to a small, trivially copyable metadata struct.
+// Lookups never take a lock, so they're safe to use from Cemu's recording and submit threads while other threads create or destroy handles.
+// Each slot has a sequence counter, a lookup that races with its slot being reused for another handle retries instead of returning torn metadata.
+// Inserts and removals only happen when handles are created or destroyed, so they're serialized by a mutex. Removals shift the
+// handles behind the removed one back instead of leaving tombstones, so probe chains stay as short as if those handles were never created.
+template <typename Metadata, size_t Capacity>
+class HandleRegistry {
+    static_assert(std::is_trivially_copyable_v<Metadata>, "Metadata needs to be trivially copyable");
+    static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "Capacity needs to be a power of two");
+
+public:
+    template <typename Handle>
+    bool Insert(Handle handle, const Metadata& metadata) {
+        const uint64_t key = ToKey(handle);
+        std::scoped_lock lock(m_writeMutex);
+
+        // a handle that was destroyed without us seeing it can be handed out again, so overwrite it instead of inserting it twice
+        if (Slot* slot = FindSlot(key)) {
+            Write(*slot, ToWords(metadata));
+            return true;
+        }
+
+        Slot* freeSlot = nullptr;
+        size_t idx = Hash(key);
+        for (size_t probe = 0; probe < Capacity; probe++, idx = (idx + 1) & (Capacity - 1)) {
+            if (m_slots[idx].key.load(std::memory_order_relaxed) == EMPTY) {
+                freeSlot = &m_slots[idx];
+                break;
+            }
+        }
+        if (freeSlot == nullptr) {
+            return false;
+        }
+
+        Write(*freeSlot, ToWords(metadata));
+        freeSlot->key.store(key, std::memory_order_release);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    template <typename Handle>
+    std::optional<Metadata> Find(Handle handle) const {
+        const uint64_t key = ToKey(handle);
+        while (true) {
+            const uint32_t shiftSequence = m_shiftSequence.load(std::memory_order_acquire);
+            if ((shiftSequence & 1) == 0) {
+                if (const Slot* slot = FindSlot(key)) {
+                    if (std::optional<Metadata> metadata = Read(*slot, key)) {
+                        return metadata;
+                    }
+                }
+                // a removal that moved handles while probing can make a handle look absent, only trust the miss if none did
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_shiftSequence.load(std::memory_order_relaxed) == shiftSequence) {
+                    return std::nullopt;
+                }
+            }
+            _mm_pause();
+        }
+    }
+
+    template <typename Handle>
+    bool Contains(Handle handle) const {
+        return Find(handle).has_value();
+    }
+
+    template <typename Handle>
+    bool Remove(Handle handle) {
+        const uint64_t key = ToKey(handle);
+        std::scoped_lock lock(m_writeMutex);
+
+        Slot* slot = FindSlot(key);
+        if (slot == nullptr) {
+            return false;
+        }
+
+        // Backward shift deletion: move each later handle of the cluster into the hole if that doesn't put it in front of
+        // its home slot. The handle is copied before its old slot is cleared, so a lookup can't pass both copies.
+        m_shiftSequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        size_t hole = (size_t)(slot - m_slots.data());
+        slot->key.store(EMPTY, std::memory_order_release);
+        for (size_t idx = (hole + 1) & (Capacity - 1); idx != hole; idx = (idx + 1) & (Capacity - 1)) {
+            const uint64_t current = m_slots[idx].key.load(std::memory_order_relaxed);
+            if (current == EMPTY) {
+                break;
+            }
+            const size_t home = Hash(current);
+            if (((idx - home) & (Capacity - 1)) < ((idx - hole) & (Capacity - 1))) {
+                continue;
+            }
+            Write(m_slots[hole], ReadWords(m_slots[idx]));
+            m_slots[hole].key.store(current, std::memory_order_release);
+            m_slots[idx].key.store(EMPTY, std::memory_order_release);
+            hole = idx;
+        }
+
+        m_shiftSequence.fetch_add(1, std::memory_order_release);
+        m_count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t Size() const { return m_count.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint64_t EMPTY = 0;
+    static constexpr size_t WORD_COUNT = (sizeof(Metadata) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct Slot {
+        std::atomic_uint64_t key = EMPTY;
+        std::atomic_uint32_t sequence = 0;
+        std::array<std::atomic_uint64_t, WORD_COUNT> data = {};
+    };
+    using Words = std::array<uint64_t, WORD_COUNT>;
+
+    template <typename Handle>
+    static uint64_t ToKey(Handle handle) {
+        static_assert(sizeof(Handle) == sizeof(uint64_t), "Only 64-bit handles are supported");
+        return (uint64_t)handle;
+    }
+
+    static size_t Hash(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdull;
+        key ^= key >> 33;
+        return (size_t)key & (Capacity - 1);
+    }
+
+    Slot* FindSlot(uint64_t key) {
+        return const_cast<Slot*>(std::as_const(*this).FindSlot(key));
+    }
+
+    const Slot* FindSlot(uint64_t key) const {
+        size_t idx = Hash(key);
+        for (size_t probe = 0; probe < Capacity; probe++, idx = (idx + 1) & (Capacity - 1)) {
+            const uint64_t current = m_slots[idx].key.load(std::memory_order_acquire);
+            if (current == key) {
+                return &m_slots[idx];
+            }
+            if (current == EMPTY) {
+                return nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    static Words ToWords(const Metadata& metadata) {
+        Words words = {};
+        std::memcpy(words.data(), &metadata, sizeof(Metadata));
+        return words;
+    }
+
+    // returns nothing if the slot was handed to another handle in the meantime
+    static std::optional<Metadata> Read(const Slot& slot, uint64_t key) {
+        Words words;
+        while (true) {
+            const uint32_t sequenceBefore = slot.sequence.load(std::memory_order_acquire);
+            if ((sequenceBefore & 1) != 0) {
+                _mm_pause();
+                continue;
+            }
+            words = ReadWords(slot);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.key.load(std::memory_order_relaxed) != key) {
+                return std::nullopt;
+            }
+            if (slot.sequence.load(std::memory_order_relaxed) == sequenceBefore) {
+                break;
+            }
+        }
+
+        Metadata metadata;
+        std::memcpy(&metadata, words.data(), sizeof(Metadata));
+        return metadata;
+    }
+
+    static Words ReadWords(const Slot& slot) {
+        Words words;
+        for (size_t i = 0; i < WORD_COUNT; i++) {
+            words[i] = slot.data[i].load(std::memory_order_relaxed);
+        }
+        return words;
+    }
+
+    // only called while holding m_writeMutex
+    static void Write(Slot& slot, const Words& words) {
+        slot.sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORD_COUNT; i++) {
+            slot.data[i].store(words[i], std::memory_order_relaxed);
+        }
+        slot.sequence.fetch_add(1, std::memory_order_release);
+    }
+
+    std::array<Slot, Capacity> m_slots = {};
+    std::atomic_size_t m_count = 0;
+    std::atomic_uint32_t m_shiftSequence = 0; // odd while a removal moves handles
+    std::mutex m_writeMutex;
+};
@@ -0,0 +1,161 @@
+#include "catch.h"
+#include "handle_registry.h"
+
+#include <thread>
+
+namespace {
+    // every field is derived from the handle, so a torn read shows up as fields that disagree with each other
+    struct TestMetadata {
+        uint64_t handle;
+        uint64_t inverted;
+        uint32_t generation;
+        uint32_t check;
+
+        static TestMetadata For(uint64_t handle, uint32_t generation) {
+            return { handle, ~handle, generation, (uint32_t)handle ^ generation };
+        }
+
+        bool IsConsistent(uint64_t expectedHandle) const {
+            return handle == expectedHandle && inverted == ~expectedHandle && check == ((uint32_t)handle ^ generation);
+        }
+    };
+}
+
+TEST_CASE("HandleRegistry inserts, finds and removes handles", "[handle_registry]") {
+    HandleRegistry<TestMetadata, 16> registry;
+
+    CHECK_FALSE(registry.Find(0x1000ull).has_value());
+    CHECK(registry.Insert(0x1000ull, TestMetadata::For(0x1000, 1)));
+    CHECK(registry.Insert(0x2000ull, TestMetadata::For(0x2000, 1)));
+    CHECK(registry.Size() == 2);
+    CHECK(registry.Contains(0x1000ull));
+    CHECK(registry.Find(0x2000ull)->IsConsistent(0x2000));
+
+    // inserting a handle again overwrites its metadata
+    CHECK(registry.Insert(0x1000ull, TestMetadata::For(0x1000, 2)));
+    CHECK(registry.Size() == 2);
+    CHECK(registry.Find(0x1000ull)->generation == 2);
+
+    CHECK(registry.Remove(0x1000ull));
+    CHECK_FALSE(registry.Remove(0x1000ull));
+    CHECK_FALSE(registry.Contains(0x1000ull));
+    CHECK(registry.Find(0x2000ull)->IsConsistent(0x2000));
+    CHECK(registry.Size() == 1);
+}
+
+TEST_CASE("HandleRegistry only runs out of slots when that many handles are alive", "[handle_registry]") {
+    HandleRegistry<TestMetadata, 16> registry;
+
+    for (uint64_t handle = 1; handle <= 16; handle++) {
+        REQUIRE(registry.Insert(handle * 0x40, TestMetadata::For(handle * 0x40, 0)));
+    }
+    CHECK_FALSE(registry.Insert(0x10000ull, TestMetadata::For(0x10000, 0)));
+
+    CHECK(registry.Remove(0x40ull));
+    CHECK(registry.Insert(0x10000ull, TestMetadata::For(0x10000, 0)));
+    for (uint64_t handle = 2; handle <= 16; handle++) {
+        CHECK(registry.Find(handle * 0x40)->IsConsistent(handle * 0x40));
+    }
+}
+
+TEST_CASE("HandleRegistry keeps working after many more handles than slots were created", "[handle_registry]") {
+    // mimics images being created and destroyed every frame, with most slots in use at any time
+    HandleRegistry<TestMetadata, 64> registry;
+    std::vector<uint64_t> alive;
+    uint64_t nextHandle = 0x1000;
+
+    for (uint32_t i = 0; i < 100000; i++) {
+        if (alive.size() == 60) {
+            const size_t victim = (i * 7919) % alive.size();
+            REQUIRE(registry.Remove(alive[victim]));
+            alive.erase(alive.begin() + (ptrdiff_t)victim);
+        }
+        REQUIRE(registry.Insert(nextHandle, TestMetadata::For(nextHandle, i)));
+        alive.push_back(nextHandle);
+        nextHandle += 0x40;
+    }
+
+    CHECK(registry.Size() == alive.size());
+    for (uint64_t handle : alive) {
+        CHECK(registry.Find(handle)->IsConsistent(handle));
+    }
+    CHECK_FALSE(registry.Find(nextHandle).has_value());
+
+    // removals don't leave anything behind, so every slot can be used again
+    for (uint64_t handle : alive) {
+        REQUIRE(registry.Remove(handle));
+    }
+    for (uint64_t handle = 1; handle <= 64; handle++) {
+        CHECK(registry.Insert(handle, TestMetadata::For(handle, 0)));
+    }
+}
+
+TEST_CASE("HandleRegistry lookups never return torn metadata during concurrent inserts and removes", "[handle_registry]") {
+    constexpr uint32_t WRITER_COUNT = 4;
+    constexpr uint32_t READER_COUNT = 4;
+    constexpr uint64_t HANDLES_PER_WRITER = 96;
+    constexpr uint32_t ROUNDS = 300;
+
+    static HandleRegistry<TestMetadata, 1024> registry;
+    std::atomic_bool done = false;
+    std::atomic_uint32_t failures = 0;
+
+    // each writer owns its own handles, so it knows exactly which of them have to be found
+    std::vector<std::thread> writers;
+    for (uint32_t writer = 0; writer < WRITER_COUNT; writer++) {
+        writers.emplace_back([&, writer] {
+            const uint64_t firstHandle = (writer + 1) * 0x100000ull;
+            for (uint32_t round = 0; round < ROUNDS; round++) {
+                for (uint64_t i = 0; i < HANDLES_PER_WRITER; i++) {
+                    const uint64_t handle = firstHandle + i * 0x10;
+                    if (!registry.Insert(handle, TestMetadata::For(handle, round))) {
+                        failures++;
+                    }
+                }
+                for (uint64_t i = 0; i < HANDLES_PER_WRITER; i++) {
+                    const uint64_t handle = firstHandle + i * 0x10;
+                    const auto metadata = registry.Find(handle);
+                    if (!metadata || !metadata->IsConsistent(handle) || metadata->generation != round) {
+                        failures++;
+                    }
+                }
+                // remove every other handle in alternating order, so removals happen both in front of and behind live handles
+                for (uint64_t i = round % 2; i < HANDLES_PER_WRITER; i += 2) {
+                    if (!registry.Remove(firstHandle + i * 0x10)) {
+                        failures++;
+                    }
+                }
+                for (uint64_t i = 1 - round % 2; i < HANDLES_PER_WRITER; i += 2) {
+                    if (!registry.Remove(firstHandle + i * 0x10)) {
+                        failures++;
+                    }
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> readers;
+    for (uint32_t reader = 0; reader < READER_COUNT; reader++) {
+        readers.emplace_back([&, reader] {
+            uint64_t i = reader;
+            while (!done.load(std::memory_order_relaxed)) {
+                const uint64_t handle = (i % WRITER_COUNT + 1) * 0x100000ull + (i / WRITER_COUNT % HANDLES_PER_WRITER) * 0x10;
+                if (const auto metadata = registry.Find(handle); metadata && !metadata->IsConsistent(handle)) {
+                    failures++;
+                }
+                i += 7;
+            }
+        });
+    }
+
+    for (std::thread& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    CHECK(failures == 0);
+    CHECK(registry.Size() == 0);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// Bucket math of Telemetry's latency histograms. There are two buckets per power of two, so percentiles are accurate to within 50%.
+// Samples are in whatever ticks the caller measures with, and so are the bounds and percentiles.
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKET_COUNT = 96;
+    using Buckets = std::array<uint64_t, BUCKET_COUNT>;
+
+    // upper bounds of the buckets the percentiles fall into, all zero when there weren't any samples
+    struct Percentiles {
+        uint64_t p50;
+        uint64_t p99;
+        uint64_t max;
+    };
+
+    static size_t GetBucket(uint64_t ticks) {
+        if (ticks < 2) {
+            return (size_t)ticks;
+        }
+        const uint32_t exponent = (uint32_t)std::bit_width(ticks) - 1;
+        const size_t bucket = exponent * 2 + ((ticks >> (exponent - 1)) & 1);
+        return std::min(bucket, BUCKET_COUNT - 1);
+    }
+
+    static uint64_t GetBucketLowerBound(size_t bucket) {
+        if (bucket < 2) {
+            return bucket;
+        }
+        const uint32_t exponent = (uint32_t)(bucket / 2);
+        return (1ull << exponent) + (bucket & 1) * (1ull << (exponent - 1));
+    }
+
+    static Percentiles GetPercentiles(const Buckets& buckets) {
+        uint64_t sampleCount = 0;
+        for (uint64_t bucketSamples : buckets) {
+            sampleCount += bucketSamples;
+        }
+
+        Percentiles percentiles = {};
+        const uint64_t p50Rank = (sampleCount + 1) / 2;
+        const uint64_t p99Rank = sampleCount - sampleCount / 100;
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+            const uint64_t bucketSamples = buckets[bucket];
+            if (bucketSamples == 0) {
+                continue;
+            }
+
+            const uint64_t upperBound = GetBucketLowerBound(bucket + 1);
+            if (seen < p50Rank && seen + bucketSamples >= p50Rank) {
+                percentiles.p50 = upperBound;
+            }
+            if (seen < p99Rank && seen + bucketSamples >= p99Rank) {
+                percentiles.p99 = upperBound;
+            }
+            percentiles.max = upperBound;
+            seen += bucketSamples;
+        }
+        return percentiles;
+    }
+};
@@ -0,0 +1,127 @@
+#pragma once
+#include <thread>
+
+// Hands formatted log messages from any number of threads to a single writer without locking.
+// The ring is made of small slots and a message takes as many consecutive slots as it needs, so short messages, which are
+// almost all of them, don't reserve room for the longest one. If the ring is full, messages are either dropped and counted
+// or the caller waits for the writer to free enough slots.
+template <size_t SlotCount>
+class LogQueue {
+public:
+    static constexpr size_t SLOT_SIZE = 128;
+    static constexpr size_t MAX_MESSAGE_LENGTH = 2040;
+
+private:
+    struct Slot {
+        // even means the slot is free for round turn/2 of the ring, odd means a message of that round starts in it
+        std::atomic_uint64_t turn = 0;
+        // only set in the first slot of a message
+        uint32_t length = 0;
+        char data[SLOT_SIZE - sizeof(std::atomic_uint64_t) - sizeof(uint32_t)];
+    };
+    static_assert(sizeof(Slot) == SLOT_SIZE);
+    static constexpr size_t SLOT_DATA_SIZE = sizeof(Slot::data);
+    static_assert(SlotCount * SLOT_DATA_SIZE >= MAX_MESSAGE_LENGTH, "The longest message has to fit into the queue");
+
+public:
+    LogQueue() = default;
+    LogQueue(const LogQueue&) = delete;
+    LogQueue& operator=(const LogQueue&) = delete;
+
+    // Messages longer than MAX_MESSAGE_LENGTH get truncated. Returns false if the message was dropped because the queue was full,
+    // which never happens with waitForSpace as long as something keeps calling Drain().
+    bool Enqueue(std::string_view message, bool waitForSpace) {
+        message = message.substr(0, MAX_MESSAGE_LENGTH);
+        const uint64_t slotCount = std::max<uint64_t>(1, (message.size() + SLOT_DATA_SIZE - 1) / SLOT_DATA_SIZE);
+
+        uint64_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            // only the slots reserved through m_enqueuePos can be written, so once they're free they stay free until they're used
+            const SlotState state = GetState(pos, slotCount);
+            if (state == SlotState::FREE) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + slotCount, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (state == SlotState::NOT_WRITTEN_YET) {
+                if (!waitForSpace) {
+                    m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                std::this_thread::yield();
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+            else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        // fill the rest of the message first, the writer only looks at the first slot
+        for (uint64_t i = 1; i < slotCount; i++) {
+            const size_t offset = i * SLOT_DATA_SIZE;
+            std::memcpy(m_slots[(pos + i) % SlotCount].data, message.data() + offset, std::min(SLOT_DATA_SIZE, message.size() - offset));
+        }
+        Slot& first = m_slots[pos % SlotCount];
+        first.length = (uint32_t)message.size();
+        std::memcpy(first.data, message.data(), std::min(SLOT_DATA_SIZE, message.size()));
+        first.turn.store(2 * (pos / SlotCount) + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Only one thread is allowed to drain the queue. Appends every message that's ready to batch, each followed by a newline,
+    // and returns the position up to which the queue has been read.
+    uint64_t Drain(std::string& batch) {
+        uint64_t pos = m_readPos;
+        while (true) {
+            Slot& first = m_slots[pos % SlotCount];
+            const uint64_t fullTurn = 2 * (pos / SlotCount) + 1;
+            if (first.turn.load(std::memory_order_acquire) != fullTurn) {
+                break;
+            }
+
+            const size_t length = first.length;
+            const uint64_t slotCount = std::max<uint64_t>(1, (length + SLOT_DATA_SIZE - 1) / SLOT_DATA_SIZE);
+            for (uint64_t i = 0; i < slotCount; i++) {
+                Slot& slot = m_slots[(pos + i) % SlotCount];
+                batch.append(slot.data, std::min(SLOT_DATA_SIZE, length - i * SLOT_DATA_SIZE));
+                slot.turn.store(2 * ((pos + i) / SlotCount + 1), std::memory_order_release);
+            }
+            batch.push_back('\n');
+            pos += slotCount;
+        }
+        m_readPos = pos;
+        return pos;
+    }
+
+    // position after the last message that was enqueued, compare with what Drain() returned to know when it has been read
+    uint64_t GetEnqueuePosition() const { return m_enqueuePos.load(std::memory_order_acquire); }
+
+    // how many messages were dropped since the last call
+    uint32_t TakeDroppedCount() { return m_droppedMessages.exchange(0, std::memory_order_relaxed); }
+
+private:
+    enum class SlotState {
+        FREE,
+        NOT_WRITTEN_YET, // the writer hasn't gotten to a message of the previous round
+        ALREADY_USED, // another thread reserved the slots, pos is outdated
+    };
+
+    SlotState GetState(uint64_t pos, uint64_t slotCount) const {
+        for (uint64_t i = 0; i < slotCount; i++) {
+            const uint64_t freeTurn = 2 * ((pos + i) / SlotCount);
+            const uint64_t turn = m_slots[(pos + i) % SlotCount].turn.load(std::memory_order_acquire);
+            if (turn < freeTurn) {
+                return SlotState::NOT_WRITTEN_YET;
+            }
+            if (turn > freeTurn) {
+                return SlotState::ALREADY_USED;
+            }
+        }
+        return SlotState::FREE;
+    }
+
+    std::array<Slot, SlotCount> m_slots = {};
+    std::atomic_uint64_t m_enqueuePos = 0;
+    std::atomic_uint32_t m_droppedMessages = 0;
+    uint64_t m_readPos = 0;
+};
@@ -0,0 +1,155 @@
+#include "catch.h"
+#include "log_queue.h"
+
+#include <thread>
+
+namespace {
+    std::vector<std::string> SplitLines(const std::string& batch) {
+        std::vector<std::string> lines;
+        size_t start = 0;
+        for (size_t end = batch.find('\n'); end != std::string::npos; end = batch.find('\n', start)) {
+            lines.emplace_back(batch, start, end - start);
+            start = end + 1;
+        }
+        return lines;
+    }
+
+    // "<thread>:<index>:" followed by a payload whose length depends on both, so messages take different numbers of slots
+    std::string MakeMessage(uint32_t thread, uint32_t index) {
+        std::string message = std::to_string(thread) + ":" + std::to_string(index) + ":";
+        message.append((index * 37 + thread * 11) % 400, (char)('a' + index % 26));
+        return message;
+    }
+}
+
+TEST_CASE("LogQueue hands over messages of any length in order", "[log_queue]") {
+    LogQueue<32> queue;
+    const std::string longMessage(500, 'x');
+    const std::string tooLongMessage(LogQueue<32>::MAX_MESSAGE_LENGTH + 100, 'y');
+
+    CHECK(queue.Enqueue("first", false));
+    CHECK(queue.Enqueue("", false));
+    CHECK(queue.Enqueue(longMessage, false));
+    std::string batch;
+    CHECK(queue.Drain(batch) == queue.GetEnqueuePosition());
+    CHECK(SplitLines(batch) == std::vector<std::string>{ "first", "", longMessage });
+
+    // the longest message takes most of the ring and wraps around its end
+    CHECK(queue.Enqueue(tooLongMessage, false));
+    batch.clear();
+    queue.Drain(batch);
+    CHECK(batch == tooLongMessage.substr(0, LogQueue<32>::MAX_MESSAGE_LENGTH) + "\n");
+
+    batch.clear();
+    queue.Drain(batch);
+    CHECK(batch.empty());
+    CHECK(queue.TakeDroppedCount() == 0);
+}
+
+TEST_CASE("LogQueue drops messages that don't fit while the writer is behind", "[log_queue]") {
+    LogQueue<32> queue;
+
+    // a short message takes a single slot
+    uint32_t accepted = 0;
+    while (queue.Enqueue("message " + std::to_string(accepted), false)) {
+        accepted++;
+    }
+    CHECK(accepted == 32);
+    CHECK_FALSE(queue.Enqueue("another", false));
+    CHECK(queue.TakeDroppedCount() == 2);
+    CHECK(queue.TakeDroppedCount() == 0);
+
+    // what made it in is intact, and the freed slots can be used again
+    std::string batch;
+    queue.Drain(batch);
+    const std::vector<std::string> lines = SplitLines(batch);
+    REQUIRE(lines.size() == 32);
+    CHECK(lines.front() == "message 0");
+    CHECK(lines.back() == "message 31");
+    CHECK(queue.Enqueue("after draining", false));
+}
+
+TEST_CASE("LogQueue never drops messages that wait for space", "[log_queue]") {
+    // like errors, which wait for the writer instead of being dropped
+    LogQueue<32> queue;
+    while (queue.Enqueue("filler", false)) {
+    }
+    queue.TakeDroppedCount();
+
+    constexpr uint32_t ERROR_COUNT = 200;
+    std::jthread producer([&] {
+        for (uint32_t i = 0; i < ERROR_COUNT; i++) {
+            queue.Enqueue(MakeMessage(0, i), true);
+        }
+    });
+
+    std::vector<std::string> errors;
+    while (errors.size() < ERROR_COUNT) {
+        std::string batch;
+        queue.Drain(batch);
+        for (std::string& line : SplitLines(batch)) {
+            if (line != "filler") {
+                errors.push_back(std::move(line));
+            }
+        }
+        std::this_thread::yield();
+    }
+    producer.join();
+
+    for (uint32_t i = 0; i < ERROR_COUNT; i++) {
+        REQUIRE(errors[i] == MakeMessage(0, i));
+    }
+    CHECK(queue.TakeDroppedCount() == 0);
+}
+
+TEST_CASE("LogQueue keeps every thread's messages intact and in order", "[log_queue]") {
+    constexpr uint32_t THREAD_COUNT = 4;
+    constexpr uint32_t MESSAGES_PER_THREAD = 2000;
+
+    LogQueue<64> queue;
+    std::atomic_uint32_t dropped = 0;
+    std::atomic_uint32_t finishedProducers = 0;
+    std::vector<std::jthread> producers;
+    for (uint32_t thread = 0; thread < THREAD_COUNT; thread++) {
+        producers.emplace_back([&, thread] {
+            for (uint32_t i = 0; i < MESSAGES_PER_THREAD; i++) {
+                // some of them wait for space, the others get dropped and counted if there isn't any
+                if (!queue.Enqueue(MakeMessage(thread, i), i % 4 == 0)) {
+                    dropped++;
+                }
+            }
+            finishedProducers++;
+        });
+    }
+
+    std::vector<std::string> lines;
+    auto drain = [&] {
+        std::string batch;
+        queue.Drain(batch);
+        for (std::string& line : SplitLines(batch)) {
+            lines.push_back(std::move(line));
+        }
+    };
+    while (finishedProducers < THREAD_COUNT) {
+        drain();
+        std::this_thread::yield();
+    }
+    drain();
+
+    // every message is one that was logged, and each thread's messages come in the order they were logged
+    std::array<int64_t, THREAD_COUNT> lastIndex;
+    lastIndex.fill(-1);
+    for (const std::string& line : lines) {
+        const size_t firstColon = line.find(':');
+        const size_t secondColon = line.find(':', firstColon + 1);
+        REQUIRE(secondColon != std::string::npos);
+        const uint32_t thread = (uint32_t)std::stoul(line.substr(0, firstColon));
+        const uint32_t index = (uint32_t)std::stoul(line.substr(firstColon + 1, secondColon - firstColon - 1));
+        REQUIRE(thread < THREAD_COUNT);
+        REQUIRE(line == MakeMessage(thread, index));
+        REQUIRE((int64_t)index > lastIndex[thread]);
+        lastIndex[thread] = index;
+    }
+    CHECK(lines.size() + dropped == THREAD_COUNT * MESSAGES_PER_THREAD);
+    CHECK(queue.TakeDroppedCount() == dropped);
+}
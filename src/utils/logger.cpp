@@ -5,6 +5,10 @@ double Log::timeFrequency = 0.0f;
 std::ofstream Log::logFile;
 std::mutex Log::logMutex;
 
+Log::Queue Log::queue;
+std::atomic_uint64_t Log::writtenPos = 0;
+std::jthread Log::writer;
+
 static void LogSystemHardwareInfo() {
     int cpuInfo[4] = {0, 0, 0, 0};
     __cpuid(cpuInfo, 0x80000000);
@@ -39,6 +43,7 @@ Log::Log() {
 #ifndef _DEBUG
     logFile.open("BetterVR.txt", std::ios::out | std::ios::trunc);
 #endif
+    writer = std::jthread(&Log::writerThread);
     Log::print<INFO>("Successfully started BetterVR!");
     LogSystemHardwareInfo();
 
@@ -49,6 +54,8 @@ Log::Log() {
 
 Log::~Log() {
     Log::print<INFO>("Shutting down BetterVR debugging console...");
+    writer.request_stop();
+    writer.join();
     FreeConsole();
 #ifndef _DEBUG
     if (logFile.is_open()) {
@@ -61,4 +68,73 @@ void Log::printTimeElapsed(const char* message_prefix, LARGE_INTEGER time) {
     LARGE_INTEGER timeNow;
     QueryPerformanceCounter(&timeNow);
     Log::print<INFO>("{}: {} ms", message_prefix, double(time.QuadPart - timeNow.QuadPart) / timeFrequency);
-}
\ No newline at end of file
+}
+
+void Log::enqueue(std::string_view message, bool isError) {
+    // nothing would ever free a slot if the writer isn't running
+    queue.Enqueue(message, isError && writer.joinable());
+
+    // errors are usually followed by a message box and an exception, so make sure they end up in the log first
+    if (isError) {
+        flush();
+    }
+}
+
+void Log::flush() {
+    if (!writer.joinable()) {
+        return;
+    }
+
+    const uint64_t target = queue.GetEnqueuePosition();
+    while (writtenPos.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+}
+
+bool Log::writeQueuedMessages() {
+    std::string batch;
+    const uint64_t pos = queue.Drain(batch);
+
+    if (uint32_t dropped = queue.TakeDroppedCount(); dropped > 0) {
+        std::format_to(std::back_inserter(batch), "Dropped {} log messages since the log couldn't keep up\n", dropped);
+    }
+
+    if (batch.empty()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+#ifndef _DEBUG
+        if (logFile.is_open()) {
+            logFile << batch;
+            logFile.flush();
+        }
+#endif
+
+        DWORD charsWritten = 0;
+        WriteConsoleA(consoleHandle, batch.c_str(), (DWORD)batch.size(), &charsWritten, NULL);
+#ifdef _DEBUG
+        OutputDebugStringA(batch.c_str());
+#else
+        std::cout << batch << std::flush;
+#endif
+    }
+
+    writtenPos.store(pos, std::memory_order_release);
+    return true;
+}
+
+void Log::writerThread(std::stop_token stopToken) {
+    SetThreadDescription(GetCurrentThread(), L"BetterVR Logger");
+
+    while (!stopToken.stop_requested()) {
+        if (!writeQueuedMessages()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // write whatever got logged while shutting down
+    while (writeQueuedMessages()) {
+    }
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include "vkroots.h"
+#include "log_queue.h"
 #include <fstream>
+#include <thread>
 
 template <>
 struct std::formatter<VkResult> : std::formatter<string> {
@@ -256,26 +258,7 @@ public:
         if constexpr (!isLogTypeEnabled<L>()) {
             return;
         }
-        std::lock_guard<std::mutex> lock(logMutex);
-        std::string messageStr = std::string(message) + "\n";
-
-#ifndef _DEBUG
-        if (logFile.is_open()) {
-            logFile << messageStr;
-            logFile.flush();
-        }
-#endif
-
-        DWORD charsWritten = 0;
-        WriteConsoleA(consoleHandle, messageStr.c_str(), (DWORD)messageStr.size(), &charsWritten, NULL);
-#ifdef _DEBUG
-        //std::string messageStr = std::string(message) + "\n";
-        //DWORD charsWritten = 0;
-        //WriteConsoleA(consoleHandle, messageStr.c_str(), (DWORD)messageStr.size(), &charsWritten, NULL);
-        OutputDebugStringA(messageStr.c_str());
-#else
-        std::cout << message << std::endl;
-#endif
+        enqueue(std::string_view(message, strnlen(message, MAX_MESSAGE_LENGTH)), L == ERROR);
     }
 
     template <typename LogType L, class... Args>
@@ -283,16 +266,61 @@ public:
         if constexpr (!isLogTypeEnabled<L>()) {
             return;
         }
-        Log::print<L>(std::vformat(format, std::make_format_args(args...)).c_str());
+
+        // format into a stack buffer, so logging from hooks doesn't allocate
+        std::array<char, MAX_MESSAGE_LENGTH> buffer;
+        BoundedOutput out = std::vformat_to(BoundedOutput{ buffer.data(), buffer.data() + buffer.size() }, format, std::make_format_args(args...));
+        if (out.truncated) {
+            std::memcpy(out.pos - 3, "...", 3);
+        }
+        enqueue(std::string_view(buffer.data(), out.pos), L == ERROR);
     }
 
+    // blocks until every message that was logged before this call has been written
+    static void flush();
+
     static void printTimeElapsed(const char* message_prefix, LARGE_INTEGER time);
 
 private:
+    // Messages are formatted by the thread that logs them and then handed to a writer thread through a LogQueue,
+    // so that hooks never wait on the console or log file. If the writer can't keep up, new messages are dropped and counted instead.
+    // Errors are the exception, they wait for free slots since they're usually the last thing logged before a crash.
+    using Queue = LogQueue<1024>;
+    static constexpr size_t MAX_MESSAGE_LENGTH = Queue::MAX_MESSAGE_LENGTH;
+
+    struct BoundedOutput {
+        using difference_type = std::ptrdiff_t;
+
+        char* pos;
+        char* end;
+        bool truncated = false;
+
+        BoundedOutput& operator*() { return *this; }
+        BoundedOutput& operator++() { return *this; }
+        BoundedOutput& operator++(int) { return *this; }
+        BoundedOutput& operator=(char c) {
+            if (pos != end) {
+                *pos++ = c;
+            }
+            else {
+                truncated = true;
+            }
+            return *this;
+        }
+    };
+
+    static void enqueue(std::string_view message, bool isError);
+    static void writerThread(std::stop_token stopToken);
+    static bool writeQueuedMessages();
+
     static HANDLE consoleHandle;
     static double timeFrequency;
     static std::ofstream logFile;
     static std::mutex logMutex;
+
+    static Queue queue;
+    static std::atomic_uint64_t writtenPos;
+    static std::jthread writer;
 };
 
 static void checkXRResult(const XrResult result, const char* errorMessage) {
@@ -0,0 +1,58 @@
+#pragma once
+
+// Publishes a value from a single writer thread to any number of reader threads without locking.
+// std::atomic<T> falls back to a hidden lock for structs this large, which the hooks would hit several times per frame.
+// The writer never waits, readers retry their copy if the writer published a new value while they were copying it.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock can only hold trivially copyable types");
+
+public:
+    SeqLock() { Store(T{}); }
+    explicit SeqLock(const T& value) { Store(value); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // only one thread is allowed to store values
+    void Store(const T& value) {
+        std::array<uint64_t, WORD_COUNT> words = {};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        m_sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORD_COUNT; i++) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+        m_sequence.fetch_add(1, std::memory_order_release);
+    }
+
+    T Load() const {
+        std::array<uint64_t, WORD_COUNT> words;
+        while (true) {
+            const uint32_t sequenceBefore = m_sequence.load(std::memory_order_acquire);
+            if ((sequenceBefore & 1) != 0) {
+                _mm_pause();
+                continue;
+            }
+            for (size_t i = 0; i < WORD_COUNT; i++) {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == sequenceBefore) {
+                break;
+            }
+        }
+
+        T value;
+        // trivially copyable types like std::optional can still have a non-trivial default constructor, which GCC warns about
+        std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic_uint32_t m_sequence = 0;
+    std::array<std::atomic_uint64_t, WORD_COUNT> m_words = {};
+};
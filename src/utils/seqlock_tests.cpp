@@ -0,0 +1,73 @@
+#include "catch.h"
+#include "seqlock.h"
+
+#include <thread>
+
+namespace {
+    // larger than what std::atomic can hold without a lock, and every field depends on the first one so torn copies stand out
+    struct TestPose {
+        uint64_t frame;
+        float position[3];
+        float orientation[4];
+        uint64_t check;
+
+        static TestPose For(uint64_t frame) {
+            const float value = (float)(frame % 1024);
+            return { frame, { value, value + 1.0f, value + 2.0f }, { value, -value, value, -value }, ~frame };
+        }
+
+        bool IsConsistent() const {
+            const TestPose expected = For(frame);
+            return check == expected.check && std::memcmp(position, expected.position, sizeof(position)) == 0 && std::memcmp(orientation, expected.orientation, sizeof(orientation)) == 0;
+        }
+    };
+    static_assert(sizeof(TestPose) > 16);
+}
+
+TEST_CASE("SeqLock returns the last stored value", "[seqlock]") {
+    SeqLock<TestPose> lock;
+    CHECK(lock.Load().frame == 0);
+    CHECK(lock.Load().check == 0);
+
+    lock.Store(TestPose::For(7));
+    CHECK(lock.Load().frame == 7);
+    CHECK(lock.Load().IsConsistent());
+
+    SeqLock<uint32_t> small(42);
+    CHECK(small.Load() == 42);
+}
+
+TEST_CASE("SeqLock readers never see a torn value while the writer stores", "[seqlock]") {
+    constexpr uint32_t READER_COUNT = 4;
+    constexpr uint64_t FRAME_COUNT = 200000;
+
+    SeqLock<TestPose> lock(TestPose::For(0));
+    std::atomic_bool done = false;
+    std::atomic_uint32_t failures = 0;
+
+    std::vector<std::thread> readers;
+    for (uint32_t reader = 0; reader < READER_COUNT; reader++) {
+        readers.emplace_back([&] {
+            uint64_t lastFrame = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                const TestPose pose = lock.Load();
+                // a single writer stores increasing frames, so a reader can't go back in time either
+                if (!pose.IsConsistent() || pose.frame < lastFrame) {
+                    failures++;
+                }
+                lastFrame = pose.frame;
+            }
+        });
+    }
+
+    for (uint64_t frame = 1; frame <= FRAME_COUNT; frame++) {
+        lock.Store(TestPose::For(frame));
+    }
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    CHECK(failures == 0);
+    CHECK(lock.Load().frame == FRAME_COUNT);
+}
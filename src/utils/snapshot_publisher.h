@@ -0,0 +1,44 @@
+#pragma once
+
+// Publishes a value that rarely changes from a single writer thread to any number of reader threads.
+// Each published value is copied into one of SlotCount snapshots and readers only need a single atomic load to get it.
+// Snapshots are recycled, so a reference is only valid until SlotCount - 1 further values got published. Readers
+// should use it for the call they got it in and not keep it around.
+//
+// Values are compared bitwise, so a NaN read from guest memory compares equal to itself instead of publishing
+// a new snapshot every time. T therefore can't have padding, otherwise equal values could compare unequal.
+template <typename T, size_t SlotCount = 16>
+class SnapshotPublisher {
+    static_assert(std::is_trivially_copyable_v<T>, "Snapshots are compared with memcmp");
+    static_assert(SlotCount >= 2, "The current snapshot can't be overwritten while publishing the next one");
+
+public:
+    SnapshotPublisher() = default;
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+
+    // only one thread is allowed to publish, returns whether the value differed from the current snapshot
+    bool Publish(const T& value) {
+        const T* current = m_current.load(std::memory_order_relaxed);
+        if (std::memcmp(current, &value, sizeof(T)) == 0) {
+            return false;
+        }
+        m_generation++;
+        T& snapshot = m_slots[m_generation % SlotCount];
+        snapshot = value;
+        m_current.store(&snapshot, std::memory_order_release);
+        return true;
+    }
+
+    const T& Get() const {
+        return *m_current.load(std::memory_order_acquire);
+    }
+
+    // how many values differed from the one before them, only safe to call from the publishing thread
+    uint64_t Generation() const { return m_generation; }
+
+private:
+    std::array<T, SlotCount> m_slots = {};
+    uint64_t m_generation = 0;
+    std::atomic<const T*> m_current = &m_slots[0];
+};
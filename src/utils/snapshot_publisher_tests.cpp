@@ -0,0 +1,127 @@
+#include "catch.h"
+#include "snapshot_publisher.h"
+
+#include <thread>
+
+namespace {
+    // a few of VRSettings' fields, with one that depends on the others so torn reads stand out
+    struct TestSettings {
+        int32_t cameraMode = 0;
+        float playerHeight = 0.0f;
+        float renderScale = 1.0f;
+        int32_t check = 0;
+
+        static TestSettings For(int32_t version) {
+            return { version % 2, 1.5f + (float)version, 1.0f + (float)version / 8.0f, version * 3 };
+        }
+
+        bool operator==(const TestSettings&) const = default;
+    };
+}
+
+TEST_CASE("SnapshotPublisher starts with a default constructed value", "[snapshot_publisher]") {
+    SnapshotPublisher<TestSettings> settings;
+    CHECK(settings.Get() == TestSettings{});
+    CHECK(settings.Generation() == 0);
+    CHECK_FALSE(settings.Publish(TestSettings{}));
+}
+
+TEST_CASE("SnapshotPublisher only publishes values that changed", "[snapshot_publisher]") {
+    SnapshotPublisher<TestSettings> settings;
+
+    CHECK(settings.Publish(TestSettings::For(1)));
+    CHECK(settings.Get() == TestSettings::For(1));
+
+    // publishing the same value every frame doesn't touch the snapshot
+    const TestSettings* published = &settings.Get();
+    for (int i = 0; i < 100; i++) {
+        CHECK_FALSE(settings.Publish(TestSettings::For(1)));
+    }
+    CHECK(&settings.Get() == published);
+    CHECK(settings.Generation() == 1);
+
+    SECTION("NaNs compare equal to themselves") {
+        TestSettings nan = TestSettings::For(2);
+        nan.renderScale = std::numeric_limits<float>::quiet_NaN();
+        CHECK(settings.Publish(nan));
+        for (int i = 0; i < 100; i++) {
+            CHECK_FALSE(settings.Publish(nan));
+        }
+        CHECK(settings.Generation() == 2);
+    }
+
+    SECTION("-0 and 0 are different values") {
+        TestSettings negativeZero = TestSettings::For(1);
+        negativeZero.playerHeight = -0.0f;
+        TestSettings positiveZero = TestSettings::For(1);
+        positiveZero.playerHeight = 0.0f;
+        CHECK(settings.Publish(negativeZero));
+        CHECK(settings.Publish(positiveZero));
+        CHECK(settings.Generation() == 3);
+    }
+}
+
+TEST_CASE("SnapshotPublisher recycles its snapshots", "[snapshot_publisher]") {
+    SnapshotPublisher<TestSettings, 4> settings;
+
+    // switching back and forth between presets doesn't need more memory
+    for (int32_t version = 1; version <= 1000; version++) {
+        REQUIRE(settings.Publish(TestSettings::For(version % 2 + 1)));
+        CHECK(settings.Get() == TestSettings::For(version % 2 + 1));
+    }
+    CHECK(settings.Generation() == 1000);
+    static_assert(sizeof(settings) <= sizeof(TestSettings) * 4 + 2 * sizeof(uint64_t));
+
+    // a reference stays valid while fewer values than there are other slots get published
+    const TestSettings& held = settings.Get();
+    const TestSettings heldValue = held;
+    for (int32_t version = 10; version < 13; version++) {
+        settings.Publish(TestSettings::For(version));
+    }
+    CHECK(held == heldValue);
+    CHECK(settings.Get() == TestSettings::For(12));
+}
+
+TEST_CASE("SnapshotPublisher readers see complete values while the writer publishes", "[snapshot_publisher]") {
+    constexpr uint32_t READER_COUNT = 2;
+    constexpr int32_t VERSION_COUNT = 200;
+
+    SnapshotPublisher<TestSettings, 4> settings;
+    std::atomic_bool done = false;
+    std::atomic_uint32_t failures = 0;
+    std::array<std::atomic_uint64_t, READER_COUNT> reads = {};
+
+    std::vector<std::thread> readers;
+    for (uint32_t reader = 0; reader < READER_COUNT; reader++) {
+        readers.emplace_back([&, reader] {
+            while (!done.load(std::memory_order_relaxed)) {
+                const TestSettings& current = settings.Get();
+                if (current != TestSettings{} && current != TestSettings::For(current.check / 3)) {
+                    failures++;
+                }
+                reads[reader].fetch_add(1, std::memory_order_release);
+            }
+        });
+    }
+
+    // like the hooks, readers don't hold on to a snapshot for longer than a frame, with a new value published at most every frame
+    for (int32_t version = 1; version <= VERSION_COUNT; version++) {
+        std::array<uint64_t, READER_COUNT> readsBefore;
+        for (uint32_t reader = 0; reader < READER_COUNT; reader++) {
+            readsBefore[reader] = reads[reader].load(std::memory_order_acquire);
+        }
+        settings.Publish(TestSettings::For(version));
+        for (uint32_t reader = 0; reader < READER_COUNT; reader++) {
+            while (reads[reader].load(std::memory_order_acquire) < readsBefore[reader] + 2) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    CHECK(failures == 0);
+    CHECK(settings.Get() == TestSettings::For(VERSION_COUNT));
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+// FNV-1a, used to look up the game's strings (job names, event names etc.) without turning them into std::strings first.
+// It's constexpr so that tables of known names can be hashed at compile time.
+constexpr uint32_t HashString(std::string_view str) {
+    uint32_t hash = 0x811C9DC5;
+    for (char c : str) {
+        hash ^= (uint8_t)c;
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+// Returns a view of a NUL-terminated string in guest memory, reading at most maxLength bytes
+inline std::string_view GuestStringView(const char* str, size_t maxLength = 0x100) {
+    return std::string_view(str, strnlen(str, maxLength));
+}
@@ -0,0 +1,170 @@
+#include "telemetry.h"
+
+std::mutex Telemetry::s_registerMutex;
+std::array<Telemetry::CounterInfo, Telemetry::MAX_COUNTERS> Telemetry::s_counterInfos = {};
+std::atomic_uint32_t Telemetry::s_counterCount = 0;
+
+std::array<std::atomic<Telemetry::ThreadCounters*>, Telemetry::MAX_THREADS> Telemetry::s_threads = {};
+std::atomic_uint32_t Telemetry::s_threadCount = 0;
+
+std::array<Telemetry::Totals, Telemetry::MAX_COUNTERS> Telemetry::s_windowStart = {};
+uint32_t Telemetry::s_framesInWindow = 0;
+uint64_t Telemetry::s_lastFrameEnd = 0;
+uint64_t Telemetry::s_calibrationTicks = 0;
+double Telemetry::s_calibrationReferenceMs = 0.0;
+double Telemetry::s_ticksPerMs = 0.0;
+
+std::mutex Telemetry::s_statsMutex;
+std::vector<Telemetry::CounterStats> Telemetry::s_stats;
+
+static const Telemetry::CounterId s_frameCounter = Telemetry::Register("Frame", Telemetry::Category::FRAME);
+
+Telemetry::CounterId Telemetry::Register(const char* name, Category category) {
+    std::scoped_lock lock(s_registerMutex);
+    const uint32_t count = s_counterCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; i++) {
+        if (std::string_view(s_counterInfos[i].name) == name) {
+            return i;
+        }
+    }
+
+    if (count >= MAX_COUNTERS) {
+        throw std::runtime_error("Too many telemetry counters were registered!");
+    }
+    s_counterInfos[count] = { name, category };
+    s_counterCount.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+Telemetry::ThreadCounters* Telemetry::GetThreadCounters() {
+    // blocks are never freed so that the samples of threads that exited still count towards the totals
+    thread_local ThreadCounters* s_counters = [] () -> ThreadCounters* {
+        const uint32_t idx = s_threadCount.fetch_add(1, std::memory_order_relaxed);
+        if (idx >= MAX_THREADS) {
+            return nullptr;
+        }
+        ThreadCounters* counters = new ThreadCounters();
+        s_threads[idx].store(counters, std::memory_order_release);
+        return counters;
+    }();
+    return s_counters;
+}
+
+void Telemetry::Record(CounterId id, uint64_t ticks) {
+    ThreadCounters* threadCounters = GetThreadCounters();
+    if (threadCounters == nullptr) {
+        return;
+    }
+
+    // this thread is the only writer, so a load and a store is enough instead of a locked add
+    auto increment = [](std::atomic_uint64_t& value, uint64_t amount) {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    };
+
+    ThreadCounters::Counter& counter = threadCounters->counters[id];
+    increment(counter.calls, 1);
+    increment(counter.ticks, ticks);
+    increment(counter.buckets[LatencyHistogram::GetBucket(ticks)], 1);
+}
+
+Telemetry::Totals Telemetry::SumThreadCounters(CounterId id, bool includeBuckets) {
+    Totals totals;
+    const uint32_t threadCount = std::min<uint32_t>(s_threadCount.load(std::memory_order_relaxed), MAX_THREADS);
+    for (uint32_t i = 0; i < threadCount; i++) {
+        const ThreadCounters* threadCounters = s_threads[i].load(std::memory_order_acquire);
+        if (threadCounters == nullptr) {
+            continue;
+        }
+
+        const ThreadCounters::Counter& counter = threadCounters->counters[id];
+        totals.calls += counter.calls.load(std::memory_order_relaxed);
+        totals.ticks += counter.ticks.load(std::memory_order_relaxed);
+        if (includeBuckets) {
+            for (size_t j = 0; j < BUCKET_COUNT; j++) {
+                totals.buckets[j] += counter.buckets[j].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    return totals;
+}
+
+void Telemetry::EndFrame() {
+    const uint64_t now = Now();
+    if (s_lastFrameEnd != 0) {
+        Record(s_frameCounter, now - s_lastFrameEnd);
+    }
+    s_lastFrameEnd = now;
+
+    // measure the rate of the ticks against the reference clock over the whole session
+    const double referenceMs = s_clock.referenceMs();
+    if (s_calibrationTicks == 0) {
+        s_calibrationTicks = now;
+        s_calibrationReferenceMs = referenceMs;
+        return;
+    }
+
+    s_framesInWindow++;
+    if (s_framesInWindow < WINDOW_FRAMES) {
+        return;
+    }
+
+    s_ticksPerMs = double(now - s_calibrationTicks) / (referenceMs - s_calibrationReferenceMs);
+
+    const uint32_t counterCount = s_counterCount.load(std::memory_order_acquire);
+    std::vector<CounterStats> stats;
+    stats.reserve(counterCount);
+    for (CounterId id = 0; id < counterCount; id++) {
+        const Totals totals = SumThreadCounters(id, true);
+        const Totals& windowStart = s_windowStart[id];
+
+        CounterStats& counterStats = stats.emplace_back();
+        counterStats.name = s_counterInfos[id].name;
+        counterStats.category = s_counterInfos[id].category;
+        counterStats.totalCalls = totals.calls;
+        counterStats.totalMs = double(totals.ticks) / s_ticksPerMs;
+
+        const uint64_t windowCalls = totals.calls - windowStart.calls;
+        counterStats.callsPerFrame = double(windowCalls) / double(s_framesInWindow);
+        counterStats.msPerFrame = double(totals.ticks - windowStart.ticks) / s_ticksPerMs / double(s_framesInWindow);
+
+        // the percentiles of this window are reported as the upper bound of the bucket they fall into
+        LatencyHistogram::Buckets windowBuckets;
+        for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+            windowBuckets[bucket] = totals.buckets[bucket] - windowStart.buckets[bucket];
+        }
+        const LatencyHistogram::Percentiles percentiles = LatencyHistogram::GetPercentiles(windowBuckets);
+        auto toUs = [](uint64_t ticks) { return double(ticks) / s_ticksPerMs * 1000.0; };
+        counterStats.p50Us = toUs(percentiles.p50);
+        counterStats.p99Us = toUs(percentiles.p99);
+        counterStats.maxUs = toUs(percentiles.max);
+
+        s_windowStart[id] = totals;
+    }
+    s_framesInWindow = 0;
+
+    std::scoped_lock lock(s_statsMutex);
+    s_stats = std::move(stats);
+}
+
+std::vector<Telemetry::CounterStats> Telemetry::GetStats() {
+    std::scoped_lock lock(s_statsMutex);
+    return s_stats;
+}
+
+uint32_t Telemetry::GetIgnoredThreadCount() {
+    const uint32_t threadCount = s_threadCount.load(std::memory_order_relaxed);
+    return threadCount > MAX_THREADS ? threadCount - (uint32_t)MAX_THREADS : 0;
+}
+
+void Telemetry::SetClock(const Clock& clock) {
+    s_clock = clock;
+    s_lastFrameEnd = 0;
+    s_calibrationTicks = 0;
+    s_framesInWindow = 0;
+
+    // samples that were taken with the old clock don't count towards the new window
+    const uint32_t counterCount = s_counterCount.load(std::memory_order_acquire);
+    for (CounterId id = 0; id < counterCount; id++) {
+        s_windowStart[id] = SumThreadCounters(id, true);
+    }
+}
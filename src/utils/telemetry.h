@@ -0,0 +1,129 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <mutex>
+
+#include "latency_histogram.h"
+
+// Call counts and latencies of the HLE hooks, Vulkan overrides and frame phases.
+// Each thread records into its own block of counters, so timing a hook is two TSC reads and a few uncontended stores.
+// EndFrame() sums up the blocks of all threads once per frame, and turns them into statistics every WINDOW_FRAMES frames.
+// The collector itself only needs the standard library, the CSV export and the overlay are in telemetry_overlay.cpp.
+class Telemetry {
+public:
+    static constexpr uint32_t WINDOW_FRAMES = 60;
+
+    enum class Category : uint8_t {
+        HLE_HOOK,
+        VULKAN,
+        FRAME,
+    };
+
+    using CounterId = uint32_t;
+
+    struct CounterStats {
+        const char* name;
+        Category category;
+        uint64_t totalCalls;
+        double totalMs;
+        // averaged over the last window
+        double callsPerFrame;
+        double msPerFrame;
+        // upper bounds of the histogram buckets the percentiles fall into, over the last window
+        double p50Us;
+        double p99Us;
+        double maxUs;
+    };
+
+    // Where the timestamps come from. The ticks are read twice for every timed call so they need to be cheap, their rate is
+    // measured against the reference clock over the whole session.
+    struct Clock {
+        uint64_t (*ticks)();
+        double (*referenceMs)();
+    };
+    // the TSC, calibrated against steady_clock since its frequency isn't exposed anywhere
+    static constexpr Clock TSC_CLOCK = {
+        [] () -> uint64_t { return __rdtsc(); },
+        [] () -> double { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+    };
+    // Restarts the calibration and the current window with another clock, so tests can drive the collector with a fake one.
+    // Has to be called from the thread calling EndFrame() while nothing is being timed.
+    static void SetClock(const Clock& clock);
+
+    // registering the same name twice returns the same counter, throws when there's no room for another counter
+    static CounterId Register(const char* name, Category category);
+
+    static uint64_t Now() { return s_clock.ticks(); }
+    static void Record(CounterId id, uint64_t ticks);
+
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(CounterId id): m_id(id), m_start(Now()) {}
+        ~ScopedTimer() { Record(m_id, Now() - m_start); }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        CounterId m_id;
+        uint64_t m_start;
+    };
+
+    // only called from one thread, once at the end of each frame
+    static void EndFrame();
+
+    static std::vector<CounterStats> GetStats();
+    // threads past MAX_THREADS don't get counters, their calls aren't recorded
+    static uint32_t GetIgnoredThreadCount();
+    static bool WriteCSV(const std::string& path);
+    static void DrawOverlay();
+
+private:
+    static constexpr size_t MAX_COUNTERS = 96;
+    static constexpr size_t MAX_THREADS = 64;
+    static constexpr size_t BUCKET_COUNT = LatencyHistogram::BUCKET_COUNT;
+
+    struct CounterInfo {
+        const char* name;
+        Category category;
+    };
+
+    // only written by the thread that owns it, the atomics are there so that EndFrame() can read them at any time
+    struct ThreadCounters {
+        struct Counter {
+            std::atomic_uint64_t calls = 0;
+            std::atomic_uint64_t ticks = 0;
+            std::array<std::atomic_uint64_t, BUCKET_COUNT> buckets = {};
+        };
+        std::array<Counter, MAX_COUNTERS> counters = {};
+    };
+
+    struct Totals {
+        uint64_t calls = 0;
+        uint64_t ticks = 0;
+        LatencyHistogram::Buckets buckets = {};
+    };
+
+    static ThreadCounters* GetThreadCounters();
+    static Totals SumThreadCounters(CounterId id, bool includeBuckets);
+
+    static std::mutex s_registerMutex;
+    static std::array<CounterInfo, MAX_COUNTERS> s_counterInfos;
+    static std::atomic_uint32_t s_counterCount;
+
+    static std::array<std::atomic<ThreadCounters*>, MAX_THREADS> s_threads;
+    static std::atomic_uint32_t s_threadCount;
+
+    static inline Clock s_clock = TSC_CLOCK;
+
+    // only used by EndFrame()
+    static std::array<Totals, MAX_COUNTERS> s_windowStart;
+    static uint32_t s_framesInWindow;
+    static uint64_t s_lastFrameEnd;
+    static uint64_t s_calibrationTicks;
+    static double s_calibrationReferenceMs;
+    static double s_ticksPerMs;
+
+    static std::mutex s_statsMutex;
+    static std::vector<CounterStats> s_stats;
+};
@@ -0,0 +1,98 @@
+#include "telemetry.h"
+
+static const char* CategoryToString(Telemetry::Category category) {
+    switch (category) {
+        case Telemetry::Category::HLE_HOOK:
+            return "HLE Hook";
+        case Telemetry::Category::VULKAN:
+            return "Vulkan";
+        case Telemetry::Category::FRAME:
+            return "Frame";
+    }
+    return "Unknown";
+}
+
+bool Telemetry::WriteCSV(const std::string& path) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        Log::print<ERROR>("Failed to open {} for writing the telemetry", path);
+        return false;
+    }
+
+    file << "name,category,total_calls,total_ms,calls_per_frame,ms_per_frame,p50_us,p99_us,max_us\n";
+    for (const CounterStats& stats : GetStats()) {
+        file << std::format("{},{},{},{:.3f},{:.2f},{:.4f},{:.2f},{:.2f},{:.2f}\n", stats.name, CategoryToString(stats.category), stats.totalCalls, stats.totalMs, stats.callsPerFrame, stats.msPerFrame, stats.p50Us, stats.p99Us, stats.maxUs);
+    }
+    Log::print<INFO>("Saved telemetry to {}", path);
+    return true;
+}
+
+void Telemetry::DrawOverlay() {
+    if (ImGui::Begin("Telemetry")) {
+        if (ImGui::Button("Save As CSV")) {
+            WriteCSV("BetterVR_telemetry.csv");
+        }
+        ImGui::SameLine();
+        ImGui::Text("Averaged over the last %u frames", WINDOW_FRAMES);
+        if (const uint32_t ignoredThreads = GetIgnoredThreadCount(); ignoredThreads != 0) {
+            ImGui::SameLine();
+            ImGui::Text("(%u threads aren't tracked)", ignoredThreads);
+        }
+
+        constexpr ImGuiTableFlags TABLE_FLAGS = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY;
+        if (ImGui::BeginTable("Counters", 7, TABLE_FLAGS)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Name");
+            ImGui::TableSetupColumn("Category");
+            ImGui::TableSetupColumn("Calls/Frame");
+            ImGui::TableSetupColumn("ms/Frame", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+            ImGui::TableSetupColumn("p50 (us)");
+            ImGui::TableSetupColumn("p99 (us)");
+            ImGui::TableSetupColumn("Max (us)");
+            ImGui::TableHeadersRow();
+
+            std::vector<CounterStats> stats = GetStats();
+            if (const ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs(); sortSpecs != nullptr && sortSpecs->SpecsCount > 0) {
+                const ImGuiTableColumnSortSpecs& spec = sortSpecs->Specs[0];
+                auto key = [&spec](const CounterStats& counterStats) -> double {
+                    switch (spec.ColumnIndex) {
+                        case 1: return (double)counterStats.category;
+                        case 2: return counterStats.callsPerFrame;
+                        case 3: return counterStats.msPerFrame;
+                        case 4: return counterStats.p50Us;
+                        case 5: return counterStats.p99Us;
+                        case 6: return counterStats.maxUs;
+                        default: return 0.0;
+                    }
+                };
+                std::ranges::stable_sort(stats, [&](const CounterStats& a, const CounterStats& b) {
+                    if (spec.ColumnIndex == 0) {
+                        const int order = std::string_view(a.name).compare(b.name);
+                        return spec.SortDirection == ImGuiSortDirection_Ascending ? order < 0 : order > 0;
+                    }
+                    return spec.SortDirection == ImGuiSortDirection_Ascending ? key(a) < key(b) : key(a) > key(b);
+                });
+            }
+
+            for (const CounterStats& counterStats : stats) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(counterStats.name);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(CategoryToString(counterStats.category));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", counterStats.callsPerFrame);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", counterStats.msPerFrame);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", counterStats.p50Us);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", counterStats.p99Us);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", counterStats.maxUs);
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
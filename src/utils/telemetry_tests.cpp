@@ -0,0 +1,145 @@
+#include "catch.h"
+#include "telemetry.h"
+
+#include <thread>
+
+namespace {
+    // a thousand ticks per millisecond, so a tick is a microsecond
+    constexpr uint64_t TICKS_PER_MS = 1000;
+    constexpr uint64_t FRAME_TICKS = 11111;
+
+    std::atomic_uint64_t s_fakeTicks = 1;
+
+    constexpr Telemetry::Clock FAKE_CLOCK = {
+        [] () -> uint64_t { return s_fakeTicks.load(); },
+        [] () -> double { return (double)s_fakeTicks.load() / (double)TICKS_PER_MS; }
+    };
+
+    const Telemetry::CounterStats* FindStats(const std::vector<Telemetry::CounterStats>& stats, std::string_view name) {
+        auto it = std::ranges::find(stats, name, [](const Telemetry::CounterStats& counterStats) { return std::string_view(counterStats.name); });
+        return it != stats.end() ? &*it : nullptr;
+    }
+
+    // calibrates the fake clock with its first frame, then runs a whole window of frames with the given work in each
+    template <typename Work>
+    std::vector<Telemetry::CounterStats> RunWindow(Work work) {
+        Telemetry::SetClock(FAKE_CLOCK);
+        Telemetry::EndFrame();
+        for (uint32_t frame = 0; frame < Telemetry::WINDOW_FRAMES; frame++) {
+            const uint64_t frameStart = s_fakeTicks.load();
+            work(frame);
+            s_fakeTicks = frameStart + FRAME_TICKS;
+            Telemetry::EndFrame();
+        }
+        return Telemetry::GetStats();
+    }
+}
+
+TEST_CASE("LatencyHistogram buckets are two per power of two", "[telemetry]") {
+    CHECK(LatencyHistogram::GetBucket(0) == 0);
+    CHECK(LatencyHistogram::GetBucket(1) == 1);
+    CHECK(LatencyHistogram::GetBucket(2) == 2);
+    CHECK(LatencyHistogram::GetBucket(3) == 3);
+    CHECK(LatencyHistogram::GetBucket(4) == 4);
+    CHECK(LatencyHistogram::GetBucket(5) == 4);
+    CHECK(LatencyHistogram::GetBucket(6) == 5);
+    CHECK(LatencyHistogram::GetBucket(7) == 5);
+    CHECK(LatencyHistogram::GetBucket(8) == 6);
+    CHECK(LatencyHistogram::GetBucket(std::numeric_limits<uint64_t>::max()) == LatencyHistogram::BUCKET_COUNT - 1);
+
+    // every value falls between its bucket's lower bound and the next one's
+    for (uint64_t ticks = 0; ticks < 100000; ticks += 7) {
+        const size_t bucket = LatencyHistogram::GetBucket(ticks);
+        REQUIRE(LatencyHistogram::GetBucketLowerBound(bucket) <= ticks);
+        REQUIRE(ticks < LatencyHistogram::GetBucketLowerBound(bucket + 1));
+    }
+}
+
+TEST_CASE("LatencyHistogram reports the upper bounds of the percentiles' buckets", "[telemetry]") {
+    LatencyHistogram::Buckets buckets = {};
+    CHECK(LatencyHistogram::GetPercentiles(buckets).p50 == 0);
+    CHECK(LatencyHistogram::GetPercentiles(buckets).max == 0);
+
+    // 980 fast calls and 20 slow ones, so the slow ones are above the 99th percentile
+    buckets[LatencyHistogram::GetBucket(10)] = 980;
+    buckets[LatencyHistogram::GetBucket(1000)] = 20;
+    LatencyHistogram::Percentiles percentiles = LatencyHistogram::GetPercentiles(buckets);
+    CHECK(percentiles.p50 == 12);
+    CHECK(percentiles.p99 == 1024);
+    CHECK(percentiles.max == 1024);
+
+    // with only 5 slow calls they aren't
+    buckets[LatencyHistogram::GetBucket(1000)] = 5;
+    percentiles = LatencyHistogram::GetPercentiles(buckets);
+    CHECK(percentiles.p99 == 12);
+    CHECK(percentiles.max == 1024);
+}
+
+TEST_CASE("Telemetry computes per-frame statistics with a fake clock", "[telemetry]") {
+    static const Telemetry::CounterId s_hook = Telemetry::Register("Test::hook", Telemetry::Category::HLE_HOOK);
+    CHECK(Telemetry::Register("Test::hook", Telemetry::Category::HLE_HOOK) == s_hook);
+
+    // two 50us calls every frame, and a 900us one in the last frame
+    const std::vector<Telemetry::CounterStats> stats = RunWindow([](uint32_t frame) {
+        for (int i = 0; i < 2; i++) {
+            Telemetry::ScopedTimer timer(s_hook);
+            s_fakeTicks += 50;
+        }
+        if (frame == Telemetry::WINDOW_FRAMES - 1) {
+            Telemetry::ScopedTimer timer(s_hook);
+            s_fakeTicks += 900;
+        }
+    });
+
+    const Telemetry::CounterStats* hook = FindStats(stats, "Test::hook");
+    REQUIRE(hook != nullptr);
+    CHECK(hook->category == Telemetry::Category::HLE_HOOK);
+    CHECK(hook->callsPerFrame == Approx((2.0 * Telemetry::WINDOW_FRAMES + 1.0) / Telemetry::WINDOW_FRAMES));
+    CHECK(hook->msPerFrame == Approx((100.0 * Telemetry::WINDOW_FRAMES + 900.0) / Telemetry::WINDOW_FRAMES / 1000.0));
+    CHECK(hook->p50Us == Approx(64.0));
+    CHECK(hook->p99Us == Approx(64.0));
+    CHECK(hook->maxUs == Approx(1024.0));
+
+    const Telemetry::CounterStats* frame = FindStats(stats, "Frame");
+    REQUIRE(frame != nullptr);
+    CHECK(frame->callsPerFrame == Approx(1.0));
+    CHECK(frame->msPerFrame == Approx((double)FRAME_TICKS / TICKS_PER_MS));
+
+    // the next window only contains what happened in it
+    const std::vector<Telemetry::CounterStats> idleStats = RunWindow([](uint32_t) {});
+    const Telemetry::CounterStats* idleHook = FindStats(idleStats, "Test::hook");
+    REQUIRE(idleHook != nullptr);
+    CHECK(idleHook->callsPerFrame == 0.0);
+    CHECK(idleHook->maxUs == 0.0);
+    CHECK(idleHook->totalCalls == hook->totalCalls);
+}
+
+TEST_CASE("Telemetry sums up the counters of every thread", "[telemetry]") {
+    static const Telemetry::CounterId s_threadHook = Telemetry::Register("Test::threadHook", Telemetry::Category::VULKAN);
+    constexpr uint32_t THREAD_COUNT = 4;
+    constexpr uint32_t CALLS_PER_THREAD = 1000;
+
+    const std::vector<Telemetry::CounterStats> stats = RunWindow([](uint32_t frame) {
+        if (frame != 0) {
+            return;
+        }
+        std::vector<std::thread> threads;
+        for (uint32_t thread = 0; thread < THREAD_COUNT; thread++) {
+            threads.emplace_back([] {
+                for (uint32_t i = 0; i < CALLS_PER_THREAD; i++) {
+                    Telemetry::Record(s_threadHook, 20);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    });
+
+    const Telemetry::CounterStats* threadHook = FindStats(stats, "Test::threadHook");
+    REQUIRE(threadHook != nullptr);
+    CHECK(threadHook->totalCalls == THREAD_COUNT * CALLS_PER_THREAD);
+    CHECK(threadHook->totalMs == Approx(THREAD_COUNT * CALLS_PER_THREAD * 20.0 / TICKS_PER_MS));
+    CHECK(threadHook->p50Us == Approx(24.0));
+    CHECK(Telemetry::GetIgnoredThreadCount() == 0);
+}
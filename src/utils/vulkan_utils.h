@@ -43,94 +43,138 @@ namespace VulkanUtils {
         }
     }
 
-    static void TransitionLayout(VkCommandBuffer cmdBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT) {
-        // AMD GPU FIX: Skip redundant transitions - some AMD drivers are strict about this
-        if (oldLayout == newLayout) {
-            return;
+    // A range of device memory that an image is bound to, either suballocated from a shared block or a dedicated allocation
+    struct MemoryAllocation {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+        bool dedicated = false;
+    };
+
+    // Stages and accesses an image can be used with while it's in a given layout.
+    // Used to build barriers that only wait on the work that can actually touch the image, instead of draining the whole pipeline.
+    struct LayoutScope {
+        VkPipelineStageFlags2 stages;
+        VkAccessFlags2 writeAccess;
+        VkAccessFlags2 readAccess;
+    };
+
+    static constexpr LayoutScope GetLayoutScope(VkImageLayout layout) {
+        switch (layout) {
+            case VK_IMAGE_LAYOUT_UNDEFINED:
+            case VK_IMAGE_LAYOUT_PREINITIALIZED:
+                return { VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE, VK_ACCESS_2_NONE };
+            case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_NONE, VK_ACCESS_2_TRANSFER_READ_BIT };
+            case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_ACCESS_2_NONE };
+            case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT };
+            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+            case VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT };
+            case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+                return { VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_NONE, VK_ACCESS_2_SHADER_READ_BIT };
+            default:
+                // Cemu keeps most of its images in GENERAL, so cover everything it renders, samples, computes or copies with
+                return {
+                    VK_PIPELINE_STAGE_2_TRANSFER_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT |
+                        VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                    VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT
+                };
         }
-
-        VkImageMemoryBarrier2 barrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
-        barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-        barrier.srcAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
-        barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
-        barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
-        barrier.oldLayout = oldLayout;
-        barrier.newLayout = newLayout;
-        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        barrier.image = image;
-        // AMD GPU FIX: Use VK_REMAINING to cover all subresources
-        barrier.subresourceRange = {
-            .aspectMask = aspectMask,
-            .baseMipLevel = 0,
-            .levelCount = VK_REMAINING_MIP_LEVELS,
-            .baseArrayLayer = 0,
-            .layerCount = VK_REMAINING_ARRAY_LAYERS
-        };
-
-        VkDependencyInfo dependencyInfo = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR };
-        dependencyInfo.imageMemoryBarrierCount = 1;
-        dependencyInfo.pImageMemoryBarriers = &barrier;
-        vkroots::tables::LookupDeviceDispatch(cmdBuffer)->CmdPipelineBarrier2(cmdBuffer, &dependencyInfo);
     }
 
-    static void PipelineBarrier(VkCommandBuffer cmdBuffer, VkAccessFlags2 srcAccessMask, VkAccessFlags2 dstAccessMask, VkPipelineStageFlags2 srcStageMask, VkPipelineStageFlags2 dstStageMask) {
-        VkMemoryBarrier2 barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
-        barrier.srcAccessMask = srcAccessMask;
-        barrier.srcStageMask = srcStageMask;
-        barrier.dstAccessMask = dstAccessMask;
-        barrier.dstStageMask = dstStageMask;
-
-        VkDependencyInfo dependencyInfo = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR };
-        dependencyInfo.memoryBarrierCount = 1;
-        dependencyInfo.pMemoryBarriers = &barrier;
-        vkroots::tables::LookupDeviceDispatch(cmdBuffer)->CmdPipelineBarrier2(cmdBuffer, &dependencyInfo);
-    }
+    // Collects image transitions and emits them as a single vkCmdPipelineBarrier2 when flushed.
+    // Copy helpers flush right before recording their copy, so everything queued up to that point ends up in one barrier,
+    // and transitions after the copy are deferred until the next copy or until the batch goes out of scope.
+    // The dispatch table is passed in once so that queueing and flushing never has to look it up again.
+    class BarrierBatch {
+    public:
+        static constexpr size_t MAX_IMAGE_BARRIERS = 16;
 
-    static void DebugPipelineBarrier2(VkCommandBuffer cmdBuffer) {
-        return PipelineBarrier(cmdBuffer, VK_ACCESS_2_MEMORY_READ_BIT_KHR | VK_ACCESS_2_MEMORY_WRITE_BIT_KHR, VK_ACCESS_2_MEMORY_READ_BIT_KHR | VK_ACCESS_2_MEMORY_WRITE_BIT_KHR, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR);
-    }
+        BarrierBatch(VkCommandBuffer cmdBuffer, const vkroots::VkDeviceDispatch* dispatch): m_cmdBuffer(cmdBuffer), m_dispatch(dispatch) {}
+        ~BarrierBatch() { Flush(); }
+
+        BarrierBatch(const BarrierBatch&) = delete;
+        BarrierBatch& operator=(const BarrierBatch&) = delete;
+
+        VkCommandBuffer GetCommandBuffer() const { return m_cmdBuffer; }
+        const vkroots::VkDeviceDispatch* GetDispatch() const { return m_dispatch; }
+        uint32_t GetPendingCount() const { return m_imageBarrierCount; }
+
+        void Transition(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT) {
+            const LayoutScope src = GetLayoutScope(oldLayout);
+            const LayoutScope dst = GetLayoutScope(newLayout);
+            Transition(image, oldLayout, newLayout, aspectMask, src.stages, src.writeAccess, dst.stages, dst.writeAccess | dst.readAccess);
+        }
+
+        void Transition(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, VkImageAspectFlags aspectMask, VkPipelineStageFlags2 srcStageMask, VkAccessFlags2 srcAccessMask, VkPipelineStageFlags2 dstStageMask, VkAccessFlags2 dstAccessMask) {
+            // AMD GPU FIX: Skip redundant transitions - some AMD drivers are strict about this
+            if (oldLayout == newLayout) {
+                return;
+            }
+
+            // an image can only appear once per barrier, so fold a transition chain like SRC -> GENERAL -> DST into SRC -> DST
+            for (uint32_t i = 0; i < m_imageBarrierCount; i++) {
+                VkImageMemoryBarrier2& pending = m_imageBarriers[i];
+                if (pending.image == image && pending.subresourceRange.aspectMask == aspectMask) {
+                    checkAssert(pending.newLayout == oldLayout, "Queued image transition doesn't start from the layout of the previously queued one!");
+                    pending.newLayout = newLayout;
+                    pending.dstStageMask = dstStageMask;
+                    pending.dstAccessMask = dstAccessMask;
+                    return;
+                }
+            }
+
+            if (m_imageBarrierCount == MAX_IMAGE_BARRIERS) {
+                Flush();
+            }
+
+            VkImageMemoryBarrier2& barrier = m_imageBarriers[m_imageBarrierCount++];
+            barrier = { VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
+            barrier.srcStageMask = srcStageMask;
+            barrier.srcAccessMask = srcAccessMask;
+            barrier.dstStageMask = dstStageMask;
+            barrier.dstAccessMask = dstAccessMask;
+            barrier.oldLayout = oldLayout;
+            barrier.newLayout = newLayout;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = image;
+            // AMD GPU FIX: Use VK_REMAINING to cover all subresources
+            barrier.subresourceRange = {
+                .aspectMask = aspectMask,
+                .baseMipLevel = 0,
+                .levelCount = VK_REMAINING_MIP_LEVELS,
+                .baseArrayLayer = 0,
+                .layerCount = VK_REMAINING_ARRAY_LAYERS
+            };
+        }
+
+        void Flush() {
+            if (m_imageBarrierCount == 0) {
+                return;
+            }
+
+            VkDependencyInfo dependencyInfo = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+            dependencyInfo.imageMemoryBarrierCount = m_imageBarrierCount;
+            dependencyInfo.pImageMemoryBarriers = m_imageBarriers.data();
+            m_dispatch->CmdPipelineBarrier2(m_cmdBuffer, &dependencyInfo);
+            m_imageBarrierCount = 0;
+        }
+
+    private:
+        VkCommandBuffer m_cmdBuffer;
+        const vkroots::VkDeviceDispatch* m_dispatch;
+        std::array<VkImageMemoryBarrier2, MAX_IMAGE_BARRIERS> m_imageBarriers;
+        uint32_t m_imageBarrierCount = 0;
+    };
 
-    static void DebugPipelineBarrier(VkCommandBuffer cmdBuffer) {
-        VkMemoryBarrier memoryBarrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
-        memoryBarrier.srcAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
-            VK_ACCESS_INDEX_READ_BIT |
-            VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
-            VK_ACCESS_UNIFORM_READ_BIT |
-            VK_ACCESS_INPUT_ATTACHMENT_READ_BIT |
-            VK_ACCESS_SHADER_READ_BIT |
-            VK_ACCESS_SHADER_WRITE_BIT |
-            VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
-            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
-            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
-            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
-            VK_ACCESS_TRANSFER_READ_BIT |
-            VK_ACCESS_TRANSFER_WRITE_BIT |
-            VK_ACCESS_HOST_READ_BIT |
-            VK_ACCESS_HOST_WRITE_BIT |
-            VK_ACCESS_MEMORY_READ_BIT |
-            VK_ACCESS_MEMORY_WRITE_BIT;
-
-        memoryBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
-            VK_ACCESS_INDEX_READ_BIT |
-            VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT |
-            VK_ACCESS_UNIFORM_READ_BIT |
-            VK_ACCESS_INPUT_ATTACHMENT_READ_BIT |
-            VK_ACCESS_SHADER_READ_BIT |
-            VK_ACCESS_SHADER_WRITE_BIT |
-            VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
-            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
-            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
-            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
-            VK_ACCESS_TRANSFER_READ_BIT |
-            VK_ACCESS_TRANSFER_WRITE_BIT |
-            VK_ACCESS_HOST_READ_BIT |
-            VK_ACCESS_HOST_WRITE_BIT |
-            VK_ACCESS_MEMORY_READ_BIT |
-            VK_ACCESS_MEMORY_WRITE_BIT;
-
-        vkroots::tables::LookupDeviceDispatch(cmdBuffer)->CmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
-        // return PipelineBarrier(cmdBuffer, VK_ACCESS_2_MEMORY_READ_BIT_KHR | VK_ACCESS_2_MEMORY_WRITE_BIT_KHR, VK_ACCESS_2_MEMORY_READ_BIT_KHR | VK_ACCESS_2_MEMORY_WRITE_BIT_KHR, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT_KHR);
+    static void TransitionLayout(const vkroots::VkDeviceDispatch* dispatch, VkCommandBuffer cmdBuffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT) {
+        BarrierBatch barriers(cmdBuffer, dispatch);
+        barriers.Transition(image, oldLayout, newLayout, aspectMask);
     }
 
 }